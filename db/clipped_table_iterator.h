@@ -0,0 +1,193 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cassert>
+#include <string>
+
+#include "db/dbformat.h"
+#include "table/internal_iterator.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// An internal iterator over a table file that hides the keys out of the
+// boundaries [smallest, largest] of the file, i.e. a view of the table
+// clipped to the boundaries of a clipped FileMetaData. Unlike
+// ClippingIterator, the results of the bounds checking of the underlying
+// iterator are only passed through, as they refer to the bounds of the read
+// options.
+class ClippedTableIterator : public InternalIterator {
+ public:
+  // Takes the ownership of iter, which is destroyed in place if arena_mode.
+  ClippedTableIterator(InternalIterator* iter, const InternalKey& smallest,
+                       const InternalKey& largest,
+                       const InternalKeyComparator* icmp, bool arena_mode)
+      : iter_(iter),
+        smallest_(smallest.Encode().ToString()),
+        largest_(largest.Encode().ToString()),
+        icmp_(icmp),
+        arena_mode_(arena_mode),
+        valid_(false) {
+    assert(iter_);
+    assert(icmp_);
+    assert(icmp_->Compare(smallest_, largest_) <= 0);
+  }
+
+  ~ClippedTableIterator() override {
+    if (arena_mode_) {
+      iter_->~InternalIterator();
+    } else {
+      delete iter_;
+    }
+  }
+
+  bool Valid() const override { return valid_; }
+
+  void SeekToFirst() override {
+    iter_->Seek(smallest_);
+    UpdateAndEnforceUpperBound();
+  }
+
+  void SeekToLast() override {
+    iter_->SeekForPrev(largest_);
+    UpdateAndEnforceLowerBound();
+  }
+
+  void Seek(const Slice& target) override {
+    if (icmp_->Compare(target, smallest_) < 0) {
+      iter_->Seek(smallest_);
+    } else if (icmp_->Compare(target, largest_) > 0) {
+      valid_ = false;
+      return;
+    } else {
+      iter_->Seek(target);
+    }
+    UpdateAndEnforceUpperBound();
+  }
+
+  void SeekForPrev(const Slice& target) override {
+    if (icmp_->Compare(target, largest_) > 0) {
+      iter_->SeekForPrev(largest_);
+    } else if (icmp_->Compare(target, smallest_) < 0) {
+      valid_ = false;
+      return;
+    } else {
+      iter_->SeekForPrev(target);
+    }
+    UpdateAndEnforceLowerBound();
+  }
+
+  void Next() override {
+    assert(valid_);
+    iter_->Next();
+    UpdateAndEnforceUpperBound();
+  }
+
+  bool NextAndGetResult(IterateResult* result) override {
+    assert(valid_);
+    assert(result);
+    valid_ = iter_->NextAndGetResult(result) &&
+             icmp_->Compare(iter_->key(), largest_) <= 0;
+    return valid_;
+  }
+
+  void Prev() override {
+    assert(valid_);
+    iter_->Prev();
+    UpdateAndEnforceLowerBound();
+  }
+
+  Slice key() const override {
+    assert(valid_);
+    return iter_->key();
+  }
+
+  Slice user_key() const override {
+    assert(valid_);
+    return iter_->user_key();
+  }
+
+  Slice value() const override {
+    assert(valid_);
+    return iter_->value();
+  }
+
+  Status status() const override { return iter_->status(); }
+
+  bool PrepareValue() override {
+    assert(valid_);
+    if (iter_->PrepareValue()) {
+      return true;
+    }
+    valid_ = false;
+    return false;
+  }
+
+  bool MayBeOutOfLowerBound() override {
+    assert(valid_);
+    return iter_->MayBeOutOfLowerBound();
+  }
+
+  // Also called while invalid, e.g. by LevelIterator to find out whether to
+  // move to the next file. An invalid iterator may have stopped at the
+  // boundaries of the file rather than the upper bound of the read options,
+  // so the result is unknown then.
+  IterBoundCheck UpperBoundCheckResult() override {
+    if (!valid_) {
+      return IterBoundCheck::kUnknown;
+    }
+    return iter_->UpperBoundCheckResult();
+  }
+
+  void SetPinnedItersMgr(PinnedIteratorsManager* pinned_iters_mgr) override {
+    iter_->SetPinnedItersMgr(pinned_iters_mgr);
+  }
+
+  bool IsKeyPinned() const override {
+    assert(valid_);
+    return iter_->IsKeyPinned();
+  }
+
+  bool IsValuePinned() const override {
+    assert(valid_);
+    return iter_->IsValuePinned();
+  }
+
+  Status GetProperty(std::string prop_name, std::string* prop) override {
+    return iter_->GetProperty(prop_name, prop);
+  }
+
+  void GetReadaheadState(ReadaheadFileInfo* readahead_file_info) override {
+    iter_->GetReadaheadState(readahead_file_info);
+  }
+
+  void SetReadaheadState(ReadaheadFileInfo* readahead_file_info) override {
+    iter_->SetReadaheadState(readahead_file_info);
+  }
+
+  bool IsDeleteRangeSentinelKey() const override {
+    assert(valid_);
+    return iter_->IsDeleteRangeSentinelKey();
+  }
+
+ private:
+  void UpdateAndEnforceUpperBound() {
+    valid_ = iter_->Valid() && icmp_->Compare(iter_->key(), largest_) <= 0;
+  }
+
+  void UpdateAndEnforceLowerBound() {
+    valid_ = iter_->Valid() && icmp_->Compare(iter_->key(), smallest_) >= 0;
+  }
+
+  InternalIterator* iter_;
+  const std::string smallest_;
+  const std::string largest_;
+  const InternalKeyComparator* icmp_;
+  const bool arena_mode_;
+  bool valid_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -1399,6 +1399,12 @@ Status ColumnFamilyData::ValidateOptions(
     s = Status::InvalidArgument(
         "max_successive_merges > 0 is incompatible with unordered_write");
   }
+  if (s.ok() && db_options.unordered_write &&
+      cf_options.memtable_max_successive_merges != 0) {
+    s = Status::InvalidArgument(
+        "memtable_max_successive_merges > 0 is incompatible with "
+        "unordered_write");
+  }
   if (s.ok()) {
     s = CheckCFPathsSupported(db_options, cf_options);
   }
@@ -31,6 +31,15 @@ Status DeleteFilesInRanges(DB* db, ColumnFamilyHandle* column_family,
       ->DeleteFilesInRanges(column_family, ranges, n, include_end);
 }
 
+Status DeleteFilesByTableProperties(
+    DB* db, ColumnFamilyHandle* column_family,
+    const std::function<bool(const TableProperties&)>& should_delete,
+    uint64_t* num_deleted) {
+  return (static_cast_with_check<DBImpl>(db->GetRootDB()))
+      ->DeleteFilesByTableProperties(column_family, should_delete,
+                                     num_deleted);
+}
+
 Status VerifySstFileChecksum(const Options& options,
                              const EnvOptions& env_options,
                              const std::string& file_path) {
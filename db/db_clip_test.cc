@@ -76,8 +76,9 @@ TEST_F(DBClipTest, TestClipRange) {
   CompactRangeOptions compact_options;
   compact_options.change_level = true;
   compact_options.target_level = 2;
+  // The clipped files are kept as they are, and moved down
   ASSERT_OK(db_->CompactRange(compact_options, nullptr, nullptr));
-  ASSERT_EQ("0,0,3", FilesPerLevel(0));
+  ASSERT_EQ("0,0,6", FilesPerLevel(0));
 
   for (auto i = 0; i < 10; i += 2) {
     for (auto j = 0; j < 100; j++) {
@@ -86,9 +87,9 @@ TEST_F(DBClipTest, TestClipRange) {
     }
     ASSERT_OK(Flush());
   }
-  ASSERT_EQ("5,0,3", FilesPerLevel(0));
+  ASSERT_EQ("5,0,6", FilesPerLevel(0));
   ASSERT_OK(dbfull()->TEST_CompactRange(0, nullptr, nullptr));
-  ASSERT_EQ("0,5,3", FilesPerLevel(0));
+  ASSERT_EQ("0,5,6", FilesPerLevel(0));
 
   for (auto i = 1; i < 10; i += 2) {
     for (auto j = 0; j < 100; j++) {
@@ -97,7 +98,7 @@ TEST_F(DBClipTest, TestClipRange) {
     }
     ASSERT_OK(Flush());
   }
-  ASSERT_EQ("5,5,3", FilesPerLevel(0));
+  ASSERT_EQ("5,5,6", FilesPerLevel(0));
 
   auto begin_key_2 = Key(222), end_key_2 = Key(888);
 
@@ -133,6 +134,96 @@ TEST_F(DBClipTest, TestClipRange) {
     ASSERT_TRUE(in_range);
   }
 }
+
+TEST_F(DBClipTest, ClipWithoutRewritingFiles) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+
+  // file [0 => 100), [100 => 200), [200 => 300)
+  for (auto i = 0; i < 3; i++) {
+    for (auto j = 0; j < 100; j++) {
+      ASSERT_OK(Put(Key(i * 100 + j), "v" + std::to_string(i * 100 + j)));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ("3", FilesPerLevel(0));
+  std::vector<LiveFileMetaData> files_before;
+  db_->GetLiveFilesMetaData(&files_before);
+
+  ASSERT_OK(db_->ClipColumnFamily(db_->DefaultColumnFamily(), Key(50),
+                                  Key(250)));
+
+  // The files are neither compacted nor rewritten, but only narrowed
+  ASSERT_EQ(0, options.statistics->getTickerCount(COMPACT_WRITE_BYTES));
+  std::vector<LiveFileMetaData> files_after;
+  db_->GetLiveFilesMetaData(&files_after);
+  ASSERT_EQ(files_before.size(), files_after.size());
+  for (const auto& md : files_after) {
+    ASSERT_TRUE(std::any_of(files_before.begin(), files_before.end(),
+                            [&](const LiveFileMetaData& before) {
+                              return before.file_number == md.file_number;
+                            }));
+    ASSERT_LE(Key(50), md.smallestkey);
+    ASSERT_GT(Key(250), md.largestkey);
+  }
+  // The clipped files are marked for compaction to drop the hidden keys
+  auto* cfd = static_cast_with_check<ColumnFamilyHandleImpl>(
+                  db_->DefaultColumnFamily())
+                  ->cfd();
+  int num_marked = 0;
+  for (FileMetaData* f : cfd->current()->storage_info()->LevelFiles(0)) {
+    ASSERT_EQ(f->clipped, f->marked_for_compaction);
+    num_marked += f->marked_for_compaction ? 1 : 0;
+  }
+  // [0 => 100) and [200 => 300)
+  ASSERT_EQ(2, num_marked);
+
+  auto verify = [&]() {
+    for (auto i = 0; i < 300; i++) {
+      if (i < 50 || i >= 250) {
+        ASSERT_EQ("NOT_FOUND", Get(Key(i)));
+      } else {
+        ASSERT_EQ("v" + std::to_string(i), Get(Key(i)));
+      }
+    }
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    int expected = 50;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(Key(expected), iter->key());
+      expected++;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(250, expected);
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+      expected--;
+      ASSERT_EQ(Key(expected), iter->key());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(50, expected);
+    iter->Seek(Key(10));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(Key(50), iter->key());
+    iter->SeekForPrev(Key(280));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(Key(249), iter->key());
+  };
+  verify();
+
+  // The clipped boundaries are persisted, and kept by repair
+  Reopen(options);
+  verify();
+  Close();
+  ASSERT_OK(RepairDB(dbname_, options));
+  Reopen(options);
+  verify();
+
+  // Compactions of the clipped files drop the keys out of the boundaries
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  verify();
+}
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
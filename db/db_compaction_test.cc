@@ -2106,6 +2106,64 @@ TEST_F(DBCompactionTest, DeleteFilesInRanges) {
   }
 }
 
+TEST_F(DBCompactionTest, DeleteFilesByTableProperties) {
+  Options options = CurrentOptions();
+  options.num_levels = 4;
+  options.disable_auto_compactions = true;
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+
+  // file i has keys [i * 100, i * 100 + (i + 1) * 10)
+  for (auto i = 0; i < 10; i++) {
+    for (auto j = 0; j < (i + 1) * 10; j++) {
+      ASSERT_OK(Put(Key(i * 100 + j), "v"));
+    }
+    ASSERT_OK(Flush());
+  }
+  CompactRangeOptions compact_options;
+  compact_options.change_level = true;
+  compact_options.target_level = 2;
+  ASSERT_OK(db_->CompactRange(compact_options, nullptr, nullptr));
+  ASSERT_EQ("0,0,10", FilesPerLevel(0));
+
+  // Files in level 0 are never deleted
+  for (auto j = 0; j < 5; j++) {
+    ASSERT_OK(Put(Key(2000 + j), "v"));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_EQ("1,0,10", FilesPerLevel(0));
+
+  auto small_files = [](const TableProperties& props) {
+    return props.num_entries <= 40;
+  };
+  uint64_t num_deleted = 0;
+  ASSERT_OK(DeleteFilesByTableProperties(db_, db_->DefaultColumnFamily(),
+                                         small_files, &num_deleted));
+  ASSERT_EQ(4U, num_deleted);
+  // The properties come from the table cache
+  ASSERT_EQ(0, options.statistics->getTickerCount(
+                   NUMBER_DIRECT_LOAD_TABLE_PROPERTIES));
+  ASSERT_EQ("1,0,6", FilesPerLevel(0));
+  for (auto i = 0; i < 10; i++) {
+    for (auto j = 0; j < (i + 1) * 10; j++) {
+      if (i < 4) {
+        ASSERT_EQ("NOT_FOUND", Get(Key(i * 100 + j)));
+      } else {
+        ASSERT_EQ("v", Get(Key(i * 100 + j)));
+      }
+    }
+  }
+  for (auto j = 0; j < 5; j++) {
+    ASSERT_EQ("v", Get(Key(2000 + j)));
+  }
+
+  // Nothing left to delete
+  ASSERT_OK(DeleteFilesByTableProperties(db_, db_->DefaultColumnFamily(),
+                                         small_files, &num_deleted));
+  ASSERT_EQ(0U, num_deleted);
+  ASSERT_EQ("1,0,6", FilesPerLevel(0));
+}
+
 TEST_F(DBCompactionTest, DeleteFileRangeFileEndpointsOverlapBug) {
   // regression test for #2833: groups of files whose user-keys overlap at the
   // endpoints could be split by `DeleteFilesInRange`. This caused old data to
@@ -4913,6 +4913,125 @@ Status DBImpl::DeleteFilesInRanges(ColumnFamilyHandle* column_family,
   return status;
 }
 
+Status DBImpl::DeleteFilesByTableProperties(
+    ColumnFamilyHandle* column_family,
+    const std::function<bool(const TableProperties&)>& should_delete,
+    uint64_t* num_deleted) {
+  if (num_deleted != nullptr) {
+    *num_deleted = 0;
+  }
+  // TODO: plumb Env::IOActivity
+  const ReadOptions read_options;
+  auto cfh = static_cast_with_check<ColumnFamilyHandleImpl>(column_family);
+  ColumnFamilyData* cfd = cfh->cfd();
+  const Comparator* ucmp = cfd->user_comparator();
+  Version* version;
+  MutableCFOptions mutable_cf_options;
+  {
+    InstrumentedMutexLock l(&mutex_);
+    version = cfd->current();
+    version->Ref();
+    mutable_cf_options = *cfd->GetLatestMutableCFOptions();
+  }
+  // The files are immutable, so they are picked by their properties without
+  // holding the mutex, then deleted if still live. The properties come from
+  // the table readers of the table cache, which are opened and cached there
+  // if not already, rather than read again from each file.
+  Status status;
+  std::unordered_set<uint64_t> picked_files;
+  const auto* pick_vstorage = version->storage_info();
+  for (int level = 1; level < pick_vstorage->num_levels() && status.ok();
+       level++) {
+    for (FileMetaData* level_file : pick_vstorage->LevelFiles(level)) {
+      std::shared_ptr<const TableProperties> props;
+      status = cfd->table_cache()->GetTableProperties(
+          file_options_, read_options, cfd->internal_comparator(),
+          *level_file, &props,
+          mutable_cf_options.block_protection_bytes_per_key,
+          mutable_cf_options.prefix_extractor);
+      if (!status.ok()) {
+        break;
+      }
+      if (props != nullptr && should_delete(*props)) {
+        picked_files.insert(level_file->fd.GetNumber());
+      }
+    }
+  }
+  {
+    InstrumentedMutexLock l(&mutex_);
+    version->Unref();
+  }
+  if (!status.ok() || picked_files.empty()) {
+    return status;
+  }
+
+  VersionEdit edit;
+  std::vector<FileMetaData*> deleted_files;
+  JobContext job_context(next_job_id_.fetch_add(1), true);
+  {
+    InstrumentedMutexLock l(&mutex_);
+    Version* input_version = cfd->current();
+    auto* vstorage = input_version->storage_info();
+    for (int level = 1; level < cfd->NumberLevels(); level++) {
+      const std::vector<FileMetaData*>& level_files =
+          vstorage->LevelFiles(level);
+      for (size_t i = 0; i < level_files.size(); i++) {
+        FileMetaData* level_file = level_files[i];
+        if (level_file->being_compacted ||
+            picked_files.find(level_file->fd.GetNumber()) ==
+                picked_files.end()) {
+          continue;
+        }
+        // Versions of a user key split across files must be deleted
+        // together, such files are left to compactions.
+        if ((i > 0 && ucmp->Compare(level_files[i - 1]->largest.user_key(),
+                                    level_file->smallest.user_key()) == 0) ||
+            (i + 1 < level_files.size() &&
+             ucmp->Compare(level_file->largest.user_key(),
+                           level_files[i + 1]->smallest.user_key()) == 0)) {
+          continue;
+        }
+        edit.SetColumnFamily(cfd->GetID());
+        edit.DeleteFile(level, level_file->fd.GetNumber());
+        deleted_files.push_back(level_file);
+        level_file->being_compacted = true;
+      }
+    }
+    if (deleted_files.empty()) {
+      job_context.Clean();
+      return status;
+    }
+    vstorage->ComputeCompactionScore(*cfd->ioptions(),
+                                     *cfd->GetLatestMutableCFOptions());
+    input_version->Ref();
+    status = versions_->LogAndApply(cfd, *cfd->GetLatestMutableCFOptions(),
+                                    read_options, &edit, &mutex_,
+                                    directories_.GetDbDir());
+    if (status.ok()) {
+      InstallSuperVersionAndScheduleWork(cfd,
+                                         &job_context.superversion_contexts[0],
+                                         *cfd->GetLatestMutableCFOptions());
+      if (num_deleted != nullptr) {
+        *num_deleted = deleted_files.size();
+      }
+    }
+    for (auto* deleted_file : deleted_files) {
+      deleted_file->being_compacted = false;
+    }
+    input_version->Unref();
+    FindObsoleteFiles(&job_context, false);
+  }  // lock released here
+
+  LogFlush(immutable_db_options_.info_log);
+  // remove files outside the db-lock
+  if (job_context.HaveSomethingToDelete()) {
+    // Call PurgeObsoleteFiles() without holding mutex.
+    PurgeObsoleteFiles(job_context);
+  }
+  job_context.Clean();
+  return status;
+}
+
 void DBImpl::GetLiveFilesMetaData(std::vector<LiveFileMetaData>* metadata) {
   InstrumentedMutexLock l(&mutex_);
   versions_->GetLiveFilesMetaData(metadata);
@@ -5111,6 +5230,16 @@ Status DB::CreateColumnFamilies(
   return Status::NotSupported("");
 }
 
+Status DB::CreateColumnFamilyWithImport(
+    const ColumnFamilyOptions& /*options*/,
+    const std::string& /*column_family_name*/,
+    const ImportColumnFamilyOptions& /*import_options*/,
+    const std::vector<const ExportImportFilesMetaData*>& /*metadatas*/,
+    const Slice& /*begin_key*/, const Slice& /*end_key*/,
+    ColumnFamilyHandle** /*handle*/) {
+  return Status::NotSupported("");
+}
+
 Status DB::DropColumnFamily(ColumnFamilyHandle* /*column_family*/) {
   return Status::NotSupported("");
 }
@@ -5129,6 +5258,60 @@ Status DB::DestroyColumnFamilyHandle(ColumnFamilyHandle* column_family) {
   return Status::OK();
 }
 
+namespace {
+struct PrefixIteratorBounds {
+  std::string lower;
+  std::string upper;
+  Slice lower_slice;
+  Slice upper_slice;
+};
+
+void DeletePrefixIteratorBounds(void* arg1, void* /*arg2*/) {
+  delete static_cast<PrefixIteratorBounds*>(arg1);
+}
+}  // namespace
+
+Iterator* DB::NewPrefixIterator(const ReadOptions& options,
+                                ColumnFamilyHandle* column_family,
+                                const Slice& prefix) {
+  const Comparator* ucmp = column_family->GetComparator();
+  if (ucmp->GetRootComparator() != BytewiseComparator() ||
+      ucmp->timestamp_size() > 0) {
+    return NewErrorIterator(Status::NotSupported(
+        "Prefix iterators require the bytewise comparator"));
+  }
+
+  auto* bounds = new PrefixIteratorBounds();
+  ReadOptions prefix_options = options;
+  prefix_options.auto_prefix_mode = true;
+  if (options.iterate_lower_bound == nullptr ||
+      ucmp->Compare(*options.iterate_lower_bound, prefix) < 0) {
+    bounds->lower = prefix.ToString();
+    bounds->lower_slice = bounds->lower;
+    prefix_options.iterate_lower_bound = &bounds->lower_slice;
+  }
+  // The successor of the prefix is its shortest greater key which is not
+  // prefixed by it. There is none if the prefix is only made of 0xff bytes.
+  bounds->upper = prefix.ToString();
+  while (!bounds->upper.empty() &&
+         static_cast<unsigned char>(bounds->upper.back()) == 0xff) {
+    bounds->upper.pop_back();
+  }
+  if (!bounds->upper.empty()) {
+    bounds->upper.back() =
+        static_cast<char>(static_cast<unsigned char>(bounds->upper.back()) + 1);
+    if (options.iterate_upper_bound == nullptr ||
+        ucmp->Compare(*options.iterate_upper_bound, bounds->upper) > 0) {
+      bounds->upper_slice = bounds->upper;
+      prefix_options.iterate_upper_bound = &bounds->upper_slice;
+    }
+  }
+
+  Iterator* iter = NewIterator(prefix_options, column_family);
+  iter->RegisterCleanup(&DeletePrefixIteratorBounds, bounds, nullptr);
+  return iter;
+}
+
 DB::~DB() {}
 
 Status DBImpl::Close() {
@@ -6145,6 +6328,76 @@ Status DBImpl::CreateColumnFamilyWithImport(
   return status;
 }
 
+Status DBImpl::CreateColumnFamilyWithImport(
+    const ColumnFamilyOptions& options, const std::string& column_family_name,
+    const ImportColumnFamilyOptions& import_options,
+    const std::vector<const ExportImportFilesMetaData*>& metadatas,
+    const Slice& begin_key, const Slice& end_key, ColumnFamilyHandle** handle) {
+  assert(handle != nullptr);
+  assert(*handle == nullptr);
+  const Comparator* const ucmp = options.comparator;
+  if (ucmp->Compare(begin_key, end_key) >= 0) {
+    return Status::InvalidArgument("Empty clip range");
+  }
+
+  // Only import the files overlapping [begin_key, end_key), and clip the
+  // ones crossing its boundaries afterwards
+  std::vector<ExportImportFilesMetaData> clipped_metadatas;
+  bool needs_clip = false;
+  for (const auto* metadata : metadatas) {
+    ExportImportFilesMetaData clipped_metadata;
+    clipped_metadata.db_comparator_name = metadata->db_comparator_name;
+    for (const auto& file : metadata->files) {
+      if (ucmp->Compare(file.largestkey, begin_key) < 0 ||
+          ucmp->Compare(file.smallestkey, end_key) >= 0) {
+        continue;
+      }
+      if (ucmp->Compare(file.smallestkey, begin_key) < 0 ||
+          ucmp->Compare(file.largestkey, end_key) >= 0) {
+        needs_clip = true;
+      }
+      clipped_metadata.files.push_back(file);
+    }
+    if (!clipped_metadata.files.empty()) {
+      clipped_metadatas.push_back(std::move(clipped_metadata));
+    }
+  }
+
+  Status status;
+  if (clipped_metadatas.empty()) {
+    ROCKS_LOG_INFO(immutable_db_options_.info_log,
+                   "No files to import into column family %s",
+                   column_family_name.c_str());
+    status = CreateColumnFamily(options, column_family_name, handle);
+  } else {
+    std::vector<const ExportImportFilesMetaData*> clipped_metadata_ptrs;
+    for (const auto& clipped_metadata : clipped_metadatas) {
+      clipped_metadata_ptrs.push_back(&clipped_metadata);
+    }
+    status = CreateColumnFamilyWithImport(options, column_family_name,
+                                          import_options,
+                                          clipped_metadata_ptrs, handle);
+  }
+  if (!status.ok() || !needs_clip) {
+    return status;
+  }
+
+  status = ClipColumnFamily(*handle, begin_key, end_key);
+  if (!status.ok()) {
+    Status temp_s = DropColumnFamily(*handle);
+    if (!temp_s.ok()) {
+      ROCKS_LOG_ERROR(immutable_db_options_.info_log,
+                      "DropColumnFamily failed with error %s",
+                      temp_s.ToString().c_str());
+    }
+    // Always returns Status::OK()
+    temp_s = DestroyColumnFamilyHandle(*handle);
+    assert(temp_s.ok());
+    *handle = nullptr;
+  }
+  return status;
+}
+
 Status DBImpl::ClipColumnFamily(ColumnFamilyHandle* column_family,
                                 const Slice& begin_key, const Slice& end_key) {
   assert(column_family);
@@ -6171,8 +6424,15 @@ Status DBImpl::ClipColumnFamily(ColumnFamilyHandle* column_family,
     status = DeleteFilesInRanges(column_family, ranges.data(), ranges.size());
   }
 
+  // Narrow the boundaries of the remaining overlapping files, which leaves
+  // only the files with range tombstones overlapping
+  if (status.ok()) {
+    status = ClipFileBoundaries(cfd, begin_key, end_key);
+  }
+
   // DeleteRange the remaining overlapping keys
   bool empty_after_delete = false;
+  bool deleted_range = false;
   if (status.ok()) {
     Slice smallest_user_key, largest_user_key;
     {
@@ -6190,6 +6450,7 @@ Status DBImpl::ClipColumnFamily(ColumnFamilyHandle* column_family,
       // Delete [smallest_user_key, clip_begin_key)
       if (ucmp->Compare(smallest_user_key, begin_key) < 0) {
         status = DeleteRange(wo, column_family, smallest_user_key, begin_key);
+        deleted_range = true;
       }
 
       if (status.ok()) {
@@ -6199,12 +6460,13 @@ Status DBImpl::ClipColumnFamily(ColumnFamilyHandle* column_family,
           if (status.ok()) {
             status = Delete(wo, column_family, largest_user_key);
           }
+          deleted_range = true;
         }
       }
     }
   }
 
-  if (status.ok() && !empty_after_delete) {
+  if (status.ok() && !empty_after_delete && deleted_range) {
     // CompactRange delete all the tombstones
     CompactRangeOptions compact_options;
     compact_options.exclusive_manual_compaction = true;
@@ -6220,6 +6482,141 @@ Status DBImpl::ClipColumnFamily(ColumnFamilyHandle* column_family,
   return status;
 }
 
+Status DBImpl::ClipFileBoundaries(ColumnFamilyData* cfd,
+                                  const Slice& begin_key,
+                                  const Slice& end_key) {
+  // PlainTable iterator does not support SeekForPrev(), the keys out of the
+  // range are deleted by range tombstones instead.
+  if (strcmp(cfd->ioptions()->table_factory->Name(),
+             TableFactory::kPlainTableName()) == 0) {
+    return Status::OK();
+  }
+  // TODO: plumb Env::IOActivity
+  const ReadOptions read_options;
+  const Comparator* const ucmp = cfd->user_comparator();
+  const InternalKeyComparator& icmp = cfd->internal_comparator();
+  // The files are reserved like compaction inputs while their keys in the
+  // range are looked up without holding the mutex
+  std::vector<std::pair<int, FileMetaData*>> clip_files;
+  Version* version;
+  MutableCFOptions mutable_cf_options;
+  {
+    InstrumentedMutexLock l(&mutex_);
+    version = cfd->current();
+    mutable_cf_options = *cfd->GetLatestMutableCFOptions();
+    const VersionStorageInfo* vstorage = version->storage_info();
+    for (int level = 0; level < vstorage->num_non_empty_levels(); level++) {
+      for (FileMetaData* f : vstorage->LevelFiles(level)) {
+        if (!f->being_compacted &&
+            (ucmp->Compare(f->smallest.user_key(), begin_key) < 0 ||
+             ucmp->Compare(f->largest.user_key(), end_key) >= 0)) {
+          f->being_compacted = true;
+          clip_files.emplace_back(level, f);
+        }
+      }
+    }
+    if (clip_files.empty()) {
+      return Status::OK();
+    }
+    version->Ref();
+  }
+
+  Status status;
+  VersionEdit edit;
+  edit.SetColumnFamily(cfd->GetID());
+  const InternalKey seek_begin(begin_key, kMaxSequenceNumber,
+                               kValueTypeForSeek);
+  const InternalKey seek_end(end_key, kMaxSequenceNumber, kValueTypeForSeek);
+  for (const auto& clip_file : clip_files) {
+    const int level = clip_file.first;
+    const FileMetaData* f = clip_file.second;
+    // Range tombstones are left to compactions, as they may cover keys of
+    // other files in the range without keys of the file in the range.
+    std::unique_ptr<FragmentedRangeTombstoneIterator> range_del_iter;
+    status = cfd->table_cache()->GetRangeTombstoneIterator(
+        read_options, icmp, *f,
+        mutable_cf_options.block_protection_bytes_per_key, &range_del_iter);
+    if (!status.ok()) {
+      break;
+    }
+    if (range_del_iter != nullptr && !range_del_iter->empty()) {
+      continue;
+    }
+
+    std::unique_ptr<InternalIterator> iter(cfd->table_cache()->NewIterator(
+        read_options, file_options_, icmp, *f, /*range_del_agg=*/nullptr,
+        mutable_cf_options.prefix_extractor, /*table_reader_ptr=*/nullptr,
+        /*file_read_hist=*/nullptr, TableReaderCaller::kUserIterator,
+        /*arena=*/nullptr, /*skip_filters=*/true, level,
+        MaxFileSizeForL0MetaPin(mutable_cf_options),
+        /*smallest_compaction_key=*/nullptr,
+        /*largest_compaction_key=*/nullptr,
+        /*allow_unprepared_value=*/true,
+        mutable_cf_options.block_protection_bytes_per_key));
+    InternalKey smallest;
+    InternalKey largest;
+    iter->Seek(seek_begin.Encode());
+    if (iter->Valid() && ucmp->Compare(iter->user_key(), end_key) < 0) {
+      smallest.DecodeFrom(iter->key());
+      iter->SeekForPrev(seek_end.Encode());
+      if (iter->Valid() && ucmp->Compare(iter->user_key(), end_key) >= 0) {
+        iter->Prev();
+      }
+      assert(iter->Valid());
+      largest.DecodeFrom(iter->key());
+    }
+    status = iter->status();
+    if (!status.ok()) {
+      break;
+    }
+
+    edit.DeleteFile(level, f->fd.GetNumber());
+    if (smallest.size() == 0) {
+      // No keys in the range
+      continue;
+    }
+    // Marked for compaction to reclaim the space of the hidden keys
+    edit.AddFile(level, f->fd.GetNumber(), f->fd.GetPathId(),
+                 f->fd.GetFileSize(), smallest, largest, f->fd.smallest_seqno,
+                 f->fd.largest_seqno, true /* marked_for_compaction */,
+                 f->temperature,
+                 f->oldest_blob_file_number, f->oldest_ancester_time,
+                 f->file_creation_time, f->epoch_number, f->file_checksum,
+                 f->file_checksum_func_name, f->unique_id,
+                 f->compensated_range_deletion_size, f->tail_size,
+                 f->user_defined_timestamps_persisted, true /* clipped */);
+  }
+
+  JobContext job_context(next_job_id_.fetch_add(1), true);
+  {
+    InstrumentedMutexLock l(&mutex_);
+    if (status.ok() && (edit.NumEntries() > 0)) {
+      status = versions_->LogAndApply(cfd, *cfd->GetLatestMutableCFOptions(),
+                                      read_options, &edit, &mutex_,
+                                      directories_.GetDbDir());
+      if (status.ok()) {
+        InstallSuperVersionAndScheduleWork(
+            cfd, &job_context.superversion_contexts[0],
+            *cfd->GetLatestMutableCFOptions());
+      }
+    }
+    for (const auto& clip_file : clip_files) {
+      clip_file.second->being_compacted = false;
+    }
+    version->Unref();
+    FindObsoleteFiles(&job_context, false);
+  }  // lock released here
+
+  LogFlush(immutable_db_options_.info_log);
+  // remove files outside the db-lock
+  if (job_context.HaveSomethingToDelete()) {
+    // Call PurgeObsoleteFiles() without holding mutex.
+    PurgeObsoleteFiles(job_context);
+  }
+  job_context.Clean();
+  return status;
+}
+
 Status DBImpl::VerifyFileChecksums(const ReadOptions& _read_options) {
   if (_read_options.io_activity != Env::IOActivity::kUnknown &&
       _read_options.io_activity != Env::IOActivity::kVerifyFileChecksums) {
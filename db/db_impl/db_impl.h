@@ -500,6 +500,10 @@ class DBImpl : public DB {
   Status DeleteFilesInRanges(ColumnFamilyHandle* column_family,
                              const RangePtr* ranges, size_t n,
                              bool include_end = true);
+  Status DeleteFilesByTableProperties(
+      ColumnFamilyHandle* column_family,
+      const std::function<bool(const TableProperties&)>& should_delete,
+      uint64_t* num_deleted);
 
   virtual void GetLiveFilesMetaData(
       std::vector<LiveFileMetaData>* metadata) override;
@@ -542,6 +546,13 @@ class DBImpl : public DB {
       const std::vector<const ExportImportFilesMetaData*>& metadatas,
       ColumnFamilyHandle** handle) override;
 
+  virtual Status CreateColumnFamilyWithImport(
+      const ColumnFamilyOptions& options, const std::string& column_family_name,
+      const ImportColumnFamilyOptions& import_options,
+      const std::vector<const ExportImportFilesMetaData*>& metadatas,
+      const Slice& begin_key, const Slice& end_key,
+      ColumnFamilyHandle** handle) override;
+
   using DB::ClipColumnFamily;
   virtual Status ClipColumnFamily(ColumnFamilyHandle* column_family,
                                   const Slice& begin_key,
@@ -1955,6 +1966,13 @@ class DBImpl : public DB {
       autovector<ColumnFamilyData*>* selected_cfds,
       const autovector<ColumnFamilyData*>& provided_candidate_cfds = {});
 
+  // Narrows the boundaries of the files of cfd crossing begin_key or end_key
+  // to their keys in [begin_key, end_key) without rewriting them, and deletes
+  // the files without such keys. Files with range tombstones, or being
+  // compacted, are left as they are.
+  Status ClipFileBoundaries(ColumnFamilyData* cfd, const Slice& begin_key,
+                            const Slice& end_key);
+
   // Force current memtable contents to be flushed.
   Status FlushMemTable(ColumnFamilyData* cfd, const FlushOptions& options,
                        FlushReason flush_reason,
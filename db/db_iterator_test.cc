@@ -713,6 +713,71 @@ TEST_F(DBIteratorTest, ReseekUponDirectionChange) {
   }
 }
 
+TEST_F(DBIteratorTest, PrefixIterator) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.prefix_extractor.reset(NewFixedPrefixTransform(2));
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  BlockBasedTableOptions table_options;
+  table_options.filter_policy.reset(NewBloomFilterPolicy(10));
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  // The range of the first file covers the prefix "ac" without its keys
+  ASSERT_OK(Put("aa1", "v"));
+  ASSERT_OK(Put("ad1", "v"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Put("ab1", "v"));
+  ASSERT_OK(Put("ac1", "v"));
+  ASSERT_OK(Put("ac2", "v"));
+  ASSERT_OK(Put("ac\xff", "v"));
+  ASSERT_OK(Put("b", "v"));
+  ASSERT_OK(Flush());
+
+  auto collect = [](Iterator* iter, bool forward) {
+    std::string result;
+    for (forward ? iter->SeekToFirst() : iter->SeekToLast(); iter->Valid();
+         forward ? iter->Next() : iter->Prev()) {
+      result += iter->key().ToString() + ",";
+    }
+    EXPECT_OK(iter->status());
+    return result;
+  };
+  {
+    std::unique_ptr<Iterator> iter(db_->NewPrefixIterator(
+        ReadOptions(), db_->DefaultColumnFamily(), "ac"));
+    ASSERT_EQ("ac1,ac2,ac\xff,", collect(iter.get(), /*forward=*/true));
+    ASSERT_GT(TestGetTickerCount(options, NON_LAST_LEVEL_SEEK_FILTERED), 0);
+    ASSERT_EQ("ac\xff,ac2,ac1,", collect(iter.get(), /*forward=*/false));
+    iter->Seek("a");
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ("ac1", iter->key());
+    iter->Seek("ad");
+    ASSERT_FALSE(iter->Valid());
+  }
+  {
+    // Only narrows the bounds of the read options
+    ReadOptions read_options;
+    Slice upper_bound("ac2");
+    read_options.iterate_upper_bound = &upper_bound;
+    std::unique_ptr<Iterator> iter(db_->NewPrefixIterator(
+        read_options, db_->DefaultColumnFamily(), "a"));
+    ASSERT_EQ("aa1,ab1,ac1,", collect(iter.get(), /*forward=*/true));
+  }
+  {
+    // No successor
+    std::unique_ptr<Iterator> iter(db_->NewPrefixIterator(
+        ReadOptions(), db_->DefaultColumnFamily(), "\xff"));
+    ASSERT_EQ("", collect(iter.get(), /*forward=*/true));
+  }
+
+  options.comparator = ReverseBytewiseComparator();
+  DestroyAndReopen(options);
+  std::unique_ptr<Iterator> iter(
+      db_->NewPrefixIterator(ReadOptions(), db_->DefaultColumnFamily(), "a"));
+  ASSERT_TRUE(iter->status().IsNotSupported());
+}
+
 TEST_P(DBIteratorTest, IterSmallAndLargeMix) {
   do {
     CreateAndReopenWithCF({"pikachu"}, CurrentOptions());
@@ -1043,6 +1043,75 @@ TEST_F(DBMergeOperatorTest, MaxSuccessiveMergesBaseValues) {
   }
 }
 
+TEST_F(DBMergeOperatorTest, MemtableMaxSuccessiveMerges) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.merge_operator = MergeOperators::CreateStringAppendOperator(',');
+  options.memtable_max_successive_merges = 2;
+  options.env = env_;
+  Reopen(options);
+
+  auto get_key_types = [&](const Slice& key) {
+    constexpr size_t max_key_versions = 8;
+    std::vector<KeyVersion> key_versions;
+    EXPECT_OK(GetAllKeyVersions(db_, db_->DefaultColumnFamily(), key, key,
+                                max_key_versions, &key_versions));
+    std::vector<int> types;
+    for (const auto& key_version : key_versions) {
+      types.push_back(key_version.type);
+    }
+    return types;
+  };
+
+  // Plain base value in the memtable
+  ASSERT_OK(Put("k1", "v0"));
+  ASSERT_OK(Merge("k1", "v1"));
+  ASSERT_OK(Merge("k1", "v2"));
+  const Snapshot* snapshot = db_->GetSnapshot();
+  // Folded with the base value and the two operands into a value
+  ASSERT_OK(Merge("k1", "v3"));
+  ASSERT_EQ("v0,v1,v2,v3", Get("k1"));
+  ASSERT_EQ("v0,v1,v2", Get("k1", snapshot));
+  ASSERT_EQ(std::vector<int>({kTypeValue, kTypeMerge, kTypeMerge, kTypeValue}),
+            get_key_types("k1"));
+  db_->ReleaseSnapshot(snapshot);
+
+  // Deleted base value in the memtable
+  ASSERT_OK(Delete("k2"));
+  ASSERT_OK(Merge("k2", "v1"));
+  ASSERT_OK(Merge("k2", "v2"));
+  ASSERT_OK(Merge("k2", "v3"));
+  ASSERT_EQ("v1,v2,v3", Get("k2"));
+  ASSERT_EQ(
+      std::vector<int>({kTypeValue, kTypeMerge, kTypeMerge, kTypeDeletion}),
+      get_key_types("k2"));
+
+  // The base value is flushed, so the operands are not folded
+  ASSERT_OK(Put("k3", "v0"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Merge("k3", "v1"));
+  ASSERT_OK(Merge("k3", "v2"));
+  ASSERT_OK(Merge("k3", "v3"));
+  ASSERT_EQ("v0,v1,v2,v3", Get("k3"));
+  ASSERT_EQ(
+      std::vector<int>({kTypeMerge, kTypeMerge, kTypeMerge, kTypeValue}),
+      get_key_types("k3"));
+
+  // Also folded in recovery
+  ASSERT_OK(Put("k4", "v0"));
+  ASSERT_OK(Merge("k4", "v1"));
+  ASSERT_OK(Merge("k4", "v2"));
+  ASSERT_OK(Merge("k4", "v3"));
+  options.avoid_flush_during_recovery = true;
+  Reopen(options);
+  ASSERT_EQ("v0,v1,v2,v3", Get("k1"));
+  ASSERT_EQ("v1,v2,v3", Get("k2"));
+  ASSERT_EQ("v0,v1,v2,v3", Get("k3"));
+  ASSERT_EQ("v0,v1,v2,v3", Get("k4"));
+  ASSERT_EQ(std::vector<int>({kTypeValue, kTypeMerge, kTypeMerge, kTypeValue}),
+            get_key_types("k4"));
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -103,7 +103,7 @@ Status UpdateManifestForFilesState(
                   lf->file_creation_time, lf->epoch_number, lf->file_checksum,
                   lf->file_checksum_func_name, lf->unique_id,
                   lf->compensated_range_deletion_size, lf->tail_size,
-                  lf->user_defined_timestamps_persisted);
+                  lf->user_defined_timestamps_persisted, lf->clipped);
             }
           }
         } else {
@@ -73,6 +73,10 @@ struct IngestedFileInfo {
   Temperature file_temperature = Temperature::kUnknown;
   // Unique id of the file to be ingested
   UniqueId64x2 unique_id{};
+  // Whether the file has keys out of [smallest_internal_key,
+  // largest_internal_key], which is only possible for an imported file
+  // exported from a clipped column family
+  bool clipped = false;
 };
 
 class ExternalSstFileIngestionJob {
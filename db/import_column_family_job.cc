@@ -222,7 +222,8 @@ Status ImportColumnFamilyJob::Run() {
           kUnknownFileChecksum, kUnknownFileChecksumFuncName, f.unique_id, 0,
           tail_size,
           static_cast<bool>(
-              f.table_properties.user_defined_timestamps_persisted));
+              f.table_properties.user_defined_timestamps_persisted),
+          f.clipped);
       s = dummy_version_builder.Apply(&dummy_version_edit);
     }
     if (s.ok()) {
@@ -443,6 +444,45 @@ Status ImportColumnFamilyJob::GetIngestedFileInfo(
     assert(!file_meta.largest.empty());
     file_to_import->smallest_internal_key.DecodeFrom(file_meta.smallest);
     file_to_import->largest_internal_key.DecodeFrom(file_meta.largest);
+
+    // A file exported from a clipped column family may have keys out of its
+    // boundaries, which have to stay hidden after the import.
+    // TODO: plumb Env::IOActivity
+    ReadOptions ro;
+    std::unique_ptr<InternalIterator> iter(table_reader->NewIterator(
+        ro, sv->mutable_cf_options.prefix_extractor.get(), /*arena=*/nullptr,
+        /*skip_filters=*/true, TableReaderCaller::kExternalSSTIngestion));
+    const InternalKeyComparator& icmp = cfd_->internal_comparator();
+    iter->SeekToFirst();
+    if (iter->Valid()) {
+      file_to_import->clipped =
+          icmp.Compare(iter->key(),
+                       file_to_import->smallest_internal_key.Encode()) < 0;
+      if (!file_to_import->clipped) {
+        if (strcmp(cfd_->ioptions()->table_factory->Name(),
+                   TableFactory::kPlainTableName()) != 0) {
+          iter->SeekToLast();
+          file_to_import->clipped =
+              iter->Valid() &&
+              icmp.Compare(iter->key(),
+                           file_to_import->largest_internal_key.Encode()) > 0;
+        } else {
+          // PlainTable iterator does not support SeekToLast(), so scan
+          // forward for a key past the largest one.
+          for (; iter->Valid(); iter->Next()) {
+            if (icmp.Compare(iter->key(),
+                             file_to_import->largest_internal_key.Encode()) >
+                0) {
+              file_to_import->clipped = true;
+              break;
+            }
+          }
+        }
+      }
+    }
+    if (!iter->status().ok()) {
+      return iter->status();
+    }
   }
 
   file_to_import->cf_id = static_cast<uint32_t>(props->column_family_id);
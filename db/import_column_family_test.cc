@@ -1048,6 +1048,88 @@ TEST_F(ImportColumnFamilyTest, AssignEpochNumberToMultipleCF) {
   ASSERT_OK(db_->WaitForCompact(o));
   delete checkpoint1;
 }
+
+TEST_F(ImportColumnFamilyTest, ImportMultiColumnFamilyWithClip) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  CreateAndReopenWithCF({"CF1", "CF2"}, options);
+
+  // CF1: [0, 49], [50, 99]
+  // CF2: [100, 149], [150, 199]
+  for (int i = 0; i < 200; i += 50) {
+    int cf = i < 100 ? 1 : 2;
+    for (int j = i; j < i + 50; ++j) {
+      ASSERT_OK(Put(cf, Key(j), Key(j) + "_val"));
+    }
+    ASSERT_OK(Flush(cf));
+  }
+  Checkpoint* checkpoint;
+  ASSERT_OK(Checkpoint::Create(db_, &checkpoint));
+  ASSERT_OK(checkpoint->ExportColumnFamily(handles_[1], export_files_dir_,
+                                           &metadata_ptr_));
+  ASSERT_OK(checkpoint->ExportColumnFamily(handles_[2], export_files_dir2_,
+                                           &metadata_ptr2_));
+  delete checkpoint;
+  std::vector<const ExportImportFilesMetaData*> metadatas = {metadata_ptr_,
+                                                             metadata_ptr2_};
+
+  // Only the file inside the range is imported, without a clip
+  ASSERT_OK(db_->CreateColumnFamilyWithImport(
+      options, "CF3", ImportColumnFamilyOptions(), metadatas, Key(50),
+      Key(100), &import_cfh_));
+  ColumnFamilyMetaData cf_meta;
+  db_->GetColumnFamilyMetaData(import_cfh_, &cf_meta);
+  ASSERT_EQ(1U, cf_meta.file_count);
+  std::string value;
+  for (int i = 0; i < 200; ++i) {
+    Status s = db_->Get(ReadOptions(), import_cfh_, Key(i), &value);
+    if (i >= 50 && i < 100) {
+      ASSERT_OK(s);
+      ASSERT_EQ(Key(i) + "_val", value);
+    } else {
+      ASSERT_TRUE(s.IsNotFound());
+    }
+  }
+
+  // The files crossing the range boundaries are clipped
+  ASSERT_OK(db_->CreateColumnFamilyWithImport(
+      options, "CF4", ImportColumnFamilyOptions(), metadatas, Key(25),
+      Key(125), &import_cfh2_));
+  for (int i = 0; i < 200; ++i) {
+    Status s = db_->Get(ReadOptions(), import_cfh2_, Key(i), &value);
+    if (i >= 25 && i < 125) {
+      ASSERT_OK(s);
+      ASSERT_EQ(Key(i) + "_val", value);
+    } else {
+      ASSERT_TRUE(s.IsNotFound());
+    }
+  }
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  for (const auto& file : files) {
+    if (file.column_family_name == "CF4") {
+      ASSERT_LE(Key(25), file.smallestkey);
+      ASSERT_GT(Key(125), file.largestkey);
+    }
+  }
+
+  // An empty column family if no file overlaps the range
+  ColumnFamilyHandle* empty_cfh = nullptr;
+  ASSERT_OK(db_->CreateColumnFamilyWithImport(
+      options, "CF5", ImportColumnFamilyOptions(), metadatas, Key(200),
+      Key(300), &empty_cfh));
+  db_->GetColumnFamilyMetaData(empty_cfh, &cf_meta);
+  ASSERT_EQ(0U, cf_meta.file_count);
+  ASSERT_OK(db_->DropColumnFamily(empty_cfh));
+  ASSERT_OK(db_->DestroyColumnFamilyHandle(empty_cfh));
+  empty_cfh = nullptr;
+
+  ASSERT_TRUE(db_->CreateColumnFamilyWithImport(
+                     options, "CF6", ImportColumnFamilyOptions(), metadatas,
+                     Key(100), Key(50), &empty_cfh)
+                  .IsInvalidArgument());
+  ASSERT_EQ(empty_cfh, nullptr);
+}
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
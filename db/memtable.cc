@@ -61,6 +61,8 @@ ImmutableMemTableOptions::ImmutableMemTableOptions(
       inplace_update_num_locks(mutable_cf_options.inplace_update_num_locks),
       inplace_callback(ioptions.inplace_callback),
       max_successive_merges(mutable_cf_options.max_successive_merges),
+      memtable_max_successive_merges(
+          mutable_cf_options.memtable_max_successive_merges),
       statistics(ioptions.stats),
       merge_operator(ioptions.merge_operator.get()),
       info_log(ioptions.logger),
@@ -1619,6 +1621,22 @@ size_t MemTable::CountSuccessiveMergeEntries(const LookupKey& key) {
   return num_successive_merges;
 }
 
+bool MemTable::GetMergeBaseValue(const LookupKey& key,
+                                 PinnableWideColumns* columns) {
+  Status s;
+  MergeContext merge_context;
+  SequenceNumber max_covering_tombstone_seq = 0;
+  // TODO: plumb Env::IOActivity
+  const ReadOptions read_opts;
+  // The merge operands are applied to the base value in SaveValue(). Operands
+  // over a range deletion of an older memtable are not found.
+  const bool found =
+      Get(key, /*value=*/nullptr, columns, /*timestamp=*/nullptr, &s,
+          &merge_context, &max_covering_tombstone_seq, read_opts,
+          /*immutable_memtable=*/false);
+  return found && s.ok();
+}
+
 void MemTableRep::Get(const LookupKey& k, void* callback_args,
                       bool (*callback_func)(void* arg, const char* entry)) {
   auto iter = GetDynamicPrefixIterator();
@@ -54,6 +54,7 @@ struct ImmutableMemTableOptions {
                                    Slice delta_value,
                                    std::string* merged_value);
   size_t max_successive_merges;
+  size_t memtable_max_successive_merges;
   Statistics* statistics;
   MergeOperator* merge_operator;
   Logger* info_log;
@@ -94,6 +95,9 @@ class MemTable {
                            const char* prefix_len_key2) const override;
     virtual int operator()(const char* prefix_len_key,
                            const DecodedType& key) const override;
+    const Comparator* user_comparator() const override {
+      return comparator.user_comparator();
+    }
   };
 
   // MemTables are reference counted.  The initial reference count
@@ -323,6 +327,13 @@ class MemTable {
   // key in the memtable.
   size_t CountSuccessiveMergeEntries(const LookupKey& key);
 
+  // Gets the value of the key with its merge operands applied if the base
+  // value of the merge operands is in the memtable, i.e. a Put, a PutEntity or
+  // a point or range deletion of the key. Returns false if the merge operands
+  // apply to older data, or on failure. Only reads the memtable, see
+  // memtable_max_successive_merges.
+  bool GetMergeBaseValue(const LookupKey& key, PinnableWideColumns* columns);
+
   // Update counters and flush status after inserting a whole write batch
   // Used in concurrent memtable inserts.
   void BatchPostProcess(const MemTablePostProcessInfo& update_counters) {
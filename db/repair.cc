@@ -36,7 +36,10 @@
 // (2) largest sequence number in the table
 // (3) oldest blob file referred to by the table (if applicable)
 //
-// If we are unable to scan the file, then we ignore the table.
+// If we are unable to scan the file, then we ignore the table. Tables clipped
+// by ClipColumnFamily() keep the boundaries and the clipped flag recorded in
+// the newest manifest, if it can be read, as their keys outside the
+// boundaries are only removed by compaction.
 //
 // (d) Write Descriptor
 //
@@ -200,6 +203,7 @@ class Repairer {
     status = FindFiles();
     DBImpl* db_impl = nullptr;
     if (status.ok()) {
+      LoadClippedFiles();
       // Discard older manifests and start a fresh one
       for (size_t i = 0; i < manifests_.size(); i++) {
         ArchiveFile(dbname_ + "/" + manifests_[i]);
@@ -271,6 +275,9 @@ class Repairer {
   InstrumentedMutex mutex_;
 
   std::vector<std::string> manifests_;
+  // Boundaries of the clipped table files, by file number
+  std::unordered_map<uint64_t, std::pair<InternalKey, InternalKey>>
+      clipped_files_;
   std::vector<FileDescriptor> table_fds_;
   std::vector<uint64_t> logs_;
   std::vector<TableInfo> tables_;
@@ -334,6 +341,76 @@ class Repairer {
     return Status::OK();
   }
 
+  // Reads the boundaries of the clipped table files from the newest manifest.
+  // A table clipped by ClipColumnFamily() still holds the keys outside its
+  // boundaries, which would come back if the boundaries were rebuilt from the
+  // table contents. Best effort, as the manifest may be what is broken.
+  void LoadClippedFiles() {
+    struct LogReporter : public log::Reader::Reporter {
+      std::shared_ptr<Logger> info_log;
+      void Corruption(size_t bytes, const Status& s) override {
+        ROCKS_LOG_WARN(info_log, "Manifest: dropping %d bytes; %s",
+                       static_cast<int>(bytes), s.ToString().c_str());
+      }
+    };
+
+    std::string manifest;
+    uint64_t manifest_number = 0;
+    for (const auto& fname : manifests_) {
+      uint64_t number;
+      FileType type;
+      if (ParseFileName(fname, &number, &type) && number >= manifest_number) {
+        manifest_number = number;
+        manifest = fname;
+      }
+    }
+    if (manifest.empty()) {
+      return;
+    }
+
+    const auto& fs = env_->GetFileSystem();
+    std::unique_ptr<SequentialFileReader> file_reader;
+    Status status = SequentialFileReader::Create(
+        fs, DescriptorFileName(dbname_, manifest_number),
+        fs->OptimizeForManifestRead(file_options_), &file_reader,
+        nullptr /* dbg */, nullptr /* rate limiter */);
+    if (!status.ok()) {
+      ROCKS_LOG_WARN(db_options_.info_log,
+                     "%s: unable to read clipped files: %s", manifest.c_str(),
+                     status.ToString().c_str());
+      return;
+    }
+    LogReporter reporter;
+    reporter.info_log = db_options_.info_log;
+    log::Reader reader(db_options_.info_log, std::move(file_reader), &reporter,
+                       true /*enable checksum*/, 0 /* log_num */);
+    std::string scratch;
+    Slice record;
+    while (reader.ReadRecord(&record, &scratch)) {
+      VersionEdit edit;
+      if (!edit.DecodeFrom(record).ok()) {
+        continue;
+      }
+      for (const auto& deleted_file : edit.GetDeletedFiles()) {
+        clipped_files_.erase(deleted_file.second);
+      }
+      for (const auto& new_file : edit.GetNewFiles()) {
+        const FileMetaData& meta = new_file.second;
+        if (meta.clipped) {
+          clipped_files_[meta.fd.GetNumber()] =
+              std::make_pair(meta.smallest, meta.largest);
+        } else {
+          clipped_files_.erase(meta.fd.GetNumber());
+        }
+      }
+    }
+    if (!clipped_files_.empty()) {
+      ROCKS_LOG_INFO(db_options_.info_log,
+                     "%s: %" ROCKSDB_PRIszt " clipped files", manifest.c_str(),
+                     clipped_files_.size());
+    }
+  }
+
   void ConvertLogFilesToTables() {
     const auto& wal_dir = immutable_db_options_.GetWalDir();
     for (size_t i = 0; i < logs_.size(); i++) {
@@ -662,6 +739,16 @@ class Repairer {
         }
       }
     }
+    if (status.ok()) {
+      auto clipped_file = clipped_files_.find(t->meta.fd.GetNumber());
+      if (clipped_file != clipped_files_.end()) {
+        // Keep the keys outside the boundaries hidden until compacted
+        t->meta.smallest = clipped_file->second.first;
+        t->meta.largest = clipped_file->second.second;
+        t->meta.clipped = true;
+        t->meta.marked_for_compaction = true;
+      }
+    }
     return status;
   }
 
@@ -711,7 +798,7 @@ class Repairer {
             table->meta.epoch_number, table->meta.file_checksum,
             table->meta.file_checksum_func_name, table->meta.unique_id,
             table->meta.compensated_range_deletion_size, table->meta.tail_size,
-            table->meta.user_defined_timestamps_persisted);
+            table->meta.user_defined_timestamps_persisted, table->meta.clipped);
       }
       s = dummy_version_builder.Apply(&dummy_edit);
       if (s.ok()) {
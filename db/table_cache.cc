@@ -9,6 +9,7 @@
 
 #include "db/table_cache.h"
 
+#include "db/clipped_table_iterator.h"
 #include "db/dbformat.h"
 #include "db/range_tombstone_fragmenter.h"
 #include "db/snapshot_impl.h"
@@ -257,6 +258,18 @@ InternalIterator* TableCache::NewIterator(
       result = table_reader->NewIterator(
           options, prefix_extractor.get(), arena, skip_filters, caller,
           file_options.compaction_readahead_size, allow_unprepared_value);
+      if (file_meta.clipped) {
+        if (arena != nullptr) {
+          auto* mem = arena->AllocateAligned(sizeof(ClippedTableIterator));
+          result = new (mem)
+              ClippedTableIterator(result, file_meta.smallest,
+                                   file_meta.largest, &icomparator, true);
+        } else {
+          result = new ClippedTableIterator(result, file_meta.smallest,
+                                            file_meta.largest, &icomparator,
+                                            false);
+        }
+      }
     }
     if (handle != nullptr) {
       cache_.RegisterReleaseAsCleanup(handle, *result);
@@ -171,6 +171,7 @@ bool VersionEdit::EncodeTo(std::string* dst,
     //
     // Customized encoding for fields:
     //   tag kPathId: 1 byte as path_id
+    //   tag kClipped: 1 byte as clipped, only written if true
     //   tag kNeedCompaction:
     //        now only can take one char value 1 indicating need-compaction
     //
@@ -255,6 +256,13 @@ bool VersionEdit::EncodeTo(std::string* dst,
       char p = static_cast<char>(0);
       PutLengthPrefixedSlice(dst, Slice(&p, 1));
     }
+    if (f.clipped) {
+      // Older versions must not open the file as they would not hide its keys
+      // out of the boundaries.
+      PutVarint32(dst, NewFileCustomTag::kClipped);
+      char p = static_cast<char>(1);
+      PutLengthPrefixedSlice(dst, Slice(&p, 1));
+    }
 
     TEST_SYNC_POINT_CALLBACK("VersionEdit::EncodeTo:NewFile4:CustomizeFields",
                              dst);
@@ -453,6 +461,12 @@ const char* VersionEdit::DecodeNewFile4From(Slice* input) {
           }
           f.user_defined_timestamps_persisted = (field[0] == 1);
           break;
+        case kClipped:
+          if (field.size() != 1) {
+            return "clipped field wrong size";
+          }
+          f.clipped = (field[0] == 1);
+          break;
         default:
           if ((custom_tag & kCustomTagNonSafeIgnoreMask) != 0) {
             // Should not proceed if cannot understand it
@@ -923,6 +937,9 @@ std::string VersionEdit::DebugString(bool hex_key) const {
     AppendNumberTo(&r, f.tail_size);
     r.append(" User-defined timestamps persisted: ");
     r.append(f.user_defined_timestamps_persisted ? "true" : "false");
+    if (f.clipped) {
+      r.append(" clipped");
+    }
   }
 
   for (const auto& blob_file_addition : blob_file_additions_) {
@@ -1041,6 +1058,9 @@ std::string VersionEdit::DebugJSON(int edit_num, bool hex_key) const {
       jw << "TailSize" << f.tail_size;
       jw << "UserDefinedTimestampsPersisted"
          << f.user_defined_timestamps_persisted;
+      if (f.clipped) {
+        jw << "Clipped" << f.clipped;
+      }
       jw.EndArrayedObject();
     }
 
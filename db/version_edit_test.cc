@@ -91,7 +91,8 @@ TEST_F(VersionEditTest, EncodeDecodeNewFile4) {
                kBig + 603, true, Temperature::kUnknown, 1001,
                kUnknownOldestAncesterTime, kUnknownFileCreationTime,
                303 /* epoch_number */, kUnknownFileChecksum,
-               kUnknownFileChecksumFuncName, kNullUniqueId64x2, 0, 0, true);
+               kUnknownFileChecksumFuncName, kNullUniqueId64x2, 0, 0, true,
+               true /* clipped */);
 
   edit.DeleteFile(4, 700);
 
@@ -127,6 +128,10 @@ TEST_F(VersionEditTest, EncodeDecodeNewFile4) {
   ASSERT_FALSE(new_files[1].second.user_defined_timestamps_persisted);
   ASSERT_TRUE(new_files[2].second.user_defined_timestamps_persisted);
   ASSERT_TRUE(new_files[3].second.user_defined_timestamps_persisted);
+  ASSERT_FALSE(new_files[0].second.clipped);
+  ASSERT_FALSE(new_files[1].second.clipped);
+  ASSERT_FALSE(new_files[2].second.clipped);
+  ASSERT_TRUE(new_files[3].second.clipped);
   ASSERT_FALSE(parsed.GetPersistUserDefinedTimestamps());
 }
 
@@ -193,8 +193,10 @@ class FilePicker {
         // skip the key range filtering. In this case, more likely, the system
         // is highly tuned to minimize number of tables queried by each query,
         // so it is unlikely that key range filtering is more efficient than
-        // querying the files.
-        if (num_levels_ > 1 || curr_file_level_->num_files > 3) {
+        // querying the files. Clipped files are always filtered as their
+        // tables have keys out of their range.
+        if (num_levels_ > 1 || curr_file_level_->num_files > 3 ||
+            f->file_metadata->clipped) {
           // Check if key is within a file's range. If search left bound and
           // right bound point to the same find, we are sure key falls in
           // range.
@@ -624,8 +626,10 @@ class FilePickerMultiGet {
       // skip the key range filtering. In this case, more likely, the system
       // is highly tuned to minimize number of tables queried by each query,
       // so it is unlikely that key range filtering is more efficient than
-      // querying the files.
-      if (num_levels_ > 1 || curr_file_level_->num_files > 3) {
+      // querying the files. Clipped files are always filtered as their
+      // tables have keys out of their range.
+      if (num_levels_ > 1 || curr_file_level_->num_files > 3 ||
+          f->file_metadata->clipped) {
         // Check if key is within a file's range. If search left bound and
         // right bound point to the same find, we are sure key falls in
         // range.
@@ -6575,7 +6579,7 @@ Status VersionSet::WriteCurrentStateToManifest(
                        f->file_creation_time, f->epoch_number, f->file_checksum,
                        f->file_checksum_func_name, f->unique_id,
                        f->compensated_range_deletion_size, f->tail_size,
-                       f->user_defined_timestamps_persisted);
+                       f->user_defined_timestamps_persisted, f->clipped);
         }
       }
 
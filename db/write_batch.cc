@@ -2481,105 +2481,115 @@ class MemTableInserter : public WriteBatch::Handler {
     }
     bool perform_merge = false;
     assert(!concurrent_memtable_writes_ ||
-           moptions->max_successive_merges == 0);
+           (moptions->max_successive_merges == 0 &&
+            moptions->memtable_max_successive_merges == 0));
+
+    // 1) Get the existing value. Use the wide column APIs to make sure we
+    // don't lose any columns in the process.
+    PinnableWideColumns existing;
 
     // If we pass DB through and options.max_successive_merges is hit
     // during recovery, Get() will be issued which will try to acquire
     // DB mutex and cause deadlock, as DB mutex is already held.
     // So we disable merge in recovery
-    if (moptions->max_successive_merges > 0 && db_ != nullptr &&
-        recovering_log_number_ == 0) {
+    const bool may_read_db = moptions->max_successive_merges > 0 &&
+                             db_ != nullptr && recovering_log_number_ == 0;
+    // Only the memtable is read for memtable_max_successive_merges, so it is
+    // also enabled in recovery.
+    if (may_read_db || moptions->memtable_max_successive_merges > 0) {
       assert(!concurrent_memtable_writes_);
+      // Pass in the sequence number so that we also include previous merge
+      // operations in the same batch.
       LookupKey lkey(key, sequence_);
 
       // Count the number of successive merges at the head
       // of the key in the memtable
       size_t num_merges = mem->CountSuccessiveMergeEntries(lkey);
 
-      if (num_merges >= moptions->max_successive_merges) {
-        perform_merge = true;
+      if (moptions->memtable_max_successive_merges > 0 &&
+          num_merges >= moptions->memtable_max_successive_merges) {
+        perform_merge = mem->GetMergeBaseValue(lkey, &existing);
       }
-    }
 
-    if (perform_merge) {
-      // 1) Get the existing value. Use the wide column APIs to make sure we
-      // don't lose any columns in the process.
-      PinnableWideColumns existing;
+      if (!perform_merge && may_read_db &&
+          num_merges >= moptions->max_successive_merges) {
+        perform_merge = true;
 
-      // Pass in the sequence number so that we also include previous merge
-      // operations in the same batch.
-      SnapshotImpl read_from_snapshot;
-      read_from_snapshot.number_ = sequence_;
+        SnapshotImpl read_from_snapshot;
+        read_from_snapshot.number_ = sequence_;
 
-      // TODO: plumb Env::IOActivity
-      ReadOptions read_options;
-      read_options.snapshot = &read_from_snapshot;
+        // TODO: plumb Env::IOActivity
+        ReadOptions read_options;
+        read_options.snapshot = &read_from_snapshot;
 
-      auto cf_handle = cf_mems_->GetColumnFamilyHandle();
-      if (cf_handle == nullptr) {
-        cf_handle = db_->DefaultColumnFamily();
+        auto cf_handle = cf_mems_->GetColumnFamilyHandle();
+        if (cf_handle == nullptr) {
+          cf_handle = db_->DefaultColumnFamily();
+        }
+
+        Status get_status =
+            db_->GetEntity(read_options, cf_handle, key, &existing);
+        if (!get_status.ok()) {
+          // Failed to read a key we know exists. Store the delta in memtable.
+          perform_merge = false;
+        }
       }
+    }
 
-      Status get_status =
-          db_->GetEntity(read_options, cf_handle, key, &existing);
-      if (!get_status.ok()) {
-        // Failed to read a key we know exists. Store the delta in memtable.
-        perform_merge = false;
+    if (perform_merge) {
+      // 2) Apply this merge
+      auto merge_operator = moptions->merge_operator;
+      assert(merge_operator);
+
+      const auto& columns = existing.columns();
+
+      Status merge_status;
+      std::string new_value;
+      ValueType new_value_type;
+
+      if (WideColumnsHelper::HasDefaultColumnOnly(columns)) {
+        // `op_failure_scope` (an output parameter) is not provided (set to
+        // nullptr) since a failure must be propagated regardless of its
+        // value.
+        merge_status = MergeHelper::TimedFullMerge(
+            merge_operator, key, MergeHelper::kPlainBaseValue,
+            WideColumnsHelper::GetDefaultColumn(columns), {value},
+            moptions->info_log, moptions->statistics,
+            SystemClock::Default().get(),
+            /* update_num_ops_stats */ false, /* op_failure_scope */ nullptr,
+            &new_value, /* result_operand */ nullptr, &new_value_type);
       } else {
-        // 2) Apply this merge
-        auto merge_operator = moptions->merge_operator;
-        assert(merge_operator);
-
-        const auto& columns = existing.columns();
-
-        Status merge_status;
-        std::string new_value;
-        ValueType new_value_type;
-
-        if (WideColumnsHelper::HasDefaultColumnOnly(columns)) {
-          // `op_failure_scope` (an output parameter) is not provided (set to
-          // nullptr) since a failure must be propagated regardless of its
-          // value.
-          merge_status = MergeHelper::TimedFullMerge(
-              merge_operator, key, MergeHelper::kPlainBaseValue,
-              WideColumnsHelper::GetDefaultColumn(columns), {value},
-              moptions->info_log, moptions->statistics,
-              SystemClock::Default().get(),
-              /* update_num_ops_stats */ false, /* op_failure_scope */ nullptr,
-              &new_value, /* result_operand */ nullptr, &new_value_type);
-        } else {
-          // `op_failure_scope` (an output parameter) is not provided (set to
-          // nullptr) since a failure must be propagated regardless of its
-          // value.
-          merge_status = MergeHelper::TimedFullMerge(
-              merge_operator, key, MergeHelper::kWideBaseValue, columns,
-              {value}, moptions->info_log, moptions->statistics,
-              SystemClock::Default().get(),
-              /* update_num_ops_stats */ false, /* op_failure_scope */ nullptr,
-              &new_value, /* result_operand */ nullptr, &new_value_type);
-        }
+        // `op_failure_scope` (an output parameter) is not provided (set to
+        // nullptr) since a failure must be propagated regardless of its
+        // value.
+        merge_status = MergeHelper::TimedFullMerge(
+            merge_operator, key, MergeHelper::kWideBaseValue, columns,
+            {value}, moptions->info_log, moptions->statistics,
+            SystemClock::Default().get(),
+            /* update_num_ops_stats */ false, /* op_failure_scope */ nullptr,
+            &new_value, /* result_operand */ nullptr, &new_value_type);
+      }
 
-        if (!merge_status.ok()) {
-          // Failed to merge!
-          // Store the delta in memtable
-          perform_merge = false;
+      if (!merge_status.ok()) {
+        // Failed to merge!
+        // Store the delta in memtable
+        perform_merge = false;
+      } else {
+        // 3) Add value to memtable
+        assert(!concurrent_memtable_writes_);
+        assert(new_value_type == kTypeValue ||
+               new_value_type == kTypeWideColumnEntity);
+
+        if (kv_prot_info != nullptr) {
+          auto merged_kv_prot_info =
+              kv_prot_info->StripC(column_family_id).ProtectS(sequence_);
+          merged_kv_prot_info.UpdateV(value, new_value);
+          merged_kv_prot_info.UpdateO(kTypeMerge, new_value_type);
+          ret_status = mem->Add(sequence_, new_value_type, key, new_value,
+                                &merged_kv_prot_info);
         } else {
-          // 3) Add value to memtable
-          assert(!concurrent_memtable_writes_);
-          assert(new_value_type == kTypeValue ||
-                 new_value_type == kTypeWideColumnEntity);
-
-          if (kv_prot_info != nullptr) {
-            auto merged_kv_prot_info =
-                kv_prot_info->StripC(column_family_id).ProtectS(sequence_);
-            merged_kv_prot_info.UpdateV(value, new_value);
-            merged_kv_prot_info.UpdateO(kTypeMerge, new_value_type);
-            ret_status = mem->Add(sequence_, new_value_type, key, new_value,
-                                  &merged_kv_prot_info);
-          } else {
-            ret_status = mem->Add(sequence_, new_value_type, key, new_value,
-                                  nullptr /* kv_prot_info */);
-          }
+          ret_status = mem->Add(sequence_, new_value_type, key, new_value,
+                                nullptr /* kv_prot_info */);
         }
       }
     }
@@ -3100,6 +3110,64 @@ Status WriteBatchInternal::SetContents(WriteBatch* b, const Slice& contents) {
   return Status::OK();
 }
 
+Status WriteBatchInternal::AppendRecords(WriteBatch* b, const Slice& records,
+                                         uint32_t count) {
+  if (b->prot_info_ != nullptr) {
+    return Status::NotSupported(
+        "Appending records to a WriteBatch with protection info");
+  }
+  if (b->max_bytes_ && b->rep_.size() + records.size() > b->max_bytes_) {
+    return Status::MemoryLimit();
+  }
+  Slice input(records);
+  Slice key, value, blob, xid;
+  uint32_t found = 0;
+  uint32_t flags = 0;
+  while (!input.empty()) {
+    char tag = 0;
+    uint32_t column_family = 0;
+    Status s = ReadRecordFromWriteBatch(&input, &tag, &column_family, &key,
+                                        &value, &blob, &xid);
+    if (!s.ok()) {
+      return s;
+    }
+    switch (tag) {
+      case kTypeColumnFamilyValue:
+      case kTypeValue:
+        flags |= ContentFlags::HAS_PUT;
+        break;
+      case kTypeColumnFamilyDeletion:
+      case kTypeDeletion:
+        flags |= ContentFlags::HAS_DELETE;
+        break;
+      case kTypeColumnFamilySingleDeletion:
+      case kTypeSingleDeletion:
+        flags |= ContentFlags::HAS_SINGLE_DELETE;
+        break;
+      case kTypeColumnFamilyRangeDeletion:
+      case kTypeRangeDeletion:
+        flags |= ContentFlags::HAS_DELETE_RANGE;
+        break;
+      case kTypeColumnFamilyMerge:
+      case kTypeMerge:
+        flags |= ContentFlags::HAS_MERGE;
+        break;
+      default:
+        return Status::InvalidArgument("unsupported WriteBatch record tag");
+    }
+    found++;
+  }
+  if (found != count) {
+    return Status::Corruption("WriteBatch records have wrong count");
+  }
+  b->rep_.append(records.data(), records.size());
+  SetCount(b, Count(b) + count);
+  b->content_flags_.store(
+      b->content_flags_.load(std::memory_order_relaxed) | flags,
+      std::memory_order_relaxed);
+  return Status::OK();
+}
+
 Status WriteBatchInternal::Append(WriteBatch* dst, const WriteBatch* src,
                                   const bool wal_only) {
   assert(dst->Count() == 0 ||
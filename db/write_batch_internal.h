@@ -154,6 +154,14 @@ class WriteBatchInternal {
 
   static Status SetContents(WriteBatch* batch, const Slice& contents);
 
+  // Appends `count` records serialized in the WriteBatch format, without the
+  // header, e.g. by another process or language binding. Only Put, Merge,
+  // Delete, SingleDelete and DeleteRange records, of any column family, are
+  // accepted. The records are validated as a whole before anything is
+  // appended.
+  static Status AppendRecords(WriteBatch* batch, const Slice& records,
+                              uint32_t count);
+
   static Status CheckSlicePartsLength(const SliceParts& key,
                                       const SliceParts& value);
 
@@ -233,6 +233,48 @@ TEST_F(WriteBatchTest, Append) {
   ASSERT_EQ(3u, b2.Count());
 }
 
+TEST_F(WriteBatchTest, AppendRecords) {
+  WriteBatch src;
+  ASSERT_OK(src.Put("a", "va"));
+  ASSERT_OK(src.Merge("b", "vb"));
+  ASSERT_OK(src.Delete("c"));
+  ASSERT_OK(src.DeleteRange("d", "e"));
+  Slice records = WriteBatchInternal::Contents(&src);
+  records.remove_prefix(WriteBatchInternal::kHeader);
+
+  WriteBatch b;
+  WriteBatchInternal::SetSequence(&b, 100);
+  ASSERT_OK(b.Put("z", "vz"));
+  ASSERT_OK(WriteBatchInternal::AppendRecords(&b, records, 4));
+  ASSERT_EQ(
+      "Put(a, va)@101"
+      "Merge(b, vb)@102"
+      "Delete(c)@103"
+      "Put(z, vz)@100"
+      "DeleteRange(d, e)@104",
+      PrintContents(&b));
+  ASSERT_EQ(5u, b.Count());
+  ASSERT_TRUE(b.HasMerge());
+  ASSERT_TRUE(b.HasDeleteRange());
+  ASSERT_FALSE(b.HasSingleDelete());
+
+  // Invalid records leave the batch unchanged
+  const size_t size = b.GetDataSize();
+  ASSERT_TRUE(
+      WriteBatchInternal::AppendRecords(&b, records, 3).IsCorruption());
+  Slice truncated(records.data(), records.size() - 1);
+  ASSERT_TRUE(
+      WriteBatchInternal::AppendRecords(&b, truncated, 4).IsCorruption());
+  WriteBatch log_data;
+  ASSERT_OK(log_data.PutLogData("blob"));
+  Slice log_record = WriteBatchInternal::Contents(&log_data);
+  log_record.remove_prefix(WriteBatchInternal::kHeader);
+  ASSERT_TRUE(WriteBatchInternal::AppendRecords(&b, log_record, 0)
+                  .IsInvalidArgument());
+  ASSERT_EQ(size, b.GetDataSize());
+  ASSERT_EQ(5u, b.Count());
+}
+
 TEST_F(WriteBatchTest, SingleDeletion) {
   WriteBatch batch;
   WriteBatchInternal::SetSequence(&batch, 100);
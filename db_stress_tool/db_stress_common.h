@@ -370,7 +370,7 @@ extern enum ROCKSDB_NAMESPACE::CompressionType compression_type_e;
 extern enum ROCKSDB_NAMESPACE::CompressionType bottommost_compression_type_e;
 extern enum ROCKSDB_NAMESPACE::ChecksumType checksum_type_e;
 
-enum RepFactory { kSkipList, kHashSkipList, kVectorRep };
+enum RepFactory { kSkipList, kHashSkipList, kVectorRep, kBTree };
 
 inline enum RepFactory StringToRepFactory(const char* ctype) {
   assert(ctype);
@@ -381,6 +381,8 @@ inline enum RepFactory StringToRepFactory(const char* ctype) {
     return kHashSkipList;
   else if (!strcasecmp(ctype, "vector"))
     return kVectorRep;
+  else if (!strcasecmp(ctype, "btree"))
+    return kBTree;
 
   fprintf(stdout, "Cannot parse memreptable %s\n", ctype);
   return kSkipList;
@@ -247,6 +247,7 @@ bool StressTest::BuildOptionsTable() {
        }},
       {"memtable_huge_page_size", {"0", std::to_string(2 * 1024 * 1024)}},
       {"max_successive_merges", {"0", "2", "4"}},
+      {"memtable_max_successive_merges", {"0", "2", "4"}},
       {"inplace_update_num_locks", {"100", "200", "300"}},
       // TODO: re-enable once internal task T124324915 is fixed.
       // {"experimental_mempurge_threshold", {"0.0", "1.0"}},
@@ -2617,6 +2618,9 @@ void StressTest::PrintEnv() const {
     case kVectorRep:
       memtablerep = "vector";
       break;
+    case kBTree:
+      memtablerep = "btree";
+      break;
   }
 
   fprintf(stdout, "Memtablerep               : %s\n", memtablerep);
@@ -3459,6 +3463,9 @@ void InitializeOptionsFromFlags(
     case kVectorRep:
       options.memtable_factory.reset(new VectorRepFactory());
       break;
+    case kBTree:
+      options.memtable_factory.reset(new BTreeRepFactory());
+      break;
   }
 
   InitializeMergeOperator(options);
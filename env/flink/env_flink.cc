@@ -18,8 +18,17 @@
 
 #include "env_flink.h"
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <deque>
+#include <unordered_set>
+
 #include "jvm_util.h"
 #include "logging/env_logger.h"
+#include "rocksdb/system_clock.h"
+#include "util/mutexlock.h"
+#include "util/stop_watch.h"
 
 //
 // This file defines a Flink environment for ForSt. It uses the JNI call
@@ -35,17 +44,23 @@ class FlinkWritableFile : public FSWritableFile {
   const jobject file_system_instance_;
   jobject fs_data_output_stream_instance_;
   JavaClassCache* class_cache_;
+  FlinkFileStatusCache* file_status_cache_;
+  Statistics* statistics_;
   bool closed_;
 
  public:
   FlinkWritableFile(jobject file_system_instance,
                     JavaClassCache* java_class_cache,
-                    const std::string& file_path, const FileOptions& options)
+                    FlinkFileStatusCache* file_status_cache,
+                    Statistics* statistics, const std::string& file_path,
+                    const FileOptions& options)
       : FSWritableFile(options),
         file_path_(file_path),
         file_system_instance_(file_system_instance),
         fs_data_output_stream_instance_(nullptr),
         class_cache_(java_class_cache),
+        file_status_cache_(file_status_cache),
+        statistics_(statistics),
         closed_(false) {}
 
   ~FlinkWritableFile() override {
@@ -60,12 +75,24 @@ class FlinkWritableFile : public FSWritableFile {
     JNIEnv* jniEnv = getJNIEnv();
     jstring pathString = jniEnv->NewStringUTF(file_path_.c_str());
 
-    JavaClassCache::JavaMethodContext fileSystemCreateMethod =
+    if (file_status_cache_ != nullptr) {
+      file_status_cache_->BeginWrite(file_path_);
+    }
+    const JavaClassCache::JavaMethodContext& fileSystemCreateMethod =
         class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_SYSTEM_CREATE);
-    jobject fsDataOutputStream = jniEnv->CallObjectMethod(
-        file_system_instance_, fileSystemCreateMethod.javaMethod, pathString);
+    jobject fsDataOutputStream;
+    {
+      StopWatch sw(SystemClock::Default().get(), statistics_,
+                   FLINK_FS_OPEN_MICROS);
+      fsDataOutputStream = jniEnv->CallObjectMethod(
+          file_system_instance_, fileSystemCreateMethod.javaMethod,
+          pathString);
+    }
     jniEnv->DeleteLocalRef(pathString);
     if (fsDataOutputStream == nullptr || jniEnv->ExceptionCheck()) {
+      if (file_status_cache_ != nullptr) {
+        file_status_cache_->EndWrite(file_path_, false);
+      }
       return CheckThenError(
           std::string(
               "CallObjectMethod Exception when Init FlinkWritableFile, ")
@@ -89,17 +116,27 @@ class FlinkWritableFile : public FSWritableFile {
     }
     jobject directByteBuffer = jniEnv->NewDirectByteBuffer(
         (void*)data.data(), static_cast<long>(data.size()));
+    if (directByteBuffer == nullptr) {
+      return CheckThenError(
+          std::string("Exception when NewDirectByteBuffer in Append, path: ")
+              .append(file_path_));
+    }
 
-    JavaClassCache::JavaMethodContext writeMethod = class_cache_->GetJMethod(
-        JavaClassCache::JM_FLINK_FS_OUTPUT_STREAM_WRITE);
-    jniEnv->CallVoidMethod(fs_data_output_stream_instance_,
-                           writeMethod.javaMethod, directByteBuffer);
+    const JavaClassCache::JavaMethodContext& writeMethod =
+        class_cache_->GetJMethod(
+            JavaClassCache::JM_FLINK_FS_OUTPUT_STREAM_WRITE);
+    {
+      StopWatch sw(SystemClock::Default().get(), statistics_,
+                   FLINK_FS_WRITE_MICROS);
+      jniEnv->CallVoidMethod(fs_data_output_stream_instance_,
+                             writeMethod.javaMethod, directByteBuffer);
+    }
     jniEnv->DeleteLocalRef(directByteBuffer);
+    RecordTick(statistics_, FLINK_FS_BYTES_WRITTEN, data.size());
 
-    std::string filePath = file_path_;
-    return CurrentStatus([filePath]() {
+    return CurrentStatus([this]() {
       return std::string("Exception when Appending file, path: ")
-          .append(filePath);
+          .append(file_path_);
     });
   }
 
@@ -111,29 +148,39 @@ class FlinkWritableFile : public FSWritableFile {
 
   IOStatus Flush(const IOOptions& /*options*/,
                  IODebugContext* /*dbg*/) override {
-    JavaClassCache::JavaMethodContext flushMethod = class_cache_->GetJMethod(
-        JavaClassCache::JM_FLINK_FS_OUTPUT_STREAM_FLUSH);
+    const JavaClassCache::JavaMethodContext& flushMethod =
+        class_cache_->GetJMethod(
+            JavaClassCache::JM_FLINK_FS_OUTPUT_STREAM_FLUSH);
     JNIEnv* jniEnv = getJNIEnv();
-    jniEnv->CallVoidMethod(fs_data_output_stream_instance_,
-                           flushMethod.javaMethod);
+    {
+      StopWatch sw(SystemClock::Default().get(), statistics_,
+                   FLINK_FS_SYNC_MICROS);
+      jniEnv->CallVoidMethod(fs_data_output_stream_instance_,
+                             flushMethod.javaMethod);
+    }
 
-    std::string filePath = file_path_;
-    return CurrentStatus([filePath]() {
-      return std::string("Exception when Flush file, path: ").append(filePath);
+    return CurrentStatus([this]() {
+      return std::string("Exception when Flush file, path: ")
+          .append(file_path_);
     });
   }
 
   IOStatus Sync(const IOOptions& /*options*/,
                 IODebugContext* /*dbg*/) override {
-    JavaClassCache::JavaMethodContext flushMethod = class_cache_->GetJMethod(
-        JavaClassCache::JM_FLINK_FS_OUTPUT_STREAM_SYNC);
+    const JavaClassCache::JavaMethodContext& flushMethod =
+        class_cache_->GetJMethod(
+            JavaClassCache::JM_FLINK_FS_OUTPUT_STREAM_SYNC);
     JNIEnv* jniEnv = getJNIEnv();
-    jniEnv->CallVoidMethod(fs_data_output_stream_instance_,
-                           flushMethod.javaMethod);
+    {
+      StopWatch sw(SystemClock::Default().get(), statistics_,
+                   FLINK_FS_SYNC_MICROS);
+      jniEnv->CallVoidMethod(fs_data_output_stream_instance_,
+                             flushMethod.javaMethod);
+    }
 
-    std::string filePath = file_path_;
-    return CurrentStatus([filePath]() {
-      return std::string("Exception when Sync file, path: ").append(filePath);
+    return CurrentStatus([this]() {
+      return std::string("Exception when Sync file, path: ")
+          .append(file_path_);
     });
   }
 
@@ -147,19 +194,87 @@ class FlinkWritableFile : public FSWritableFile {
       return IOStatus::OK();
     }
     closed_ = true;
-    JavaClassCache::JavaMethodContext closeMethod = class_cache_->GetJMethod(
-        JavaClassCache::JM_FLINK_FS_OUTPUT_STREAM_CLOSE);
+    const JavaClassCache::JavaMethodContext& closeMethod =
+        class_cache_->GetJMethod(
+            JavaClassCache::JM_FLINK_FS_OUTPUT_STREAM_CLOSE);
     JNIEnv* jniEnv = getJNIEnv();
-    jniEnv->CallVoidMethod(fs_data_output_stream_instance_,
-                           closeMethod.javaMethod);
+    {
+      StopWatch sw(SystemClock::Default().get(), statistics_,
+                   FLINK_FS_CLOSE_MICROS);
+      jniEnv->CallVoidMethod(fs_data_output_stream_instance_,
+                             closeMethod.javaMethod);
+    }
+    if (file_status_cache_ != nullptr) {
+      file_status_cache_->EndWrite(file_path_, true);
+    }
 
-    std::string filePath = file_path_;
-    return CurrentStatus([filePath]() {
-      return std::string("Exception when Close file, path: ").append(filePath);
+    return CurrentStatus([this]() {
+      return std::string("Exception when Close file, path: ")
+          .append(file_path_);
     });
   }
 };
 
+// IO handle of an asynchronous read submitted to Flink FileSystem. The Java
+// side completes the read on its own executor and the result is collected from
+// the Future by FlinkFileSystem::Poll.
+struct FlinkIOHandle {
+  FlinkIOHandle(jobject _future,
+                std::function<void(const FSReadRequest&, void*)> _cb,
+                void* _cb_arg, uint64_t _offset, size_t _len, char* _scratch)
+      : future(_future),
+        cb(_cb),
+        cb_arg(_cb_arg),
+        offset(_offset),
+        len(_len),
+        scratch(_scratch),
+        is_finished(false) {}
+
+  // Global ref of java.util.concurrent.Future<Integer>
+  jobject future;
+  std::function<void(const FSReadRequest&, void*)> cb;
+  void* cb_arg;
+  uint64_t offset;
+  size_t len;
+  char* scratch;
+  bool is_finished;
+};
+
+// The FlinkIOHandles not deleted yet. Files cached or staged locally are read
+// by the target FileSystem, so Poll and AbortIO may also be given its handles.
+class FlinkIOHandleRegistry {
+ public:
+  static FlinkIOHandleRegistry* Get() {
+    static FlinkIOHandleRegistry* registry = new FlinkIOHandleRegistry();
+    return registry;
+  }
+
+  void Add(void* io_handle) {
+    MutexLock lock(&mutex_);
+    handles_.insert(io_handle);
+  }
+
+  void Remove(void* io_handle) {
+    MutexLock lock(&mutex_);
+    handles_.erase(io_handle);
+  }
+
+  // Moves the handles not created by Flink into others.
+  void Split(std::vector<void*>* flink_handles, std::vector<void*>* others) {
+    MutexLock lock(&mutex_);
+    auto it = std::stable_partition(
+        flink_handles->begin(), flink_handles->end(), [this](void* h) {
+          return h == nullptr || handles_.count(h) > 0;
+        });
+    others->assign(it, flink_handles->end());
+    flink_handles->erase(it, flink_handles->end());
+  }
+
+ private:
+  port::Mutex mutex_;
+  std::unordered_set<void*> handles_;
+};
+
 // Used for reading a file from Flink FileSystem. It implements both
 // sequential-read access methods and random read access methods.
 class FlinkReadableFile : virtual public FSSequentialFile,
@@ -167,23 +282,90 @@ class FlinkReadableFile : virtual public FSSequentialFile,
  private:
   const std::string file_path_;
   const jobject file_system_instance_;
+  // Used by sequential reads and async reads, and also pooled for random reads
   jobject fs_data_input_stream_instance_;
   JavaClassCache* class_cache_;
+  Statistics* statistics_;
+
+  // Pool of input streams leased by random reads. Only used when more than one
+  // stream is allowed, otherwise all the reads share
+  // fs_data_input_stream_instance_ as Flink supports concurrent positional
+  // reads on one stream.
+  const size_t max_input_streams_;
+  mutable port::Mutex streams_mutex_;
+  mutable port::CondVar streams_cv_;
+  mutable std::vector<jobject> idle_input_streams_;
+  mutable size_t num_input_streams_;
+
+  // A range of the file read ahead by Prefetch.
+  struct PrefetchBuffer {
+    uint64_t offset = 0;
+    size_t len = 0;
+    size_t capacity = 0;
+    // The range reaches the end of the file
+    bool eof = false;
+    // Bytes served by reads
+    size_t consumed = 0;
+    std::unique_ptr<char[]> data;
+  };
+
+  // Buffers of a few concurrent scans of the file are kept, they are reused
+  // in the order of last use. As their memory is limited for all the files,
+  // a buffer is released as soon as it's consumed or a scan has moved past
+  // it, rather than kept until replaced.
+  static constexpr size_t kMaxPrefetchBuffers = 2;
+
+  // nullptr if Prefetch is not supported
+  FlinkReadaheadPolicy* readahead_policy_;
+  const uint64_t max_whole_file_prefetch_size_;
+  const std::function<IOStatus(uint64_t*)> get_file_size_;
+  mutable port::Mutex prefetch_mutex_;
+  mutable std::deque<PrefetchBuffer> prefetch_buffers_;
+  uint64_t file_size_;
+  bool file_size_known_;
 
  public:
-  FlinkReadableFile(jobject file_system_instance,
-                    JavaClassCache* java_class_cache,
-                    const std::string& file_path)
+  FlinkReadableFile(
+      jobject file_system_instance, JavaClassCache* java_class_cache,
+      const std::string& file_path, size_t max_input_streams,
+      Statistics* statistics, FlinkReadaheadPolicy* readahead_policy = nullptr,
+      uint64_t max_whole_file_prefetch_size = 0,
+      const std::function<IOStatus(uint64_t*)>& get_file_size = nullptr)
       : file_path_(file_path),
         file_system_instance_(file_system_instance),
         fs_data_input_stream_instance_(nullptr),
-        class_cache_(java_class_cache) {}
+        class_cache_(java_class_cache),
+        statistics_(statistics),
+        max_input_streams_(std::max(max_input_streams, size_t{1})),
+        streams_cv_(&streams_mutex_),
+        num_input_streams_(0),
+        readahead_policy_(readahead_policy),
+        max_whole_file_prefetch_size_(
+            get_file_size != nullptr ? max_whole_file_prefetch_size : 0),
+        get_file_size_(get_file_size),
+        file_size_(0),
+        file_size_known_(false) {}
 
   ~FlinkReadableFile() override {
+    for (const auto& buffer : prefetch_buffers_) {
+      readahead_policy_->ReleaseMemory(buffer.capacity);
+    }
     JNIEnv* jniEnv = getJNIEnv();
+    const JavaClassCache::JavaMethodContext& closeMethod =
+        class_cache_->GetJMethod(
+            JavaClassCache::JM_FLINK_FS_INPUT_STREAM_CLOSE);
+    // All leased streams have been returned, the first one is in the pool too
+    // if pooling is enabled
+    assert(idle_input_streams_.size() == num_input_streams_);
+    StopWatch sw(SystemClock::Default().get(), statistics_,
+                 FLINK_FS_CLOSE_MICROS);
+    for (jobject inputStream : idle_input_streams_) {
+      if (inputStream != fs_data_input_stream_instance_) {
+        jniEnv->CallVoidMethod(inputStream, closeMethod.javaMethod);
+        jniEnv->DeleteGlobalRef(inputStream);
+      }
+    }
     if (fs_data_input_stream_instance_ != nullptr) {
-      JavaClassCache::JavaMethodContext closeMethod = class_cache_->GetJMethod(
-          JavaClassCache::JM_FLINK_FS_INPUT_STREAM_CLOSE);
       jniEnv->CallVoidMethod(fs_data_input_stream_instance_,
                              closeMethod.javaMethod);
       jniEnv->DeleteGlobalRef(fs_data_input_stream_instance_);
@@ -191,27 +373,12 @@ class FlinkReadableFile : virtual public FSSequentialFile,
   }
 
   IOStatus Init() {
-    JNIEnv* jniEnv = getJNIEnv();
-    jstring pathString = jniEnv->NewStringUTF(file_path_.c_str());
-
-    JavaClassCache::JavaMethodContext openMethod =
-        class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_SYSTEM_OPEN);
-    jobject fsDataInputStream = jniEnv->CallObjectMethod(
-        file_system_instance_, openMethod.javaMethod, pathString);
-    jniEnv->DeleteLocalRef(pathString);
-    if (fsDataInputStream == nullptr || jniEnv->ExceptionCheck()) {
-      return CheckThenError(
-          std::string(
-              "CallObjectMethod Exception when Init FlinkReadableFile, ")
-              .append(openMethod.ToString())
-              .append(", args: Path(")
-              .append(file_path_)
-              .append(")"));
+    IOStatus status = OpenInputStream(&fs_data_input_stream_instance_);
+    if (status.ok() && max_input_streams_ > 1) {
+      idle_input_streams_.push_back(fs_data_input_stream_instance_);
+      num_input_streams_ = 1;
     }
-
-    fs_data_input_stream_instance_ = jniEnv->NewGlobalRef(fsDataInputStream);
-    jniEnv->DeleteLocalRef(fsDataInputStream);
-    return IOStatus::OK();
+    return status;
   }
 
   // sequential access, read data at current offset in file
@@ -225,25 +392,36 @@ class FlinkReadableFile : virtual public FSSequentialFile,
     }
     jobject directByteBuffer =
         jniEnv->NewDirectByteBuffer((void*)scratch, static_cast<long>(n));
+    if (directByteBuffer == nullptr) {
+      return CheckThenError(
+          std::string("Exception when NewDirectByteBuffer in Read, path: ")
+              .append(file_path_));
+    }
 
-    JavaClassCache::JavaMethodContext readMethod = class_cache_->GetJMethod(
-        JavaClassCache::JM_FLINK_FS_INPUT_STREAM_SEQ_READ);
-    jint totalBytesRead =
-        jniEnv->CallIntMethod(fs_data_input_stream_instance_,
-                              readMethod.javaMethod, directByteBuffer);
-
+    const JavaClassCache::JavaMethodContext& readMethod =
+        class_cache_->GetJMethod(
+            JavaClassCache::JM_FLINK_FS_INPUT_STREAM_SEQ_READ);
+    jint totalBytesRead;
+    {
+      StopWatch sw(SystemClock::Default().get(), statistics_,
+                   FLINK_FS_READ_MICROS);
+      totalBytesRead = jniEnv->CallIntMethod(fs_data_input_stream_instance_,
+                                             readMethod.javaMethod,
+                                             directByteBuffer);
+    }
     jniEnv->DeleteLocalRef(directByteBuffer);
 
-    std::string filePath = file_path_;
-    IOStatus status = CurrentStatus([filePath]() {
+    IOStatus status = CurrentStatus([this]() {
       return std::string("Exception when Reading file, path: ")
-          .append(filePath);
+          .append(file_path_);
     });
     if (!status.ok()) {
       return status;
     }
 
-    *result = Slice(scratch, totalBytesRead == -1 ? 0 : totalBytesRead);
+    size_t bytesRead = totalBytesRead == -1 ? 0 : totalBytesRead;
+    RecordReadBytes(bytesRead);
+    *result = Slice(scratch, bytesRead);
     return IOStatus::OK();
   }
 
@@ -251,69 +429,626 @@ class FlinkReadableFile : virtual public FSSequentialFile,
   IOStatus Read(uint64_t offset, size_t n, const IOOptions& /*options*/,
                 Slice* result, char* scratch,
                 IODebugContext* /*dbg*/) const override {
-    JNIEnv* jniEnv = getJNIEnv();
-    if (n > static_cast<size_t>(LONG_MAX)) {
-      return IOStatus::IOError(
-          std::string("Read too big data to file, data size: ")
-              .append(std::to_string(n)));
+    if (readahead_policy_ != nullptr &&
+        ReadFromPrefetchBuffers(offset, n, result, scratch)) {
+      return IOStatus::OK();
     }
-    jobject directByteBuffer =
-        jniEnv->NewDirectByteBuffer((void*)scratch, static_cast<long>(n));
+    size_t bytesRead;
+    IOStatus status = RemoteRead(offset, n, scratch, &bytesRead);
+    if (!status.ok()) {
+      return status;
+    }
+    *result = Slice(scratch, bytesRead);
+    return IOStatus::OK();
+  }
 
-    JavaClassCache::JavaMethodContext readMethod = class_cache_->GetJMethod(
-        JavaClassCache::JM_FLINK_FS_INPUT_STREAM_RANDOM_READ);
-    jint totalBytesRead =
-        jniEnv->CallIntMethod(fs_data_input_stream_instance_,
-                              readMethod.javaMethod, offset, directByteBuffer);
+  // Reads ahead into a buffer of this file, sized by the readahead policy by
+  // the observed cost of remote reads instead of the requested size, which
+  // is tuned for local disks. A compaction input is read as a whole if it's
+  // small enough.
+  IOStatus Prefetch(uint64_t offset, size_t n, const IOOptions& options,
+                    IODebugContext* /*dbg*/) override {
+    if (readahead_policy_ == nullptr) {
+      return IOStatus::NotSupported("Prefetch");
+    }
+    {
+      MutexLock lock(&prefetch_mutex_);
+      ReleasePrefetchBuffersBefore(offset);
+      if (FindPrefetchBuffer(offset, n) != prefetch_buffers_.end()) {
+        return IOStatus::OK();
+      }
+    }
 
-    jniEnv->DeleteLocalRef(directByteBuffer);
+    uint64_t readaheadOffset = offset;
+    size_t readaheadSize = readahead_policy_->GetReadaheadSize(n);
+    bool wholeFile = false;
+    uint64_t fileSize;
+    if (options.io_activity == Env::IOActivity::kCompaction &&
+        max_whole_file_prefetch_size_ > 0 &&
+        GetRemoteFileSize(&fileSize).ok() &&
+        fileSize <= max_whole_file_prefetch_size_) {
+      readaheadOffset = 0;
+      readaheadSize = static_cast<size_t>(fileSize);
+      wholeFile = true;
+    }
+    readaheadSize = std::min(readaheadSize, static_cast<size_t>(INT_MAX));
+    if (readaheadSize == 0) {
+      return IOStatus::OK();
+    }
+    if (!readahead_policy_->ReserveMemory(readaheadSize)) {
+      // Blocks are read on demand until other buffers are released
+      return IOStatus::Busy("Readahead memory of FlinkFileSystem is full");
+    }
 
-    std::string filePath = file_path_;
-    IOStatus status = CurrentStatus([filePath]() {
-      return std::string("Exception when Reading file, path: ")
-          .append(filePath);
+    PrefetchBuffer buffer;
+    buffer.offset = readaheadOffset;
+    buffer.capacity = readaheadSize;
+    buffer.data.reset(new char[readaheadSize]);
+    IOStatus status = RemoteRead(readaheadOffset, readaheadSize,
+                                 buffer.data.get(), &buffer.len);
+    if (!status.ok()) {
+      readahead_policy_->ReleaseMemory(readaheadSize);
+      return status;
+    }
+    buffer.eof = wholeFile || buffer.len < readaheadSize;
+
+    MutexLock lock(&prefetch_mutex_);
+    prefetch_buffers_.push_back(std::move(buffer));
+    while (prefetch_buffers_.size() > kMaxPrefetchBuffers) {
+      readahead_policy_->ReleaseMemory(prefetch_buffers_.front().capacity);
+      prefetch_buffers_.pop_front();
+    }
+    return IOStatus::OK();
+  }
+
+  // Coalesces adjacent or nearby requests into ranges, then reads all ranges
+  // by a single JNI call, so that the Flink FileSystem could fetch them in
+  // parallel. A range of one request is read into its scratch directly, only
+  // a range of several requests is read into its own buffer and copied out.
+  // Falls back to reading one by one if the Java side doesn't provide the
+  // batched readFully.
+  IOStatus MultiRead(FSReadRequest* reqs, size_t num_reqs,
+                     const IOOptions& options,
+                     IODebugContext* dbg) override {
+    const JavaClassCache::JavaMethodContext& multiReadMethod =
+        class_cache_->GetJMethod(
+            JavaClassCache::JM_FLINK_FS_INPUT_STREAM_MULTI_READ);
+    if (multiReadMethod.javaMethod == nullptr || num_reqs <= 1) {
+      return FSRandomAccessFile::MultiRead(reqs, num_reqs, options, dbg);
+    }
+
+    std::vector<CoalescedRange> ranges;
+    IOStatus status = CoalesceReadRequests(reqs, num_reqs, &ranges);
+    if (!status.ok()) {
+      return status;
+    }
+
+    std::vector<jlong> positions;
+    std::vector<jint> lengths;
+    std::vector<std::unique_ptr<char[]>> rangeBuffers;
+    positions.reserve(ranges.size());
+    lengths.reserve(ranges.size());
+    rangeBuffers.reserve(ranges.size());
+    for (const auto& range : ranges) {
+      positions.push_back(static_cast<jlong>(range.offset));
+      lengths.push_back(static_cast<jint>(range.len));
+      rangeBuffers.emplace_back(range.req_indexes.size() > 1
+                                    ? new char[range.len]
+                                    : nullptr);
+    }
+
+    JNIEnv* jniEnv = getJNIEnv();
+    auto rangesLen = static_cast<jsize>(ranges.size());
+    const JavaClassCache::JavaClassContext& byteBufferClass =
+        class_cache_->GetJClass(JavaClassCache::JC_BYTE_BUFFER);
+    jlongArray positionArray = jniEnv->NewLongArray(rangesLen);
+    jintArray lengthArray = jniEnv->NewIntArray(rangesLen);
+    jobjectArray bufferArray =
+        jniEnv->NewObjectArray(rangesLen, byteBufferClass.javaClass, nullptr);
+    auto deleteArrays = [jniEnv, positionArray, lengthArray, bufferArray]() {
+      if (positionArray != nullptr) {
+        jniEnv->DeleteLocalRef(positionArray);
+      }
+      if (lengthArray != nullptr) {
+        jniEnv->DeleteLocalRef(lengthArray);
+      }
+      if (bufferArray != nullptr) {
+        jniEnv->DeleteLocalRef(bufferArray);
+      }
+    };
+    if (positionArray == nullptr || lengthArray == nullptr ||
+        bufferArray == nullptr) {
+      deleteArrays();
+      return CheckThenError(
+          std::string("Exception when allocating arrays in MultiRead, path: ")
+              .append(file_path_));
+    }
+    jniEnv->SetLongArrayRegion(positionArray, 0, rangesLen, positions.data());
+    jniEnv->SetIntArrayRegion(lengthArray, 0, rangesLen, lengths.data());
+    for (size_t i = 0; i < ranges.size(); i++) {
+      char* data = rangeBuffers[i] != nullptr
+                       ? rangeBuffers[i].get()
+                       : reqs[ranges[i].req_indexes[0]].scratch;
+      jobject directByteBuffer = jniEnv->NewDirectByteBuffer(
+          (void*)data, static_cast<jlong>(ranges[i].len));
+      if (directByteBuffer == nullptr) {
+        deleteArrays();
+        return CheckThenError(
+            std::string("Exception when NewDirectByteBuffer in MultiRead, "
+                        "path: ")
+                .append(file_path_));
+      }
+      jniEnv->SetObjectArrayElement(bufferArray, static_cast<jsize>(i),
+                                    directByteBuffer);
+      jniEnv->DeleteLocalRef(directByteBuffer);
+    }
+    jobject inputStream;
+    status = LeaseInputStream(&inputStream);
+    if (!status.ok()) {
+      deleteArrays();
+      return status;
+    }
+
+    {
+      StopWatch sw(SystemClock::Default().get(), statistics_,
+                   FLINK_FS_READ_MICROS);
+      jniEnv->CallVoidMethod(inputStream, multiReadMethod.javaMethod,
+                             positionArray, lengthArray, bufferArray);
+    }
+    ReturnInputStream(inputStream);
+
+    status = CurrentStatus([this]() {
+      return std::string("Exception when MultiRead file, path: ")
+          .append(file_path_);
     });
+    if (status.ok()) {
+      // The Java side overwrites the lengths with the bytes actually read,
+      // which may be fewer than requested at the end of file.
+      jniEnv->GetIntArrayRegion(lengthArray, 0, rangesLen, lengths.data());
+    }
+    deleteArrays();
     if (!status.ok()) {
       return status;
     }
 
-    *result = Slice(scratch, totalBytesRead == -1 ? 0 : totalBytesRead);
+    for (size_t i = 0; i < ranges.size(); i++) {
+      const CoalescedRange& range = ranges[i];
+      size_t rangeBytesRead = lengths[i] < 0 ? 0 : lengths[i];
+      RecordReadBytes(rangeBytesRead);
+      for (size_t reqIdx : range.req_indexes) {
+        FSReadRequest& req = reqs[reqIdx];
+        size_t offsetInRange = req.offset - range.offset;
+        size_t n = 0;
+        if (rangeBytesRead > offsetInRange) {
+          n = std::min(req.len, rangeBytesRead - offsetInRange);
+        }
+        if (n > 0 && rangeBuffers[i] != nullptr) {
+          memcpy(req.scratch, rangeBuffers[i].get() + offsetInRange, n);
+        }
+        req.result = Slice(req.scratch, n);
+        req.status = IOStatus::OK();
+      }
+    }
+    return IOStatus::OK();
+  }
+
+  // Submits the read to the Java side which returns a Future. The scratch must
+  // stay valid until the handle is completed by Poll or AbortIO.
+  IOStatus ReadAsync(FSReadRequest& req, const IOOptions& opts,
+                     std::function<void(const FSReadRequest&, void*)> cb,
+                     void* cb_arg, void** io_handle, IOHandleDeleter* del_fn,
+                     IODebugContext* dbg) override {
+    const JavaClassCache::JavaMethodContext& readAsyncMethod =
+        class_cache_->GetJMethod(
+            JavaClassCache::JM_FLINK_FS_INPUT_STREAM_READ_ASYNC);
+    if (readAsyncMethod.javaMethod == nullptr) {
+      return FSRandomAccessFile::ReadAsync(req, opts, cb, cb_arg, io_handle,
+                                           del_fn, dbg);
+    }
+    if (req.len > static_cast<size_t>(INT_MAX)) {
+      return IOStatus::IOError(
+          std::string("Read too big data to file, data size: ")
+              .append(std::to_string(req.len)));
+    }
+
+    JNIEnv* jniEnv = getJNIEnv();
+    jobject directByteBuffer = jniEnv->NewDirectByteBuffer(
+        (void*)req.scratch, static_cast<jlong>(req.len));
+    jobject future = jniEnv->CallObjectMethod(
+        fs_data_input_stream_instance_, readAsyncMethod.javaMethod,
+        static_cast<jlong>(req.offset), directByteBuffer);
+    jniEnv->DeleteLocalRef(directByteBuffer);
+    if (future == nullptr || jniEnv->ExceptionCheck()) {
+      return CheckThenError(
+          std::string("Exception when ReadAsync file, path: ")
+              .append(file_path_));
+    }
+
+    auto flinkHandle =
+        new FlinkIOHandle(jniEnv->NewGlobalRef(future), cb, cb_arg,
+                          req.offset, req.len, req.scratch);
+    jniEnv->DeleteLocalRef(future);
+
+    *io_handle = static_cast<void*>(flinkHandle);
+    FlinkIOHandleRegistry::Get()->Add(*io_handle);
+    *del_fn = [](void* args) -> void {
+      FlinkIOHandleRegistry::Get()->Remove(args);
+      auto handle = static_cast<FlinkIOHandle*>(args);
+      getJNIEnv()->DeleteGlobalRef(handle->future);
+      delete handle;
+    };
     return IOStatus::OK();
   }
 
   IOStatus Skip(uint64_t n) override {
     JNIEnv* jniEnv = getJNIEnv();
-    JavaClassCache::JavaMethodContext skipMethod =
+    const JavaClassCache::JavaMethodContext& skipMethod =
         class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FS_INPUT_STREAM_SKIP);
     jniEnv->CallVoidMethod(fs_data_input_stream_instance_,
                            skipMethod.javaMethod, n);
 
-    std::string filePath = file_path_;
-    return CurrentStatus([filePath]() {
+    return CurrentStatus([this]() {
       return std::string("Exception when skipping file, path: ")
-          .append(filePath);
+          .append(file_path_);
+    });
+  }
+
+ private:
+  IOStatus OpenInputStream(jobject* inputStream) const {
+    JNIEnv* jniEnv = getJNIEnv();
+    jstring pathString = jniEnv->NewStringUTF(file_path_.c_str());
+
+    const JavaClassCache::JavaMethodContext& openMethod =
+        class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_SYSTEM_OPEN);
+    jobject fsDataInputStream;
+    {
+      StopWatch sw(SystemClock::Default().get(), statistics_,
+                   FLINK_FS_OPEN_MICROS);
+      fsDataInputStream = jniEnv->CallObjectMethod(
+          file_system_instance_, openMethod.javaMethod, pathString);
+    }
+    jniEnv->DeleteLocalRef(pathString);
+    if (fsDataInputStream == nullptr || jniEnv->ExceptionCheck()) {
+      return CheckThenError(
+          std::string(
+              "CallObjectMethod Exception when Init FlinkReadableFile, ")
+              .append(openMethod.ToString())
+              .append(", args: Path(")
+              .append(file_path_)
+              .append(")"));
+    }
+
+    *inputStream = jniEnv->NewGlobalRef(fsDataInputStream);
+    jniEnv->DeleteLocalRef(fsDataInputStream);
+    return IOStatus::OK();
+  }
+
+  // Leases an input stream for exclusive use by one random read. Opens a new
+  // one if all are in use and the pool isn't full, otherwise waits for one to
+  // be returned.
+  IOStatus LeaseInputStream(jobject* inputStream) const {
+    if (max_input_streams_ <= 1) {
+      *inputStream = fs_data_input_stream_instance_;
+      return IOStatus::OK();
+    }
+
+    streams_mutex_.Lock();
+    while (idle_input_streams_.empty() &&
+           num_input_streams_ >= max_input_streams_) {
+      streams_cv_.Wait();
+    }
+    if (!idle_input_streams_.empty()) {
+      *inputStream = idle_input_streams_.back();
+      idle_input_streams_.pop_back();
+      streams_mutex_.Unlock();
+      return IOStatus::OK();
+    }
+    // Reserve a slot, and open the stream without holding the lock
+    num_input_streams_++;
+    streams_mutex_.Unlock();
+
+    IOStatus status = OpenInputStream(inputStream);
+    if (!status.ok()) {
+      MutexLock lock(&streams_mutex_);
+      num_input_streams_--;
+      streams_cv_.Signal();
+    }
+    return status;
+  }
+
+  void ReturnInputStream(jobject inputStream) const {
+    if (max_input_streams_ <= 1) {
+      return;
+    }
+    MutexLock lock(&streams_mutex_);
+    idle_input_streams_.push_back(inputStream);
+    streams_cv_.Signal();
+  }
+
+  void RecordReadBytes(size_t n) const {
+    RecordInHistogram(statistics_, FLINK_FS_READ_BYTES, n);
+    RecordTick(statistics_, FLINK_FS_BYTES_READ, n);
+  }
+
+  // Reads from the remote file by one JNI call, which is recorded by the
+  // readahead policy.
+  IOStatus RemoteRead(uint64_t offset, size_t n, char* scratch,
+                      size_t* bytesRead) const {
+    JNIEnv* jniEnv = getJNIEnv();
+    if (n > static_cast<size_t>(LONG_MAX)) {
+      return IOStatus::IOError(
+          std::string("Read too big data to file, data size: ")
+              .append(std::to_string(n)));
+    }
+    jobject directByteBuffer =
+        jniEnv->NewDirectByteBuffer((void*)scratch, static_cast<long>(n));
+    if (directByteBuffer == nullptr) {
+      return CheckThenError(
+          std::string("Exception when NewDirectByteBuffer in Read, path: ")
+              .append(file_path_));
+    }
+    jobject inputStream;
+    IOStatus leaseStatus = LeaseInputStream(&inputStream);
+    if (!leaseStatus.ok()) {
+      jniEnv->DeleteLocalRef(directByteBuffer);
+      return leaseStatus;
+    }
+    uint64_t elapsedMicros = 0;
+
+    const JavaClassCache::JavaMethodContext& readMethod =
+        class_cache_->GetJMethod(
+            JavaClassCache::JM_FLINK_FS_INPUT_STREAM_RANDOM_READ);
+    jint totalBytesRead;
+    {
+      StopWatch sw(SystemClock::Default().get(), statistics_,
+                   FLINK_FS_READ_MICROS, Histograms::HISTOGRAM_ENUM_MAX,
+                   readahead_policy_ != nullptr ? &elapsedMicros : nullptr);
+      totalBytesRead = jniEnv->CallIntMethod(
+          inputStream, readMethod.javaMethod, offset, directByteBuffer);
+    }
+    jniEnv->DeleteLocalRef(directByteBuffer);
+
+    ReturnInputStream(inputStream);
+
+    IOStatus status = CurrentStatus([this]() {
+      return std::string("Exception when Reading file, path: ")
+          .append(file_path_);
     });
+    if (!status.ok()) {
+      return status;
+    }
+
+    *bytesRead = totalBytesRead == -1 ? 0 : totalBytesRead;
+    RecordReadBytes(*bytesRead);
+    if (readahead_policy_ != nullptr) {
+      readahead_policy_->RecordRead(n, elapsedMicros);
+    }
+    return IOStatus::OK();
+  }
+
+  // REQUIRES: prefetch_mutex_ held
+  std::deque<PrefetchBuffer>::iterator FindPrefetchBuffer(uint64_t offset,
+                                                          size_t n) const {
+    prefetch_mutex_.AssertHeld();
+    return std::find_if(
+        prefetch_buffers_.begin(), prefetch_buffers_.end(),
+        [offset, n](const PrefetchBuffer& buffer) {
+          uint64_t end = buffer.offset + buffer.len;
+          return offset >= buffer.offset &&
+                 (offset + n <= end || (buffer.eof && offset <= end));
+        });
+  }
+
+  // Releases the buffers that end at or before offset, which the scan
+  // prefetching from offset has passed.
+  // REQUIRES: prefetch_mutex_ held
+  void ReleasePrefetchBuffersBefore(uint64_t offset) const {
+    prefetch_mutex_.AssertHeld();
+    for (auto it = prefetch_buffers_.begin(); it != prefetch_buffers_.end();) {
+      if (it->offset + it->len <= offset) {
+        readahead_policy_->ReleaseMemory(it->capacity);
+        it = prefetch_buffers_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  bool ReadFromPrefetchBuffers(uint64_t offset, size_t n, Slice* result,
+                               char* scratch) const {
+    MutexLock lock(&prefetch_mutex_);
+    auto it = FindPrefetchBuffer(offset, n);
+    if (it == prefetch_buffers_.end()) {
+      return false;
+    }
+    size_t len = static_cast<size_t>(
+        std::min<uint64_t>(n, it->offset + it->len - offset));
+    memcpy(scratch, it->data.get() + (offset - it->offset), len);
+    *result = Slice(scratch, len);
+    it->consumed += len;
+    // A scan reading to the end of a range continues with the next one
+    if (it->consumed >= it->len ||
+        (!it->eof && offset + len >= it->offset + it->len)) {
+      readahead_policy_->ReleaseMemory(it->capacity);
+      prefetch_buffers_.erase(it);
+      return true;
+    }
+    // Keep the most recently used buffer at the back
+    if (std::next(it) != prefetch_buffers_.end()) {
+      PrefetchBuffer buffer = std::move(*it);
+      prefetch_buffers_.erase(it);
+      prefetch_buffers_.push_back(std::move(buffer));
+    }
+    return true;
+  }
+
+  IOStatus GetRemoteFileSize(uint64_t* fileSize) {
+    {
+      MutexLock lock(&prefetch_mutex_);
+      if (file_size_known_) {
+        *fileSize = file_size_;
+        return IOStatus::OK();
+      }
+    }
+    IOStatus status = get_file_size_(fileSize);
+    if (status.ok()) {
+      MutexLock lock(&prefetch_mutex_);
+      file_size_ = *fileSize;
+      file_size_known_ = true;
+    }
+    return status;
+  }
+
+  // Requests whose gap to the previous one is not larger than this are read
+  // together, trading a few wasted bytes for one less remote round-trip.
+  static constexpr size_t kMultiReadCoalesceGap = 64 * 1024;
+
+  // Requests are not coalesced into a range longer than this, which bounds
+  // the buffer a range of several requests is read into.
+  static constexpr size_t kMultiReadMaxCoalescedLen = 4 << 20;
+
+  // A contiguous range of the file covering one or more FSReadRequests.
+  struct CoalescedRange {
+    uint64_t offset;
+    size_t len;
+    std::vector<size_t> req_indexes;
+  };
+
+  static IOStatus CoalesceReadRequests(FSReadRequest* reqs, size_t num_reqs,
+                                       std::vector<CoalescedRange>* ranges) {
+    std::vector<size_t> sortedIndexes(num_reqs);
+    for (size_t i = 0; i < num_reqs; i++) {
+      if (reqs[i].len > static_cast<size_t>(INT_MAX)) {
+        return IOStatus::IOError(
+            std::string("Read too big data to file, data size: ")
+                .append(std::to_string(reqs[i].len)));
+      }
+      sortedIndexes[i] = i;
+    }
+    std::sort(sortedIndexes.begin(), sortedIndexes.end(),
+              [reqs](size_t a, size_t b) {
+                return reqs[a].offset < reqs[b].offset;
+              });
+
+    for (size_t reqIdx : sortedIndexes) {
+      const FSReadRequest& req = reqs[reqIdx];
+      if (!ranges->empty()) {
+        CoalescedRange& last = ranges->back();
+        uint64_t lastEnd = last.offset + last.len;
+        uint64_t newEnd = std::max(lastEnd, req.offset + req.len);
+        if (req.offset <= lastEnd + kMultiReadCoalesceGap &&
+            newEnd - last.offset <= kMultiReadMaxCoalescedLen) {
+          last.len = static_cast<size_t>(newEnd - last.offset);
+          last.req_indexes.push_back(reqIdx);
+          continue;
+        }
+      }
+      ranges->push_back({req.offset, req.len, {reqIdx}});
+    }
+    return IOStatus::OK();
   }
 };
 
 // Simple implementation of FSDirectory, Shouldn't influence the normal usage
 class FlinkDirectory : public FSDirectory {
  public:
-  explicit FlinkDirectory() = default;
+  explicit FlinkDirectory(FlinkFileSystem* file_system)
+      : file_system_(file_system) {}
   ~FlinkDirectory() override = default;
 
   IOStatus Fsync(const IOOptions& /*options*/,
                  IODebugContext* /*dbg*/) override {
-    // TODO: Syncing directory is managed by specific flink file system
-    // currently, consider to implement in the future
+    // Batched deletes of obsolete files piggyback on the next sync, failures
+    // just leave the obsolete files which are purged again later
+    file_system_->FlushPendingDeletes().PermitUncheckedError();
+    // Syncing directory is managed by specific flink file system. Flushes and
+    // compactions sync the directory of their output files before installing
+    // them, so the staged files are made durable here.
+    return file_system_->WaitForUploads();
+  }
+
+ private:
+  FlinkFileSystem* file_system_;
+};
+
+// Writes a new file to the local staging directory, and schedules its upload
+// by the uploader once closed. The file is served from the local copy until
+// uploaded, and the upload is waited for by the next directory Fsync(). The
+// local file is deleted on restart anyway, so syncing it is useless.
+class FlinkStagingWritableFile : public FSWritableFileOwnerWrapper {
+ public:
+  FlinkStagingWritableFile(FileSystem* local_fs,
+                           FlinkFileUploader* file_uploader,
+                           const std::string& fname,
+                           const std::string& local_path,
+                           std::unique_ptr<FSWritableFile>&& local_file)
+      : FSWritableFileOwnerWrapper(std::move(local_file)),
+        local_fs_(local_fs),
+        file_uploader_(file_uploader),
+        fname_(fname),
+        local_path_(local_path),
+        closed_(false) {}
+
+  ~FlinkStagingWritableFile() override {
+    if (!closed_) {
+      // Not closed by the caller, the content may be incomplete
+      target()->Close(IOOptions(), nullptr).PermitUncheckedError();
+      local_fs_->DeleteFile(local_path_, IOOptions(), nullptr)
+          .PermitUncheckedError();
+    }
+  }
+
+  IOStatus Sync(const IOOptions& /*options*/,
+                IODebugContext* /*dbg*/) override {
+    return IOStatus::OK();
+  }
+
+  IOStatus Fsync(const IOOptions& /*options*/,
+                 IODebugContext* /*dbg*/) override {
     return IOStatus::OK();
   }
+
+  IOStatus RangeSync(uint64_t /*offset*/, uint64_t /*nbytes*/,
+                     const IOOptions& /*options*/,
+                     IODebugContext* /*dbg*/) override {
+    return IOStatus::OK();
+  }
+
+  IOStatus Close(const IOOptions& options, IODebugContext* dbg) override {
+    if (closed_) {
+      return IOStatus::OK();
+    }
+    uint64_t fileSize = target()->GetFileSize(options, dbg);
+    IOStatus status = target()->Close(options, dbg);
+    if (!status.ok()) {
+      return status;
+    }
+    closed_ = true;
+    file_uploader_->Schedule(fname_, local_path_, fileSize);
+    return IOStatus::OK();
+  }
+
+ private:
+  FileSystem* local_fs_;
+  FlinkFileUploader* file_uploader_;
+  const std::string fname_;
+  const std::string local_path_;
+  bool closed_;
 };
 
+// Staged files are immutable once closed, which are SST files only.
+static bool ShouldStage(const std::string& fname) {
+  return FlinkFileCache::ShouldCache(fname);
+}
+
 FlinkFileSystem::FlinkFileSystem(const std::shared_ptr<FileSystem>& base_fs,
                                  const std::string& base_path,
-                                 jobject file_system_instance)
-    : FileSystemWrapper(base_fs), base_path_(TrimTrailingSlash(base_path)) {
+                                 jobject file_system_instance,
+                                 const FlinkFileSystemOptions& options)
+    : FileSystemWrapper(base_fs),
+      base_path_(TrimTrailingSlash(base_path)),
+      options_(options),
+      class_cache_(nullptr) {
   if (file_system_instance != nullptr) {
     JNIEnv* env = getJNIEnv();
     file_system_instance_ = env->NewGlobalRef(file_system_instance);
@@ -323,6 +1058,11 @@ FlinkFileSystem::FlinkFileSystem(const std::shared_ptr<FileSystem>& base_fs,
 }
 
 FlinkFileSystem::~FlinkFileSystem() {
+  // Pending uploads and deletes still call into Java
+  file_uploader_.reset();
+  if (class_cache_ != nullptr) {
+    FlushPendingDeletes().PermitUncheckedError();
+  }
   if (file_system_instance_ != nullptr) {
     JNIEnv* env = getJNIEnv();
     env->DeleteGlobalRef(file_system_instance_);
@@ -342,9 +1082,9 @@ Status FlinkFileSystem::Init() {
   if (file_system_instance_ == nullptr) {
     // Delegate Flink to load real FileSystem (e.g.
     // S3FileSystem/OSSFileSystem/...)
-    JavaClassCache::JavaClassContext fileSystemClass =
+    const JavaClassCache::JavaClassContext& fileSystemClass =
         class_cache_->GetJClass(JavaClassCache::JC_FLINK_FILE_SYSTEM);
-    JavaClassCache::JavaMethodContext fileSystemGetMethod =
+    const JavaClassCache::JavaMethodContext& fileSystemGetMethod =
         class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_SYSTEM_GET);
 
     jstring uriStringArg = jniEnv->NewStringUTF(base_path_.c_str());
@@ -377,9 +1117,102 @@ Status FlinkFileSystem::Init() {
     return CheckThenError(
         std::string("Error when init flink env, JNI throws exception."));
   }
+
+  if (!options_.local_cache_dir.empty()) {
+    status = FlinkFileCache::Create(target_, options_.local_cache_dir,
+                                    options_.local_cache_capacity,
+                                    &file_cache_);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+
+  if (options_.cache_file_status) {
+    file_status_cache_.reset(new FlinkFileStatusCache());
+  }
+
+  if (options_.remote_readahead) {
+    readahead_policy_.reset(new FlinkReadaheadPolicy(
+        options_.min_readahead_size, options_.max_readahead_size,
+        options_.max_readahead_memory));
+  }
+
+  if (!options_.local_staging_dir.empty()) {
+    IOStatus s = target_->CreateDirIfMissing(options_.local_staging_dir,
+                                             IOOptions(), nullptr);
+    // Files left by a previous process were never referred to, as a file is
+    // only referred to after uploaded
+    std::vector<std::string> children;
+    if (s.ok()) {
+      s = target_->GetChildren(options_.local_staging_dir, IOOptions(),
+                               &children, nullptr);
+    }
+    for (size_t i = 0; s.ok() && i < children.size(); i++) {
+      s = target_->DeleteFile(options_.local_staging_dir + "/" + children[i],
+                              IOOptions(), nullptr);
+    }
+    if (!s.ok()) {
+      return s;
+    }
+    file_uploader_.reset(new FlinkFileUploader(
+        options_.max_background_uploads,
+        [this](const std::string& fname, const std::string& localPath) {
+          return UploadFile(fname, localPath);
+        },
+        [this](const std::string& fname, const std::string& localPath,
+               uint64_t size, const IOStatus& uploadStatus) {
+          FinishUpload(fname, localPath, size, uploadStatus);
+        }));
+  }
   return Status::OK();
 }
 
+IOStatus FlinkFileSystem::UploadFile(const std::string& fname,
+                                     const std::string& local_path) {
+  std::unique_ptr<FSSequentialFile> localFile;
+  IOStatus status = target_->NewSequentialFile(local_path, FileOptions(),
+                                               &localFile, nullptr);
+  if (!status.ok()) {
+    return status;
+  }
+  FlinkWritableFile remoteFile(file_system_instance_, class_cache_,
+                               file_status_cache_.get(),
+                               options_.statistics.get(), ConstructPath(fname),
+                               FileOptions());
+  status = remoteFile.Init();
+
+  const size_t kCopyBufferSize = 1024 * 1024;
+  std::unique_ptr<char[]> buffer(new char[kCopyBufferSize]);
+  while (status.ok()) {
+    Slice data;
+    status = localFile->Read(kCopyBufferSize, IOOptions(), &data, buffer.get(),
+                             nullptr);
+    if (!status.ok() || data.empty()) {
+      break;
+    }
+    status = remoteFile.Append(data, IOOptions(), nullptr);
+  }
+  if (status.ok()) {
+    status = remoteFile.Sync(IOOptions(), nullptr);
+  }
+  if (status.ok()) {
+    status = remoteFile.Close(IOOptions(), nullptr);
+  }
+  return status;
+}
+
+void FlinkFileSystem::FinishUpload(const std::string& fname,
+                                   const std::string& local_path,
+                                   uint64_t size, const IOStatus& status) {
+  if (status.ok() && file_cache_ != nullptr) {
+    // The local file is exactly the remote one, keep it in the cache instead
+    // of downloading it again on the next open
+    file_cache_->InsertLocalFile(fname, local_path, size);
+    return;
+  }
+  target_->DeleteFile(local_path, IOOptions(), nullptr).PermitUncheckedError();
+}
+
 std::string FlinkFileSystem::ConstructPath(const std::string& fname) {
   return fname.at(0) == '/' ? base_path_ + fname : base_path_ + "/" + fname;
 }
@@ -389,13 +1222,22 @@ IOStatus FlinkFileSystem::NewSequentialFile(
     const std::string& fname, const FileOptions& options,
     std::unique_ptr<FSSequentialFile>* result, IODebugContext* dbg) {
   result->reset();
+  std::string localPath;
+  uint64_t fileSize;
+  if (file_uploader_ != nullptr &&
+      file_uploader_->GetPending(fname, &localPath, &fileSize) &&
+      target_->NewSequentialFile(localPath, options, result, dbg).ok()) {
+    return IOStatus::OK();
+  }
+
   IOStatus status = FileExists(fname, options.io_options, dbg);
   if (!status.ok()) {
     return status;
   }
 
   auto f = new FlinkReadableFile(file_system_instance_, class_cache_,
-                                 ConstructPath(fname));
+                                 ConstructPath(fname), 1,
+                                 options_.statistics.get());
   IOStatus valid = f->Init();
   if (!valid.ok()) {
     delete f;
@@ -410,34 +1252,100 @@ IOStatus FlinkFileSystem::NewRandomAccessFile(
     const std::string& fname, const FileOptions& options,
     std::unique_ptr<FSRandomAccessFile>* result, IODebugContext* dbg) {
   result->reset();
+  // Being uploaded, the local file is removed only after the upload is done,
+  // so a failure to open it means the remote file is ready
+  std::string localPath;
+  uint64_t localFileSize;
+  if (file_uploader_ != nullptr &&
+      file_uploader_->GetPending(fname, &localPath, &localFileSize) &&
+      target_->NewRandomAccessFile(localPath, options, result, dbg).ok()) {
+    return IOStatus::OK();
+  }
+
+  bool useFileCache =
+      file_cache_ != nullptr && FlinkFileCache::ShouldCache(fname);
+  if (useFileCache &&
+      file_cache_->NewRandomAccessFile(fname, options, result, dbg).ok()) {
+    return IOStatus::OK();
+  }
+
   IOStatus status = FileExists(fname, options.io_options, dbg);
   if (!status.ok()) {
     return status;
   }
 
-  auto f = new FlinkReadableFile(file_system_instance_, class_cache_,
-                                 ConstructPath(fname));
+  auto f = new FlinkReadableFile(
+      file_system_instance_, class_cache_, ConstructPath(fname),
+      options_.max_input_streams_per_file, options_.statistics.get(),
+      readahead_policy_.get(),
+      options_.max_whole_file_prefetch_size,
+      [this, fname](uint64_t* fileSize) {
+        return GetFileSize(fname, IOOptions(), fileSize, nullptr);
+      });
   IOStatus valid = f->Init();
   if (!valid.ok()) {
     delete f;
     return valid;
   }
-  result->reset(f);
+  std::unique_ptr<FSRandomAccessFile> remoteFile(f);
+
+  // The whole file is downloaded once since an SST opened for random reads is
+  // expected to be read many times. It blocks the opening thread, so larger
+  // files or those that can't be cached are served from the remote file.
+  uint64_t fileSize;
+  if (useFileCache &&
+      GetFileSize(fname, options.io_options, &fileSize, dbg).ok() &&
+      (options_.max_cache_on_open_size == 0 ||
+       fileSize <= options_.max_cache_on_open_size) &&
+      file_cache_
+          ->Insert(fname, remoteFile.get(), fileSize, options.io_options, dbg)
+          .ok() &&
+      file_cache_->NewRandomAccessFile(fname, options, result, dbg).ok()) {
+    return IOStatus::OK();
+  }
+  *result = std::move(remoteFile);
   return IOStatus::OK();
 }
 
 // create a new file for writing
 IOStatus FlinkFileSystem::NewWritableFile(
     const std::string& fname, const FileOptions& options,
-    std::unique_ptr<FSWritableFile>* result, IODebugContext* /*dbg*/) {
+    std::unique_ptr<FSWritableFile>* result, IODebugContext* dbg) {
   result->reset();
-  auto f = new FlinkWritableFile(file_system_instance_, class_cache_,
-                                 ConstructPath(fname), options);
+  if (file_uploader_ != nullptr && ShouldStage(fname)) {
+    // A file being rewritten must not be overwritten by its pending upload,
+    // nor be confused with a previous failed upload
+    file_uploader_->Wait(fname).PermitUncheckedError();
+    file_uploader_->Cancel(fname);
+    std::string localName = FlinkFileCache::LocalFileName(fname);
+    std::string localPath = options_.local_staging_dir + "/" + localName;
+    std::unique_ptr<FSWritableFile> localFile;
+    IOStatus status =
+        target_->NewWritableFile(localPath, options, &localFile, dbg);
+    if (!status.ok()) {
+      return status;
+    }
+    result->reset(new FlinkStagingWritableFile(target(), file_uploader_.get(),
+                                               fname, localPath,
+                                               std::move(localFile)));
+    return IOStatus::OK();
+  }
+
+  auto f = new FlinkWritableFile(
+      file_system_instance_, class_cache_, file_status_cache_.get(),
+      options_.statistics.get(), ConstructPath(fname), options);
   IOStatus valid = f->Init();
   if (!valid.ok()) {
     delete f;
     return valid;
   }
+  if (file_cache_ != nullptr && FlinkFileCache::ShouldCache(fname)) {
+    // Write a local copy at the same time to warm up the cache
+    file_cache_->NewWritableFile(fname, options,
+                                 std::unique_ptr<FSWritableFile>(f), result,
+                                 dbg);
+    return IOStatus::OK();
+  }
   result->reset(f);
   return IOStatus::OK();
 }
@@ -449,26 +1357,60 @@ IOStatus FlinkFileSystem::NewDirectory(const std::string& name,
   result->reset();
   IOStatus s = FileExists(name, options, dbg);
   if (s.ok()) {
-    result->reset(new FlinkDirectory());
+    result->reset(new FlinkDirectory(this));
   }
   return s;
 }
 
+IOStatus FlinkFileSystem::WaitForUploads() {
+  if (file_uploader_ == nullptr) {
+    return IOStatus::OK();
+  }
+  return file_uploader_->WaitAll();
+}
+
 IOStatus FlinkFileSystem::FileExists(const std::string& file_name,
                                      const IOOptions& /*options*/,
                                      IODebugContext* /*dbg*/) {
+  std::string localPath;
+  uint64_t localFileSize;
+  if (file_uploader_ != nullptr &&
+      file_uploader_->GetPending(file_name, &localPath, &localFileSize)) {
+    return IOStatus::OK();
+  }
+
   std::string filePath = ConstructPath(file_name);
+  if (IsPendingDelete(filePath)) {
+    return IOStatus::NotFound();
+  }
+  FlinkFileStatusCache::FileStatus cachedStatus;
+  auto lookupResult =
+      file_status_cache_ != nullptr
+          ? file_status_cache_->Lookup(TrimTrailingSlash(filePath),
+                                       &cachedStatus)
+          : FlinkFileStatusCache::LookupResult::kUnknown;
+  if (lookupResult == FlinkFileStatusCache::LookupResult::kNotFound) {
+    return IOStatus::NotFound();
+  } else if (lookupResult != FlinkFileStatusCache::LookupResult::kUnknown) {
+    return IOStatus::OK();
+  }
+
   JNIEnv* jniEnv = getJNIEnv();
   jstring pathString = jniEnv->NewStringUTF(filePath.c_str());
 
   // Call exist method
-  JavaClassCache::JavaMethodContext existsMethod =
+  const JavaClassCache::JavaMethodContext& existsMethod =
       class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_SYSTEM_EXISTS);
-  jboolean exists = jniEnv->CallBooleanMethod(
-      file_system_instance_, existsMethod.javaMethod, pathString);
+  jboolean exists;
+  {
+    StopWatch sw(SystemClock::Default().get(), options_.statistics.get(),
+                 FLINK_FS_EXISTS_MICROS);
+    exists = jniEnv->CallBooleanMethod(
+        file_system_instance_, existsMethod.javaMethod, pathString);
+  }
   jniEnv->DeleteLocalRef(pathString);
 
-  IOStatus status = CurrentStatus([filePath]() {
+  IOStatus status = CurrentStatus([&filePath]() {
     return std::string("Exception when FileExists, path: ").append(filePath);
   });
   if (!status.ok()) {
@@ -483,6 +1425,9 @@ IOStatus FlinkFileSystem::GetChildren(const std::string& file_name,
                                       const IOOptions& options,
                                       std::vector<std::string>* result,
                                       IODebugContext* dbg) {
+  // Deleted files are expected to be gone from the listing
+  FlushPendingDeletes().PermitUncheckedError();
+
   IOStatus fileExistsStatus = FileExists(file_name, options, dbg);
   if (!fileExistsStatus.ok()) {
     return fileExistsStatus.IsNotFound()
@@ -493,14 +1438,24 @@ IOStatus FlinkFileSystem::GetChildren(const std::string& file_name,
   }
 
   std::string filePath = ConstructPath(file_name);
+  std::string dirKey = TrimTrailingSlash(filePath);
+  uint64_t dirVersion = file_status_cache_ != nullptr
+                            ? file_status_cache_->GetDirVersion(dirKey)
+                            : 0;
   JNIEnv* jniEnv = getJNIEnv();
   jstring pathString = jniEnv->NewStringUTF(filePath.c_str());
 
-  JavaClassCache::JavaMethodContext listStatusMethod = class_cache_->GetJMethod(
-      JavaClassCache::JM_FLINK_FILE_SYSTEM_LIST_STATUS);
-
-  auto fileStatusArray = (jobjectArray)jniEnv->CallObjectMethod(
-      file_system_instance_, listStatusMethod.javaMethod, pathString);
+  const JavaClassCache::JavaMethodContext& listStatusMethod =
+      class_cache_->GetJMethod(
+          JavaClassCache::JM_FLINK_FILE_SYSTEM_LIST_STATUS);
+
+  jobjectArray fileStatusArray;
+  {
+    StopWatch sw(SystemClock::Default().get(), options_.statistics.get(),
+                 FLINK_FS_LIST_MICROS);
+    fileStatusArray = (jobjectArray)jniEnv->CallObjectMethod(
+        file_system_instance_, listStatusMethod.javaMethod, pathString);
+  }
   jniEnv->DeleteLocalRef(pathString);
   if (fileStatusArray == nullptr || jniEnv->ExceptionCheck()) {
     return CheckThenError(
@@ -511,34 +1466,58 @@ IOStatus FlinkFileSystem::GetChildren(const std::string& file_name,
             .append(")"));
   }
 
+  std::vector<std::pair<std::string, FlinkFileStatusCache::FileStatus>>
+      childStatuses;
+  const JavaClassCache::JavaMethodContext& getPathMethod =
+      class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_STATUS_GET_PATH);
   jsize fileStatusArrayLen = jniEnv->GetArrayLength(fileStatusArray);
   for (jsize i = 0; i < fileStatusArrayLen; i++) {
+    // Local refs of each child are released together by popping the frame,
+    // also on errors, instead of deleting them one by one
+    if (jniEnv->PushLocalFrame(2) != 0) {
+      jniEnv->DeleteLocalRef(fileStatusArray);
+      return CheckThenError("Exception when PushLocalFrame in GetChildren");
+    }
     jobject fileStatusObj = jniEnv->GetObjectArrayElement(fileStatusArray, i);
     if (fileStatusObj == nullptr || jniEnv->ExceptionCheck()) {
+      jniEnv->PopLocalFrame(nullptr);
       jniEnv->DeleteLocalRef(fileStatusArray);
       return CheckThenError(
           "Exception when GetObjectArrayElement in GetChildren");
     }
 
-    JavaClassCache::JavaMethodContext getPathMethod =
-        class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_STATUS_GET_PATH);
     auto subPathStr = (jstring)jniEnv->CallObjectMethod(
         fileStatusObj, getPathMethod.javaMethod);
-    jniEnv->DeleteLocalRef(fileStatusObj);
     if (subPathStr == nullptr || jniEnv->ExceptionCheck()) {
+      jniEnv->PopLocalFrame(nullptr);
       jniEnv->DeleteLocalRef(fileStatusArray);
       return CheckThenError(
           std::string("Exception when CallObjectMethod in GetChildren, ")
               .append(getPathMethod.ToString()));
     }
-
-    const char* str = jniEnv->GetStringUTFChars(subPathStr, nullptr);
-    result->emplace_back(str);
-    jniEnv->ReleaseStringUTFChars(subPathStr, str);
-    jniEnv->DeleteLocalRef(subPathStr);
+    result->emplace_back(parseJavaString(jniEnv, subPathStr));
+
+    // The listing carries the statuses of all children, so the following
+    // metadata calls on them don't need to go to the remote file system
+    if (file_status_cache_ != nullptr) {
+      FlinkFileStatusCache::FileStatus childStatus;
+      IOStatus status = ReadFileStatus(fileStatusObj, &childStatus);
+      if (!status.ok()) {
+        jniEnv->PopLocalFrame(nullptr);
+        jniEnv->DeleteLocalRef(fileStatusArray);
+        return status;
+      }
+      std::string childName = TrimTrailingSlash(result->back());
+      childName = childName.substr(childName.find_last_of('/') + 1);
+      childStatuses.emplace_back(dirKey + "/" + childName, childStatus);
+    }
+    jniEnv->PopLocalFrame(nullptr);
   }
 
   jniEnv->DeleteLocalRef(fileStatusArray);
+  if (file_status_cache_ != nullptr) {
+    file_status_cache_->AddChildren(dirKey, dirVersion, childStatuses);
+  }
   return IOStatus::OK();
 }
 
@@ -551,45 +1530,255 @@ IOStatus FlinkFileSystem::DeleteDir(const std::string& file_name,
 IOStatus FlinkFileSystem::DeleteFile(const std::string& file_name,
                                      const IOOptions& options,
                                      IODebugContext* dbg) {
+  if (file_uploader_ != nullptr) {
+    if (file_uploader_->Cancel(file_name)) {
+      // Never uploaded
+      return IOStatus::OK();
+    }
+    if (!file_uploader_->Wait(file_name).ok()) {
+      // Drops the local file of the failed upload, and the remote file it may
+      // have partially written
+      file_uploader_->Cancel(file_name);
+    }
+  }
+  if (file_cache_ != nullptr) {
+    file_cache_->Erase(file_name);
+  }
+  if (options_.delete_batch_size > 1 && ShouldBatchDelete(file_name)) {
+    // A file is not queried before queued, which would cost the remote call
+    // saved by batching. It's only reported missing if known to be, e.g.
+    // deleted already but still pending.
+    std::string filePath = ConstructPath(file_name);
+    FlinkFileStatusCache::FileStatus cachedStatus;
+    if (IsPendingDelete(filePath) ||
+        (file_status_cache_ != nullptr &&
+         file_status_cache_->Lookup(TrimTrailingSlash(filePath),
+                                    &cachedStatus) ==
+             FlinkFileStatusCache::LookupResult::kNotFound)) {
+      return IOStatus::PathNotFound(
+          std::string("Could not find path when Delete, path: ")
+              .append(filePath));
+    }
+    size_t numPendingDeletes;
+    {
+      MutexLock lock(&pending_deletes_mutex_);
+      pending_deletes_.push_back(filePath);
+      numPendingDeletes = pending_deletes_.size();
+    }
+    return numPendingDeletes >= options_.delete_batch_size
+               ? FlushPendingDeletes()
+               : IOStatus::OK();
+  }
   return Delete(file_name, options, dbg, false);
 }
 
 IOStatus FlinkFileSystem::Delete(const std::string& file_name,
                                  const IOOptions& options, IODebugContext* dbg,
                                  bool recursive) {
-  IOStatus fileExistsStatus = FileExists(file_name, options, dbg);
-  if (!fileExistsStatus.ok()) {
-    return fileExistsStatus.IsNotFound()
-               ? IOStatus::PathNotFound(
-                     std::string("Could not find path when Delete, path: ")
-                         .append(ConstructPath(file_name)))
-               : fileExistsStatus;
-  }
   JNIEnv* jniEnv = getJNIEnv();
 
   std::string filePath = ConstructPath(file_name);
   jstring pathString = jniEnv->NewStringUTF(filePath.c_str());
 
-  // Call delete method
-  JavaClassCache::JavaMethodContext deleteMethod =
+  // Call delete method, which returns false if the path doesn't exist, so
+  // the existence is only checked on failures
+  const JavaClassCache::JavaMethodContext& deleteMethod =
       class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_SYSTEM_DELETE);
-  jboolean deleted = jniEnv->CallBooleanMethod(
-      file_system_instance_, deleteMethod.javaMethod, pathString, recursive);
+  jboolean deleted;
+  {
+    StopWatch sw(SystemClock::Default().get(), options_.statistics.get(),
+                 FLINK_FS_DELETE_MICROS);
+    deleted = jniEnv->CallBooleanMethod(
+        file_system_instance_, deleteMethod.javaMethod, pathString, recursive);
+  }
   jniEnv->DeleteLocalRef(pathString);
 
-  IOStatus status = CurrentStatus([filePath]() {
+  if (file_status_cache_ != nullptr) {
+    if (recursive) {
+      file_status_cache_->InvalidateDir(TrimTrailingSlash(filePath));
+    } else if (deleted && !jniEnv->ExceptionCheck()) {
+      file_status_cache_->Remove(TrimTrailingSlash(filePath));
+    } else {
+      file_status_cache_->Invalidate(TrimTrailingSlash(filePath));
+    }
+  }
+
+  IOStatus status = CurrentStatus([&filePath]() {
     return std::string("Exception when Delete, path: ").append(filePath);
   });
   if (!status.ok()) {
     return status;
   }
+  if (deleted) {
+    return IOStatus::OK();
+  }
 
-  return deleted
-             ? IOStatus::OK()
+  IOStatus fileExistsStatus = FileExists(file_name, options, dbg);
+  if (fileExistsStatus.IsNotFound()) {
+    return IOStatus::PathNotFound(
+        std::string("Could not find path when Delete, path: ")
+            .append(filePath));
+  }
+  return !fileExistsStatus.ok()
+             ? fileExistsStatus
              : IOStatus::IOError(std::string("Exception when Delete, path: ")
                                      .append(filePath));
 }
 
+bool FlinkFileSystem::ShouldBatchDelete(const std::string& file_name) {
+  // Table and blob file numbers are never reused, so their deletion can be
+  // delayed without affecting new files
+  return Slice(file_name).ends_with(".sst") ||
+         Slice(file_name).ends_with(".blob");
+}
+
+bool FlinkFileSystem::IsPendingDelete(const std::string& file_path) {
+  MutexLock lock(&pending_deletes_mutex_);
+  return std::find(pending_deletes_.begin(), pending_deletes_.end(),
+                   file_path) != pending_deletes_.end();
+}
+
+IOStatus FlinkFileSystem::FlushPendingDeletes() {
+  // Files stay pending until deleted or found missing, so they are not
+  // visible meanwhile, and the failed ones are retried by the next flush.
+  // Flushes are serialized, and new files are only appended to the end.
+  MutexLock flushLock(&flush_deletes_mutex_);
+  std::vector<std::string> filePaths;
+  {
+    MutexLock lock(&pending_deletes_mutex_);
+    filePaths = pending_deletes_;
+  }
+  if (filePaths.empty()) {
+    return IOStatus::OK();
+  }
+
+  std::vector<IOStatus> results;
+  DeleteRemoteFiles(filePaths, &results);
+  IOStatus status;
+  std::vector<std::string> failedPaths;
+  for (size_t i = 0; i < filePaths.size(); i++) {
+    if (results[i].ok() || results[i].IsPathNotFound()) {
+      results[i].PermitUncheckedError();
+      continue;
+    }
+    failedPaths.push_back(filePaths[i]);
+    if (status.ok()) {
+      status = results[i];
+    } else {
+      results[i].PermitUncheckedError();
+    }
+  }
+  {
+    MutexLock lock(&pending_deletes_mutex_);
+    pending_deletes_.erase(pending_deletes_.begin(),
+                           pending_deletes_.begin() + filePaths.size());
+    pending_deletes_.insert(pending_deletes_.begin(), failedPaths.begin(),
+                            failedPaths.end());
+  }
+  return status;
+}
+
+void FlinkFileSystem::DeleteRemoteFiles(
+    const std::vector<std::string>& file_paths,
+    std::vector<IOStatus>* results) {
+  results->assign(file_paths.size(), IOStatus::OK());
+  auto notFound = [](const std::string& filePath) {
+    return IOStatus::PathNotFound(
+        std::string("Could not find path when Delete, path: ")
+            .append(filePath));
+  };
+  JNIEnv* jniEnv = getJNIEnv();
+  const JavaClassCache::JavaMethodContext& deleteFilesMethod =
+      class_cache_->GetJMethod(
+          JavaClassCache::JM_FLINK_FILE_SYSTEM_DELETE_FILES);
+  if (deleteFilesMethod.javaMethod != nullptr) {
+    // Delete all the files by one call, which is a bulk request on object
+    // stores, and returns whether each file existed
+    const JavaClassCache::JavaClassContext& stringClass =
+        class_cache_->GetJClass(JavaClassCache::JC_STRING);
+    jobjectArray pathArray = jniEnv->NewObjectArray(
+        static_cast<jsize>(file_paths.size()), stringClass.javaClass, nullptr);
+    if (pathArray == nullptr) {
+      results->assign(
+          file_paths.size(),
+          CheckThenError("Exception when NewObjectArray in DeleteFiles"));
+      return;
+    }
+    for (size_t i = 0; i < file_paths.size(); i++) {
+      jstring pathString = jniEnv->NewStringUTF(file_paths[i].c_str());
+      jniEnv->SetObjectArrayElement(pathArray, static_cast<jsize>(i),
+                                    pathString);
+      jniEnv->DeleteLocalRef(pathString);
+    }
+    jbooleanArray deletedArray;
+    {
+      StopWatch sw(SystemClock::Default().get(), options_.statistics.get(),
+                   FLINK_FS_DELETE_MICROS);
+      deletedArray = static_cast<jbooleanArray>(jniEnv->CallObjectMethod(
+          file_system_instance_, deleteFilesMethod.javaMethod, pathArray));
+    }
+    jniEnv->DeleteLocalRef(pathArray);
+    size_t numFiles = file_paths.size();
+    IOStatus status = CurrentStatus([numFiles]() {
+      return std::string("Exception when DeleteFiles, number of files: ")
+          .append(std::to_string(numFiles));
+    });
+    std::vector<jboolean> deleted(numFiles, JNI_FALSE);
+    if (status.ok() && (deletedArray == nullptr ||
+                        jniEnv->GetArrayLength(deletedArray) !=
+                            static_cast<jsize>(numFiles))) {
+      status = IOStatus::IOError(
+          "Exception when DeleteFiles, unexpected result of deleteFiles");
+    }
+    if (status.ok()) {
+      jniEnv->GetBooleanArrayRegion(deletedArray, 0,
+                                    static_cast<jsize>(numFiles),
+                                    deleted.data());
+    }
+    if (deletedArray != nullptr) {
+      jniEnv->DeleteLocalRef(deletedArray);
+    }
+    for (size_t i = 0; i < numFiles; i++) {
+      if (!status.ok()) {
+        (*results)[i] = status;
+      } else if (!deleted[i]) {
+        (*results)[i] = notFound(file_paths[i]);
+      }
+    }
+  } else {
+    const JavaClassCache::JavaMethodContext& deleteMethod =
+        class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_SYSTEM_DELETE);
+    for (size_t i = 0; i < file_paths.size(); i++) {
+      const std::string& filePath = file_paths[i];
+      jstring pathString = jniEnv->NewStringUTF(filePath.c_str());
+      jboolean deleted;
+      {
+        StopWatch sw(SystemClock::Default().get(), options_.statistics.get(),
+                     FLINK_FS_DELETE_MICROS);
+        deleted = jniEnv->CallBooleanMethod(
+            file_system_instance_, deleteMethod.javaMethod, pathString, false);
+      }
+      jniEnv->DeleteLocalRef(pathString);
+      (*results)[i] = CurrentStatus([&filePath]() {
+        return std::string("Exception when Delete, path: ").append(filePath);
+      });
+      if ((*results)[i].ok() && !deleted) {
+        (*results)[i] = notFound(filePath);
+      }
+    }
+  }
+
+  if (file_status_cache_ != nullptr) {
+    for (size_t i = 0; i < file_paths.size(); i++) {
+      if ((*results)[i].ok() || (*results)[i].IsPathNotFound()) {
+        file_status_cache_->Remove(TrimTrailingSlash(file_paths[i]));
+      } else {
+        file_status_cache_->Invalidate(TrimTrailingSlash(file_paths[i]));
+      }
+    }
+  }
+}
+
 IOStatus FlinkFileSystem::CreateDir(const std::string& file_name,
                                     const IOOptions& options,
                                     IODebugContext* dbg) {
@@ -611,12 +1800,20 @@ IOStatus FlinkFileSystem::CreateDirIfMissing(const std::string& file_name,
   jstring pathString = jniEnv->NewStringUTF(filePath.c_str());
 
   // Call mkdirs method
-  JavaClassCache::JavaMethodContext mkdirMethod =
+  const JavaClassCache::JavaMethodContext& mkdirMethod =
       class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_SYSTEM_MKDIR);
-  jboolean created = jniEnv->CallBooleanMethod(
-      file_system_instance_, mkdirMethod.javaMethod, pathString);
+  jboolean created;
+  {
+    StopWatch sw(SystemClock::Default().get(), options_.statistics.get(),
+                 FLINK_FS_MKDIRS_MICROS);
+    created = jniEnv->CallBooleanMethod(file_system_instance_,
+                                        mkdirMethod.javaMethod, pathString);
+  }
   jniEnv->DeleteLocalRef(pathString);
-  IOStatus status = CurrentStatus([filePath]() {
+  if (file_status_cache_ != nullptr) {
+    file_status_cache_->Invalidate(TrimTrailingSlash(filePath));
+  }
+  IOStatus status = CurrentStatus([&filePath]() {
     return std::string("Exception when CreateDirIfMissing, path: ")
         .append(filePath);
   });
@@ -633,117 +1830,169 @@ IOStatus FlinkFileSystem::CreateDirIfMissing(const std::string& file_name,
 IOStatus FlinkFileSystem::GetFileSize(const std::string& file_name,
                                       const IOOptions& options, uint64_t* size,
                                       IODebugContext* dbg) {
-  JNIEnv* jniEnv = getJNIEnv();
-  jobject fileStatus;
-  IOStatus status = GetFileStatus(file_name, options, dbg, &fileStatus);
-  if (!status.ok()) {
-    return status;
+  std::string localPath;
+  if (file_uploader_ != nullptr &&
+      file_uploader_->GetPending(file_name, &localPath, size)) {
+    return IOStatus::OK();
   }
 
-  JavaClassCache::JavaMethodContext getLenMethod =
-      class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_STATUS_GET_LEN);
-  jlong fileSize = jniEnv->CallLongMethod(fileStatus, getLenMethod.javaMethod);
-  jniEnv->DeleteLocalRef(fileStatus);
-
-  status = CurrentStatus([file_name]() {
-    return std::string("Exception when GetFileSize, file name: ")
-        .append(file_name);
-  });
+  FlinkFileStatusCache::FileStatus fileStatus;
+  IOStatus status = GetFileStatus(file_name, options, dbg, &fileStatus);
   if (!status.ok()) {
     return status;
   }
-
-  *size = fileSize;
+  *size = fileStatus.size;
   return IOStatus::OK();
 }
 
-// The life cycle of fileStatus is maintained by caller.
-IOStatus FlinkFileSystem::GetFileStatus(const std::string& file_name,
-                                        const IOOptions& options,
-                                        IODebugContext* dbg,
-                                        jobject* fileStatus) {
-  IOStatus status = FileExists(file_name, options, dbg);
-  if (!status.ok()) {
-    return status.IsNotFound()
-               ? IOStatus::PathNotFound(
-                     std::string(
-                         "Could not find path when GetFileStatus, path: ")
-                         .append(ConstructPath(file_name)))
-               : status;
+IOStatus FlinkFileSystem::GetFileStatus(
+    const std::string& file_name, const IOOptions& /*options*/,
+    IODebugContext* /*dbg*/, FlinkFileStatusCache::FileStatus* fileStatus) {
+  std::string filePath = ConstructPath(file_name);
+  std::string fileKey = TrimTrailingSlash(filePath);
+  if (IsPendingDelete(filePath)) {
+    return IOStatus::PathNotFound(
+        std::string("Could not find path when GetFileStatus, path: ")
+            .append(filePath));
+  }
+  uint64_t dirVersion = 0;
+  if (file_status_cache_ != nullptr) {
+    auto lookupResult = file_status_cache_->Lookup(fileKey, fileStatus);
+    if (lookupResult == FlinkFileStatusCache::LookupResult::kFound) {
+      return IOStatus::OK();
+    } else if (lookupResult == FlinkFileStatusCache::LookupResult::kNotFound) {
+      return IOStatus::PathNotFound(
+          std::string("Could not find path when GetFileStatus, path: ")
+              .append(filePath));
+    }
+    dirVersion = file_status_cache_->GetDirVersion(
+        FlinkFileStatusCache::ParentDir(fileKey));
   }
 
   JNIEnv* jniEnv = getJNIEnv();
-
-  std::string filePath = ConstructPath(file_name);
   jstring pathString = jniEnv->NewStringUTF(filePath.c_str());
 
-  // Call getFileStatus method
-  JavaClassCache::JavaMethodContext getFileStatusMethod =
+  // Call getFileStatus method, which throws FileNotFoundException if the path
+  // doesn't exist, so the existence isn't checked by another call
+  const JavaClassCache::JavaMethodContext& getFileStatusMethod =
       class_cache_->GetJMethod(
           JavaClassCache::JM_FLINK_FILE_SYSTEM_GET_FILE_STATUS);
-  *fileStatus = jniEnv->CallObjectMethod(
-      file_system_instance_, getFileStatusMethod.javaMethod, pathString);
+  jobject fileStatusObj;
+  {
+    StopWatch sw(SystemClock::Default().get(), options_.statistics.get(),
+                 FLINK_FS_GET_FILE_STATUS_MICROS);
+    fileStatusObj = jniEnv->CallObjectMethod(
+        file_system_instance_, getFileStatusMethod.javaMethod, pathString);
+  }
   jniEnv->DeleteLocalRef(pathString);
 
-  return CurrentStatus([filePath]() {
+  if (jniEnv->ExceptionCheck()) {
+    // Other JNI calls are not allowed with a pending exception
+    jthrowable throwable = jniEnv->ExceptionOccurred();
+    jniEnv->ExceptionClear();
+    const JavaClassCache::JavaClassContext& fileNotFoundClass =
+        class_cache_->GetJClass(JavaClassCache::JC_FILE_NOT_FOUND_EXCEPTION);
+    if (jniEnv->IsInstanceOf(throwable, fileNotFoundClass.javaClass)) {
+      jniEnv->DeleteLocalRef(throwable);
+      return IOStatus::PathNotFound(
+          std::string("Could not find path when GetFileStatus, path: ")
+              .append(filePath));
+    }
+    jniEnv->Throw(throwable);
+    jniEnv->DeleteLocalRef(throwable);
+  }
+  IOStatus status = CurrentStatus([&filePath]() {
     return std::string("Exception when GetFileStatus, path: ").append(filePath);
   });
-}
-
-IOStatus FlinkFileSystem::GetFileModificationTime(const std::string& file_name,
-                                                  const IOOptions& options,
-                                                  uint64_t* time,
-                                                  IODebugContext* dbg) {
-  JNIEnv* jniEnv = getJNIEnv();
-  jobject fileStatus;
-  IOStatus status = GetFileStatus(file_name, options, dbg, &fileStatus);
   if (!status.ok()) {
     return status;
   }
+  if (fileStatusObj == nullptr) {
+    return IOStatus::PathNotFound(
+        std::string("Could not find path when GetFileStatus, path: ")
+            .append(filePath));
+  }
 
-  JavaClassCache::JavaMethodContext getModificationTimeMethod =
+  status = ReadFileStatus(fileStatusObj, fileStatus);
+  jniEnv->DeleteLocalRef(fileStatusObj);
+  if (status.ok() && file_status_cache_ != nullptr) {
+    file_status_cache_->Add(fileKey, dirVersion, *fileStatus);
+  }
+  return status;
+}
+
+IOStatus FlinkFileSystem::ReadFileStatus(
+    jobject fileStatusObj, FlinkFileStatusCache::FileStatus* fileStatus) {
+  JNIEnv* jniEnv = getJNIEnv();
+  const JavaClassCache::JavaMethodContext& getLenMethod =
+      class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_STATUS_GET_LEN);
+  const JavaClassCache::JavaMethodContext& getModificationTimeMethod =
       class_cache_->GetJMethod(
           JavaClassCache::JM_FLINK_FILE_STATUS_GET_MODIFICATION_TIME);
-  jlong fileModificationTime =
-      jniEnv->CallLongMethod(fileStatus, getModificationTimeMethod.javaMethod);
-  jniEnv->DeleteLocalRef(fileStatus);
+  const JavaClassCache::JavaMethodContext& isDirMethod =
+      class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_STATUS_IS_DIR);
 
-  status = CurrentStatus([file_name]() {
-    return std::string("Exception when GetFileModificationTime, file name: ")
-        .append(file_name);
-  });
+  jlong fileSize =
+      jniEnv->CallLongMethod(fileStatusObj, getLenMethod.javaMethod);
+  jlong fileModificationTime = 0;
+  jboolean isDir = JNI_FALSE;
+  if (!jniEnv->ExceptionCheck()) {
+    fileModificationTime = jniEnv->CallLongMethod(
+        fileStatusObj, getModificationTimeMethod.javaMethod);
+  }
+  if (!jniEnv->ExceptionCheck()) {
+    isDir = jniEnv->CallBooleanMethod(fileStatusObj, isDirMethod.javaMethod);
+  }
+  IOStatus status = CurrentStatus(
+      []() { return std::string("Exception when reading ForStFileStatus"); });
   if (!status.ok()) {
     return status;
   }
 
-  *time = fileModificationTime;
+  fileStatus->size = static_cast<uint64_t>(fileSize);
+  fileStatus->modification_time = static_cast<uint64_t>(fileModificationTime);
+  fileStatus->is_dir = isDir == JNI_TRUE;
   return IOStatus::OK();
 }
 
-IOStatus FlinkFileSystem::IsDirectory(const std::string& path,
-                                      const IOOptions& options, bool* is_dir,
-                                      IODebugContext* dbg) {
-  JNIEnv* jniEnv = getJNIEnv();
-  jobject fileStatus;
-  IOStatus status = GetFileStatus(path, options, dbg, &fileStatus);
+IOStatus FlinkFileSystem::GetFileModificationTime(const std::string& file_name,
+                                                  const IOOptions& options,
+                                                  uint64_t* time,
+                                                  IODebugContext* dbg) {
+  std::string localPath;
+  uint64_t localFileSize;
+  if (file_uploader_ != nullptr &&
+      file_uploader_->GetPending(file_name, &localPath, &localFileSize) &&
+      target_->GetFileModificationTime(localPath, options, time, dbg).ok()) {
+    return IOStatus::OK();
+  }
+
+  FlinkFileStatusCache::FileStatus fileStatus;
+  IOStatus status = GetFileStatus(file_name, options, dbg, &fileStatus);
   if (!status.ok()) {
     return status;
   }
+  *time = fileStatus.modification_time;
+  return IOStatus::OK();
+}
 
-  JavaClassCache::JavaMethodContext isDirMethod =
-      class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_STATUS_IS_DIR);
-  jboolean isDir =
-      jniEnv->CallBooleanMethod(fileStatus, isDirMethod.javaMethod);
-  jniEnv->DeleteLocalRef(fileStatus);
+IOStatus FlinkFileSystem::IsDirectory(const std::string& path,
+                                      const IOOptions& options, bool* is_dir,
+                                      IODebugContext* dbg) {
+  std::string localPath;
+  uint64_t localFileSize;
+  if (file_uploader_ != nullptr &&
+      file_uploader_->GetPending(path, &localPath, &localFileSize)) {
+    *is_dir = false;
+    return IOStatus::OK();
+  }
 
-  status = CurrentStatus([path]() {
-    return std::string("Exception when IsDirectory, file name: ").append(path);
-  });
+  FlinkFileStatusCache::FileStatus fileStatus;
+  IOStatus status = GetFileStatus(path, options, dbg, &fileStatus);
   if (!status.ok()) {
     return status;
   }
-
-  *is_dir = isDir;
+  *is_dir = fileStatus.is_dir;
   return IOStatus::OK();
 }
 
@@ -751,6 +2000,16 @@ IOStatus FlinkFileSystem::RenameFile(const std::string& src,
                                      const std::string& target,
                                      const IOOptions& options,
                                      IODebugContext* dbg) {
+  if (file_uploader_ != nullptr) {
+    IOStatus status = file_uploader_->Wait(src);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  if (file_cache_ != nullptr) {
+    file_cache_->Erase(src);
+    file_cache_->Erase(target);
+  }
   IOStatus status = FileExists(src, options, dbg);
   if (!status.ok()) {
     return status.IsNotFound()
@@ -768,15 +2027,29 @@ IOStatus FlinkFileSystem::RenameFile(const std::string& src,
   std::string targetFilePath = ConstructPath(target);
   jstring targetPathString = jniEnv->NewStringUTF(targetFilePath.c_str());
 
-  JavaClassCache::JavaMethodContext renameMethod = class_cache_->GetJMethod(
-      JavaClassCache::JM_FLINK_FILE_SYSTEM_RENAME_FILE);
-  jboolean renamed =
-      jniEnv->CallBooleanMethod(file_system_instance_, renameMethod.javaMethod,
-                                srcPathString, targetPathString);
+  const JavaClassCache::JavaMethodContext& renameMethod =
+      class_cache_->GetJMethod(
+          JavaClassCache::JM_FLINK_FILE_SYSTEM_RENAME_FILE);
+  jboolean renamed;
+  {
+    StopWatch sw(SystemClock::Default().get(), options_.statistics.get(),
+                 FLINK_FS_RENAME_MICROS);
+    renamed = jniEnv->CallBooleanMethod(file_system_instance_,
+                                        renameMethod.javaMethod, srcPathString,
+                                        targetPathString);
+  }
   jniEnv->DeleteLocalRef(srcPathString);
   jniEnv->DeleteLocalRef(targetPathString);
+  if (file_status_cache_ != nullptr) {
+    if (renamed && !jniEnv->ExceptionCheck()) {
+      file_status_cache_->Remove(TrimTrailingSlash(srcFilePath));
+    } else {
+      file_status_cache_->Invalidate(TrimTrailingSlash(srcFilePath));
+    }
+    file_status_cache_->Invalidate(TrimTrailingSlash(targetFilePath));
+  }
 
-  status = CurrentStatus([srcFilePath, targetFilePath]() {
+  status = CurrentStatus([&srcFilePath, &targetFilePath]() {
     return std::string("Exception when RenameFile, src: ")
         .append(srcFilePath)
         .append(", target: ")
@@ -815,6 +2088,12 @@ IOStatus FlinkFileSystem::LinkFile(const std::string& src,
                                    const std::string& target,
                                    const IOOptions& options,
                                    IODebugContext* dbg) {
+  if (file_uploader_ != nullptr) {
+    IOStatus status = file_uploader_->Wait(src);
+    if (!status.ok()) {
+      return status;
+    }
+  }
   IOStatus status = FileExists(src, options, dbg);
   if (!status.ok()) {
     return status.IsNotFound()
@@ -833,15 +2112,34 @@ IOStatus FlinkFileSystem::LinkFile(const std::string& src,
   std::string targetFilePath = ConstructPath(target);
   jstring targetPathString = jniEnv->NewStringUTF(targetFilePath.c_str());
 
-  JavaClassCache::JavaMethodContext linkMethod =
+  const JavaClassCache::JavaMethodContext& linkMethod =
       class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_SYSTEM_LINK_FILE);
-  jint linked =
-      jniEnv->CallIntMethod(file_system_instance_, linkMethod.javaMethod,
-                            srcPathString, targetPathString);
+  const JavaClassCache::JavaMethodContext& copyMethod =
+      class_cache_->GetJMethod(JavaClassCache::JM_FLINK_FILE_SYSTEM_COPY_FILE);
+  jint linked;
+  {
+    StopWatch sw(SystemClock::Default().get(), options_.statistics.get(),
+                 FLINK_FS_LINK_MICROS);
+    linked = jniEnv->CallIntMethod(file_system_instance_,
+                                   linkMethod.javaMethod, srcPathString,
+                                   targetPathString);
+    // Without links, a copy within the remote file system still saves
+    // transferring the file through ForSt, e.g. for checkpoints. It is as good
+    // as a link as the linked files are immutable.
+    if (linked == -1 && copyMethod.javaMethod != nullptr &&
+        !jniEnv->ExceptionCheck()) {
+      linked = jniEnv->CallIntMethod(file_system_instance_,
+                                     copyMethod.javaMethod, srcPathString,
+                                     targetPathString);
+    }
+  }
   jniEnv->DeleteLocalRef(srcPathString);
   jniEnv->DeleteLocalRef(targetPathString);
+  if (file_status_cache_ != nullptr) {
+    file_status_cache_->Invalidate(TrimTrailingSlash(targetFilePath));
+  }
 
-  status = CurrentStatus([srcFilePath, targetFilePath]() {
+  status = CurrentStatus([&srcFilePath, &targetFilePath]() {
     return std::string("Exception when LinkFile, src: ")
         .append(srcFilePath)
         .append(", target: ")
@@ -862,6 +2160,158 @@ IOStatus FlinkFileSystem::LinkFile(const std::string& src,
   return IOStatus::OK();
 }
 
+IOStatus FlinkFileSystem::Poll(std::vector<void*>& io_handles,
+                               size_t min_completions) {
+  std::vector<void*> flink_handles = io_handles;
+  std::vector<void*> local_handles;
+  FlinkIOHandleRegistry::Get()->Split(&flink_handles, &local_handles);
+  size_t num_completions = 0;
+  if (!local_handles.empty()) {
+    num_completions = std::min(min_completions, local_handles.size());
+    IOStatus s = target_->Poll(local_handles, num_completions);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+  if (flink_handles.empty()) {
+    return IOStatus::OK();
+  }
+
+  JNIEnv* jniEnv = getJNIEnv();
+  const JavaClassCache::JavaMethodContext& isDoneMethod =
+      class_cache_->GetJMethod(JavaClassCache::JM_FUTURE_IS_DONE);
+
+  // The Java side has been reading the handles in parallel since they were
+  // submitted. Complete those already done first, then block on the others
+  // in order only until min_completions is reached, so a slow read doesn't
+  // hold back those finished after it.
+  std::vector<FlinkIOHandle*> pending_handles;
+  for (void* io_handle : flink_handles) {
+    auto flinkHandle = static_cast<FlinkIOHandle*>(io_handle);
+    if (flinkHandle == nullptr || flinkHandle->is_finished) {
+      num_completions++;
+      continue;
+    }
+    jboolean isDone = jniEnv->CallBooleanMethod(flinkHandle->future,
+                                                isDoneMethod.javaMethod);
+    if (jniEnv->ExceptionCheck()) {
+      jniEnv->ExceptionDescribe();
+      jniEnv->ExceptionClear();
+      isDone = JNI_FALSE;
+    }
+    if (isDone) {
+      CompleteIOHandle(flinkHandle);
+      num_completions++;
+    } else {
+      pending_handles.push_back(flinkHandle);
+    }
+  }
+  for (FlinkIOHandle* flinkHandle : pending_handles) {
+    if (num_completions >= min_completions) {
+      break;
+    }
+    CompleteIOHandle(flinkHandle);
+    num_completions++;
+  }
+  return IOStatus::OK();
+}
+
+void FlinkFileSystem::CompleteIOHandle(FlinkIOHandle* flink_handle) {
+  JNIEnv* jniEnv = getJNIEnv();
+  const JavaClassCache::JavaMethodContext& getMethod =
+      class_cache_->GetJMethod(JavaClassCache::JM_FUTURE_GET);
+  const JavaClassCache::JavaMethodContext& intValueMethod =
+      class_cache_->GetJMethod(JavaClassCache::JM_INTEGER_INT_VALUE);
+
+  FSReadRequest req;
+  req.offset = flink_handle->offset;
+  req.len = flink_handle->len;
+  req.scratch = flink_handle->scratch;
+
+  jobject bytesRead =
+      jniEnv->CallObjectMethod(flink_handle->future, getMethod.javaMethod);
+  jint totalBytesRead = 0;
+  if (bytesRead != nullptr && !jniEnv->ExceptionCheck()) {
+    totalBytesRead =
+        jniEnv->CallIntMethod(bytesRead, intValueMethod.javaMethod);
+  }
+  if (bytesRead != nullptr) {
+    jniEnv->DeleteLocalRef(bytesRead);
+  }
+
+  if (bytesRead == nullptr || jniEnv->ExceptionCheck()) {
+    // Failure of one read is reported by its own request, so clear the
+    // exception to keep polling the others.
+    jniEnv->ExceptionDescribe();
+    jniEnv->ExceptionClear();
+    req.status = IOStatus::IOError("Exception when Poll async read from Flink");
+  } else {
+    req.result = Slice(req.scratch, totalBytesRead < 0 ? 0 : totalBytesRead);
+    req.status = IOStatus::OK();
+    RecordInHistogram(options_.statistics.get(), FLINK_FS_READ_BYTES,
+                      req.result.size());
+    RecordTick(options_.statistics.get(), FLINK_FS_BYTES_READ,
+               req.result.size());
+  }
+  flink_handle->is_finished = true;
+  flink_handle->cb(req, flink_handle->cb_arg);
+}
+
+IOStatus FlinkFileSystem::AbortIO(std::vector<void*>& io_handles) {
+  std::vector<void*> flink_handles = io_handles;
+  std::vector<void*> local_handles;
+  FlinkIOHandleRegistry::Get()->Split(&flink_handles, &local_handles);
+  if (!local_handles.empty()) {
+    IOStatus s = target_->AbortIO(local_handles);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+  if (flink_handles.empty()) {
+    return IOStatus::OK();
+  }
+
+  JNIEnv* jniEnv = getJNIEnv();
+  const JavaClassCache::JavaMethodContext& getMethod =
+      class_cache_->GetJMethod(JavaClassCache::JM_FUTURE_GET);
+
+  for (void* io_handle : flink_handles) {
+    auto flinkHandle = static_cast<FlinkIOHandle*>(io_handle);
+    if (flinkHandle == nullptr || flinkHandle->is_finished) {
+      continue;
+    }
+    // Future#cancel doesn't guarantee that a running read stops writing into
+    // the scratch, which is freed by the caller once aborted. So wait for the
+    // read and just drop its result.
+    jobject bytesRead =
+        jniEnv->CallObjectMethod(flinkHandle->future, getMethod.javaMethod);
+    if (bytesRead != nullptr) {
+      jniEnv->DeleteLocalRef(bytesRead);
+    }
+    if (jniEnv->ExceptionCheck()) {
+      jniEnv->ExceptionClear();
+    }
+
+    FSReadRequest req;
+    req.status = IOStatus::Aborted();
+    flinkHandle->is_finished = true;
+    flinkHandle->cb(req, flinkHandle->cb_arg);
+  }
+  return IOStatus::OK();
+}
+
+void FlinkFileSystem::SupportedOps(int64_t& supported_ops) {
+  // Don't inherit the ops of base FileSystem, e.g. io_uring based async io of
+  // local file system, Flink FileSystem has its own implementations.
+  supported_ops = 0;
+  if (class_cache_ != nullptr &&
+      class_cache_
+              ->GetJMethod(JavaClassCache::JM_FLINK_FS_INPUT_STREAM_READ_ASYNC)
+              .javaMethod != nullptr) {
+    supported_ops |= (1 << FSSupportedOps::kAsyncIO);
+  }
+}
+
 IOStatus FlinkFileSystem::NewLogger(const std::string& fname,
                                     const IOOptions& io_opts,
                                     std::shared_ptr<Logger>* result,
@@ -884,8 +2334,10 @@ IOStatus FlinkFileSystem::NewLogger(const std::string& fname,
 Status FlinkFileSystem::Create(const std::shared_ptr<FileSystem>& base,
                                const std::string& uri,
                                std::unique_ptr<FileSystem>* result,
-                               jobject file_system_instance) {
-  auto* fileSystem = new FlinkFileSystem(base, uri, file_system_instance);
+                               jobject file_system_instance,
+                               const FlinkFileSystemOptions& options) {
+  auto* fileSystem =
+      new FlinkFileSystem(base, uri, file_system_instance, options);
   Status status = fileSystem->Init();
   result->reset(fileSystem);
   return status;
@@ -893,9 +2345,10 @@ Status FlinkFileSystem::Create(const std::shared_ptr<FileSystem>& base,
 
 Status NewFlinkEnv(const std::string& uri,
                    std::unique_ptr<Env>* flinkFileSystem,
-                   jobject file_system_instance) {
+                   jobject file_system_instance,
+                   const FlinkFileSystemOptions& options) {
   std::shared_ptr<FileSystem> fs;
-  Status s = NewFlinkFileSystem(uri, &fs, file_system_instance);
+  Status s = NewFlinkFileSystem(uri, &fs, file_system_instance, options);
   if (s.ok()) {
     *flinkFileSystem = NewCompositeEnv(fs);
   }
@@ -904,10 +2357,12 @@ Status NewFlinkEnv(const std::string& uri,
 
 Status NewFlinkFileSystem(const std::string& uri,
                           std::shared_ptr<FileSystem>* fs,
-                          jobject file_system_instance) {
+                          jobject file_system_instance,
+                          const FlinkFileSystemOptions& options) {
   std::unique_ptr<FileSystem> flinkFileSystem;
-  Status s = FlinkFileSystem::Create(FileSystem::Default(), uri,
-                                     &flinkFileSystem, file_system_instance);
+  Status s =
+      FlinkFileSystem::Create(FileSystem::Default(), uri, &flinkFileSystem,
+                              file_system_instance, options);
   if (s.ok()) {
     fs->reset(flinkFileSystem.release());
   }
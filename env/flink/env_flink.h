@@ -18,13 +18,100 @@
 
 #pragma once
 
+#include "flink_file_cache.h"
+#include "flink_file_status_cache.h"
+#include "flink_file_uploader.h"
+#include "flink_readahead_policy.h"
 #include "jni_helper.h"
 #include "rocksdb/env.h"
 #include "rocksdb/file_system.h"
+#include "rocksdb/statistics.h"
 #include "rocksdb/status.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+struct FlinkIOHandle;
+
+// Options to tune FlinkFileSystem
+struct FlinkFileSystemOptions {
+  // Max number of input streams opened for one file opened for random reads.
+  // Concurrent random reads lease a stream from the pool of a file, so that
+  // they don't serialize on one stream. 1 means all the reads share one stream.
+  size_t max_input_streams_per_file = 1;
+
+  // Local directory to cache remote SST files. Empty means no local cache.
+  // Files in the directory are deleted when the FlinkFileSystem is created.
+  std::string local_cache_dir;
+
+  // Capacity in bytes of the local cache.
+  uint64_t local_cache_capacity = 0;
+
+  // Remote SST files up to this size are downloaded into the local cache when
+  // opened for random reads, synchronously by the opening thread, e.g. on a
+  // table cache miss of a user read. Larger files are read remotely, and only
+  // cached when written. 0 means no limit.
+  uint64_t max_cache_on_open_size = uint64_t{256} << 20;
+
+  // Local directory to stage new SST files, which are written locally and
+  // uploaded to the remote file system by background threads when closed.
+  // Empty means SST files are written to the remote file system directly.
+  // Files in the directory are deleted when the FlinkFileSystem is created.
+  // Closing a file only schedules its upload, and the file is read from the
+  // local copy until uploaded. A directory Fsync() waits for the uploads and
+  // returns their status, so a flush or compaction, which syncs the directory
+  // of its output files, only installs them after they are uploaded. The
+  // local file is kept until uploaded, and after if cached.
+  std::string local_staging_dir;
+
+  // Number of background threads uploading staged files.
+  size_t max_background_uploads = 4;
+
+  // Cache the metadata of remote files, which is populated by directory
+  // listings and status queries, and kept up to date by the modifications
+  // through this FileSystem. So it requires that the files under base path
+  // are not modified by others.
+  bool cache_file_status = false;
+
+  // Deletes of SST and blob files are batched into one remote call for up to
+  // this number of files. Pending deletes are also flushed by a directory
+  // listing or fsync, and the files are invisible meanwhile. 1 means files are
+  // deleted one by one at once. Files are queued without querying them, so a
+  // missing file is only reported if known to be, e.g. by cache_file_status.
+  // Files failed to be deleted stay pending and are retried by the next
+  // flush.
+  size_t delete_batch_size = 1;
+
+  // Files opened for random reads support Prefetch, so that the readahead of
+  // iterators and compactions is done by FlinkFileSystem rather than by the
+  // internal prefetch buffer, which starts small and doubles as tuned for
+  // local disks. The readahead size is adapted to the latency and throughput
+  // observed from remote reads, between min_readahead_size and
+  // max_readahead_size, and never smaller than requested. Whether and how
+  // much to read ahead is still requested per column family by
+  // BlockBasedTableOptions::initial_auto_readahead_size and
+  // max_auto_readahead_size (0 disables it), ReadOptions::readahead_size and
+  // DBOptions::compaction_readahead_size.
+  bool remote_readahead = false;
+
+  // Readahead size used until the cost of remote reads is learned.
+  size_t min_readahead_size = 2 << 20;
+
+  size_t max_readahead_size = 64 << 20;
+
+  // Compaction inputs up to this size are read as a whole by their first
+  // readahead. 0 disables it.
+  uint64_t max_whole_file_prefetch_size = 64 << 20;
+
+  // Total memory of readahead buffers of all the files. Readaheads beyond it
+  // are skipped.
+  size_t max_readahead_memory = 512 << 20;
+
+  // If set, the latencies of the Flink FileSystem calls and the bytes
+  // transferred are recorded in it. Pass the same object as
+  // DBOptions::statistics to report them along with the DB statistics.
+  std::shared_ptr<Statistics> statistics;
+};
+
 // FlinkFileSystem extended from FileSystemWrapper which delegate necessary
 // methods to Flink FileSystem based on JNI. For other methods, base FileSystem
 // will proxy its methods.
@@ -32,10 +119,11 @@ class FlinkFileSystem : public FileSystemWrapper {
  public:
   // Create FlinkFileSystem with base_fs proxying all other methods and
   // base_path
-  static Status Create(const std::shared_ptr<FileSystem>& /*base_fs*/,
-                       const std::string& /*base_path*/,
-                       std::unique_ptr<FileSystem>* /*fs*/,
-                       jobject file_system_instance);
+  static Status Create(
+      const std::shared_ptr<FileSystem>& /*base_fs*/,
+      const std::string& /*base_path*/, std::unique_ptr<FileSystem>* /*fs*/,
+      jobject file_system_instance,
+      const FlinkFileSystemOptions& options = FlinkFileSystemOptions());
 
   // Define some names
   static const char* kClassName() { return "FlinkFileSystem"; }
@@ -102,18 +190,42 @@ class FlinkFileSystem : public FileSystemWrapper {
                     const IOOptions& /*options*/,
                     IODebugContext* /*dbg*/) override;
 
+  IOStatus Poll(std::vector<void*>& /*io_handles*/,
+                size_t /*min_completions*/) override;
+
+  IOStatus AbortIO(std::vector<void*>& /*io_handles*/) override;
+
+  void SupportedOps(int64_t& /*supported_ops*/) override;
+
   IOStatus NewLogger(const std::string& fname, const IOOptions& io_opts,
                      std::shared_ptr<Logger>* result,
                      IODebugContext* dbg) override;
 
+  // Deletes the files whose deletes are batched
+  IOStatus FlushPendingDeletes();
+
+  // Waits for the staged files closed so far to be uploaded, and returns the
+  // status of a failed upload, if any.
+  IOStatus WaitForUploads();
+
  private:
   const std::string base_path_;
+  const FlinkFileSystemOptions options_;
   JavaClassCache* class_cache_;
   jobject file_system_instance_;
+  std::unique_ptr<FlinkFileCache> file_cache_;
+  std::unique_ptr<FlinkFileUploader> file_uploader_;
+  std::unique_ptr<FlinkFileStatusCache> file_status_cache_;
+  std::unique_ptr<FlinkReadaheadPolicy> readahead_policy_;
+  port::Mutex pending_deletes_mutex_;
+  // Full paths of the files to delete
+  std::vector<std::string> pending_deletes_;
+  port::Mutex flush_deletes_mutex_;
 
   explicit FlinkFileSystem(const std::shared_ptr<FileSystem>& base,
                            const std::string& fsname,
-                           jobject file_system_instance);
+                           jobject file_system_instance,
+                           const FlinkFileSystemOptions& options);
 
   // Init FileSystem
   Status Init();
@@ -123,9 +235,26 @@ class FlinkFileSystem : public FileSystemWrapper {
                   bool /*recursive*/);
   IOStatus GetFileStatus(const std::string& /*file_name*/,
                          const IOOptions& /*options*/, IODebugContext* /*dbg*/,
-                         jobject* /*fileStatus*/);
+                         FlinkFileStatusCache::FileStatus* /*fileStatus*/);
+  IOStatus ReadFileStatus(jobject /*fileStatusObj*/,
+                          FlinkFileStatusCache::FileStatus* /*fileStatus*/);
+  static bool ShouldBatchDelete(const std::string& /*file_name*/);
+  bool IsPendingDelete(const std::string& /*file_path*/);
+  // Sets the status of each file, PathNotFound if it did not exist
+  void DeleteRemoteFiles(const std::vector<std::string>& /*file_paths*/,
+                         std::vector<IOStatus>* /*results*/);
   std::string ConstructPath(const std::string& /*file_name*/);
 
+  // Copies a staged local file to the remote file system
+  IOStatus UploadFile(const std::string& /*file_name*/,
+                      const std::string& /*local_path*/);
+  // Waits for the async read of the handle and calls its callback
+  void CompleteIOHandle(FlinkIOHandle* /*flink_handle*/);
+  // Handles the staged local file after its upload is done
+  void FinishUpload(const std::string& /*file_name*/,
+                    const std::string& /*local_path*/, uint64_t /*size*/,
+                    const IOStatus& /*status*/);
+
   static std::string TrimTrailingSlash(const std::string& base_path) {
     if (!base_path.empty() && base_path.back() == '/') {
       return base_path.substr(0, base_path.size() - 1);
@@ -136,10 +265,13 @@ class FlinkFileSystem : public FileSystemWrapper {
 };
 
 // Returns a `FlinkEnv` with base_path
-Status NewFlinkEnv(const std::string& base_path, std::unique_ptr<Env>* env,
-                   jobject file_system_instance);
+Status NewFlinkEnv(
+    const std::string& base_path, std::unique_ptr<Env>* env,
+    jobject file_system_instance,
+    const FlinkFileSystemOptions& options = FlinkFileSystemOptions());
 // Returns a `FlinkFileSystem` with base_path
-Status NewFlinkFileSystem(const std::string& base_path,
-                          std::shared_ptr<FileSystem>* fs,
-                          jobject file_system_instance);
+Status NewFlinkFileSystem(
+    const std::string& base_path, std::shared_ptr<FileSystem>* fs,
+    jobject file_system_instance,
+    const FlinkFileSystemOptions& options = FlinkFileSystemOptions());
 }  // namespace ROCKSDB_NAMESPACE
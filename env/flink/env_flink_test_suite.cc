@@ -19,8 +19,11 @@
 #include "env/flink/env_flink_test_suite.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <thread>
 
 #define ASSERT_TRUE(expression)                                               \
   if (!(expression)) {                                                        \
@@ -49,6 +52,20 @@ void EnvFlinkTestSuites::runAllTestSuites() {
   LOG("Stage 4: testGetChildren OK");
   testFileReadAndWrite();
   LOG("Stage 5: testFileReadAndWrite OK");
+  testConcurrentRandomRead();
+  LOG("Stage 6: testConcurrentRandomRead OK");
+  testLocalFileCache();
+  LOG("Stage 7: testLocalFileCache OK");
+  testStagedUpload();
+  LOG("Stage 8: testStagedUpload OK");
+  testFileStatusCacheAndBatchDelete();
+  LOG("Stage 9: testFileStatusCacheAndBatchDelete OK");
+  testRemoteReadahead();
+  LOG("Stage 10: testRemoteReadahead OK");
+  testStatistics();
+  LOG("Stage 11: testStatistics OK");
+  testLinkFileByCopy();
+  LOG("Stage 12: testLinkFileByCopy OK");
 }
 
 void EnvFlinkTestSuites::setUp() {
@@ -160,9 +177,397 @@ void EnvFlinkTestSuites::testFileReadAndWrite() {
                              &random_access_data, (char*)random_access_scratch);
   ASSERT_TRUE(random_access_data.data() == content2);
   delete[] random_access_scratch;
+
+  // Requests are out of order and the last one is beyond the end of file
+  std::vector<ReadRequest> multi_read_reqs(3);
+  std::vector<std::string> multi_read_scratches(3, std::string(16, '\0'));
+  const size_t offsets[] = {content1.size(), 0, content.size() - 2};
+  const size_t lengths[] = {content2.size(), 5, 10};
+  for (size_t i = 0; i < multi_read_reqs.size(); i++) {
+    multi_read_reqs[i].offset = offsets[i];
+    multi_read_reqs[i].len = lengths[i];
+    multi_read_reqs[i].scratch = &multi_read_scratches[i][0];
+  }
+  ASSERT_TRUE(random_access_result
+                  ->MultiRead(multi_read_reqs.data(), multi_read_reqs.size())
+                  .ok());
+  for (const auto& req : multi_read_reqs) {
+    ASSERT_TRUE(req.status.ok());
+  }
+  ASSERT_TRUE(multi_read_reqs[0].result == Slice(content2));
+  ASSERT_TRUE(multi_read_reqs[1].result == Slice("Hello"));
+  ASSERT_TRUE(multi_read_reqs[2].result == Slice("St"));
+
+  // Async read, either completed by Poll or synchronously if the Flink
+  // FileSystem doesn't support it
+  const std::shared_ptr<FileSystem>& fs = flink_env_->GetFileSystem();
+  std::unique_ptr<FSRandomAccessFile> fs_random_access_result;
+  ASSERT_TRUE(fs->NewRandomAccessFile(file_name, FileOptions(),
+                                      &fs_random_access_result, nullptr)
+                  .ok());
+  std::string async_scratch(content2.size(), '\0');
+  FSReadRequest async_req;
+  async_req.offset = content1.size();
+  async_req.len = content2.size();
+  async_req.scratch = &async_scratch[0];
+  bool async_completed = false;
+  std::string async_result;
+  auto async_cb = [&](const FSReadRequest& req, void* /*cb_arg*/) {
+    ASSERT_TRUE(req.status.ok());
+    async_result = req.result.ToString();
+    async_completed = true;
+  };
+  void* io_handle = nullptr;
+  IOHandleDeleter del_fn = nullptr;
+  ASSERT_TRUE(fs_random_access_result
+                  ->ReadAsync(async_req, IOOptions(), async_cb, nullptr,
+                              &io_handle, &del_fn, nullptr)
+                  .ok());
+  if (io_handle != nullptr) {
+    std::vector<void*> io_handles{io_handle};
+    ASSERT_TRUE(fs->Poll(io_handles, 1).ok());
+    del_fn(io_handle);
+  }
+  ASSERT_TRUE(async_completed);
+  ASSERT_TRUE(async_result == content2);
+}
+
+void EnvFlinkTestSuites::testConcurrentRandomRead() {
+  const std::string file_name = "test-file";
+  FlinkFileSystemOptions options;
+  options.max_input_streams_per_file = 2;
+  std::unique_ptr<Env> pooled_env;
+  ASSERT_TRUE(NewFlinkEnv(base_path_, &pooled_env, nullptr, options).ok());
+  generateFile(file_name);
+
+  std::unique_ptr<RandomAccessFile> random_access_result;
+  ASSERT_TRUE(
+      pooled_env
+          ->NewRandomAccessFile(file_name, &random_access_result, EnvOptions())
+          .ok());
+
+  // More readers than streams, some of them have to wait for a stream
+  std::vector<std::thread> readers;
+  std::atomic<int> num_matched{0};
+  for (int i = 0; i < 4; i++) {
+    readers.emplace_back([&random_access_result, &num_matched]() {
+      for (int j = 0; j < 100; j++) {
+        char scratch[5];
+        Slice data;
+        if (random_access_result->Read(6, 5, &data, scratch).ok() &&
+            data == Slice("World")) {
+          num_matched++;
+        }
+      }
+    });
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  ASSERT_TRUE(num_matched == 400);
+  ASSERT_TRUE(pooled_env->DeleteFile(file_name).ok());
+}
+
+void EnvFlinkTestSuites::testLocalFileCache() {
+  const std::string file_name = "000001.sst";
+  const std::string content = "Hello ForSt";
+  FlinkFileSystemOptions options;
+  options.local_cache_dir = "/tmp/forst-flink-env-test-cache";
+  options.local_cache_capacity = 1024 * 1024;
+  std::unique_ptr<Env> cached_env;
+  ASSERT_TRUE(NewFlinkEnv(base_path_, &cached_env, nullptr, options).ok());
+
+  std::unique_ptr<WritableFile> write_result;
+  ASSERT_TRUE(
+      cached_env->NewWritableFile(file_name, &write_result, EnvOptions()).ok());
+  ASSERT_TRUE(write_result->Append(content).ok());
+  ASSERT_TRUE(write_result->Close().ok());
+
+  // The remote file exists, and is read back from the local copy
+  ASSERT_TRUE(flink_env_->FileExists(file_name).ok());
+  std::unique_ptr<RandomAccessFile> random_access_result;
+  ASSERT_TRUE(
+      cached_env
+          ->NewRandomAccessFile(file_name, &random_access_result, EnvOptions())
+          .ok());
+  char scratch[16];
+  Slice data;
+  ASSERT_TRUE(
+      random_access_result->Read(0, content.size(), &data, scratch).ok());
+  ASSERT_TRUE(data == Slice(content));
+  ASSERT_TRUE(cached_env->DeleteFile(file_name).ok());
+  ASSERT_TRUE(flink_env_->FileExists(file_name).IsNotFound());
+}
+
+void EnvFlinkTestSuites::testStagedUpload() {
+  const std::string file_name = "000002.sst";
+  const std::string content = "Hello ForSt";
+  FlinkFileSystemOptions options;
+  options.local_staging_dir = "/tmp/forst-flink-env-test-staging";
+  options.max_background_uploads = 2;
+  std::unique_ptr<Env> staged_env;
+  ASSERT_TRUE(NewFlinkEnv(base_path_, &staged_env, nullptr, options).ok());
+
+  std::unique_ptr<WritableFile> write_result;
+  ASSERT_TRUE(
+      staged_env->NewWritableFile(file_name, &write_result, EnvOptions()).ok());
+  ASSERT_TRUE(write_result->Append(content).ok());
+  ASSERT_TRUE(write_result->Close().ok());
+
+  // Visible at once, whether the upload is done or not
+  uint64_t file_size;
+  ASSERT_TRUE(staged_env->FileExists(file_name).ok());
+  ASSERT_TRUE(staged_env->GetFileSize(file_name, &file_size).ok());
+  ASSERT_TRUE(file_size == content.size());
+
+  // Uploaded once the directory is synced
+  std::unique_ptr<Directory> dir;
+  ASSERT_TRUE(staged_env->NewDirectory("/", &dir).ok());
+  ASSERT_TRUE(dir->Fsync().ok());
+  ASSERT_TRUE(flink_env_->FileExists(file_name).ok());
+  ASSERT_TRUE(flink_env_->GetFileSize(file_name, &file_size).ok());
+  ASSERT_TRUE(file_size == content.size());
+
+  ASSERT_TRUE(staged_env->DeleteFile(file_name).ok());
+  ASSERT_TRUE(flink_env_->FileExists(file_name).IsNotFound());
+}
+
+void EnvFlinkTestSuites::testFileStatusCacheAndBatchDelete() {
+  const std::string dir_name = "test-status-dir";
+  const std::string file_name_1 = dir_name + "/000001.sst";
+  const std::string file_name_2 = dir_name + "/000002.sst";
+  FlinkFileSystemOptions options;
+  options.cache_file_status = true;
+  options.delete_batch_size = 2;
+  std::unique_ptr<Env> cached_env;
+  ASSERT_TRUE(NewFlinkEnv(base_path_, &cached_env, nullptr, options).ok());
+
+  ASSERT_TRUE(cached_env->CreateDirIfMissing(dir_name).ok());
+  generateFile(file_name_1);
+  generateFile(file_name_2);
+  std::vector<std::string> result;
+  ASSERT_TRUE(cached_env->GetChildren(dir_name, &result).ok());
+  ASSERT_TRUE(result.size() == 2);
+
+  // Served by the listing
+  uint64_t file_size, expected_file_size;
+  ASSERT_TRUE(flink_env_->GetFileSize(file_name_1, &expected_file_size).ok());
+  ASSERT_TRUE(cached_env->GetFileSize(file_name_1, &file_size).ok());
+  ASSERT_TRUE(file_size == expected_file_size);
+  ASSERT_TRUE(cached_env->FileExists(dir_name + "/000003.sst").IsNotFound());
+
+  // The first delete is pending, the second one flushes both
+  ASSERT_TRUE(cached_env->DeleteFile(file_name_1).ok());
+  ASSERT_TRUE(cached_env->FileExists(file_name_1).IsNotFound());
+  ASSERT_TRUE(flink_env_->FileExists(file_name_1).ok());
+  // Files known to be missing are reported at once, whether pending or not
+  ASSERT_TRUE(cached_env->DeleteFile(file_name_1).IsPathNotFound());
+  ASSERT_TRUE(
+      cached_env->DeleteFile(dir_name + "/000003.sst").IsPathNotFound());
+  ASSERT_TRUE(cached_env->DeleteFile(file_name_2).ok());
+  ASSERT_TRUE(flink_env_->FileExists(file_name_1).IsNotFound());
+  ASSERT_TRUE(flink_env_->FileExists(file_name_2).IsNotFound());
+  // Other missing files are queued without a query, and dropped by the flush
+  ASSERT_TRUE(cached_env->DeleteFile("test-other-dir/000004.sst").ok());
+  ASSERT_TRUE(cached_env->GetChildren(dir_name, &result).ok());
+  ASSERT_TRUE(result.empty());
+
+  // Written files are visible without listing again
+  std::unique_ptr<WritableFile> write_result;
+  ASSERT_TRUE(
+      cached_env->NewWritableFile(file_name_1, &write_result, EnvOptions())
+          .ok());
+  ASSERT_TRUE(write_result->Append("Hello ForSt").ok());
+  ASSERT_TRUE(write_result->Close().ok());
+  ASSERT_TRUE(cached_env->FileExists(file_name_1).ok());
+  ASSERT_TRUE(cached_env->GetFileSize(file_name_1, &file_size).ok());
+  ASSERT_TRUE(file_size == 11);
+  ASSERT_TRUE(cached_env->DeleteDir(dir_name).ok());
+  ASSERT_TRUE(cached_env->FileExists(file_name_1).IsNotFound());
+}
+
+void EnvFlinkTestSuites::testRemoteReadahead() {
+  const std::string file_name = "000003.sst";
+  const std::string content(4000, 'a');
+  FlinkFileSystemOptions options;
+  options.remote_readahead = true;
+  options.min_readahead_size = 1024;
+  options.max_whole_file_prefetch_size = 8192;
+  std::unique_ptr<Env> readahead_env;
+  ASSERT_TRUE(NewFlinkEnv(base_path_, &readahead_env, nullptr, options).ok());
+  const std::shared_ptr<FileSystem>& fs = readahead_env->GetFileSystem();
+  generateFile(file_name, content);
+
+  // Reads ahead the min size at first, which is served even if the remote
+  // file is overwritten meanwhile
+  std::unique_ptr<FSRandomAccessFile> scan_file;
+  ASSERT_TRUE(
+      fs->NewRandomAccessFile(file_name, FileOptions(), &scan_file, nullptr)
+          .ok());
+  ASSERT_TRUE(scan_file->Prefetch(0, 100, IOOptions(), nullptr).ok());
+  generateFile(file_name, std::string(content.size(), 'b'));
+  char scratch[100];
+  Slice data;
+  ASSERT_TRUE(
+      scan_file->Read(900, 100, IOOptions(), &data, scratch, nullptr).ok());
+  ASSERT_TRUE(data == Slice(content.data(), 100));
+  ASSERT_TRUE(
+      scan_file->Read(2000, 100, IOOptions(), &data, scratch, nullptr).ok());
+  ASSERT_TRUE(data == Slice(std::string(100, 'b')));
+
+  // A compaction input is read as a whole
+  generateFile(file_name, content);
+  std::unique_ptr<FSRandomAccessFile> compaction_file;
+  ASSERT_TRUE(fs->NewRandomAccessFile(file_name, FileOptions(),
+                                      &compaction_file, nullptr)
+                  .ok());
+  IOOptions compaction_options;
+  compaction_options.io_activity = Env::IOActivity::kCompaction;
+  ASSERT_TRUE(
+      compaction_file->Prefetch(0, 100, compaction_options, nullptr).ok());
+  generateFile(file_name, std::string(content.size(), 'b'));
+  ASSERT_TRUE(compaction_file
+                  ->Read(content.size() - 50, 100, IOOptions(), &data, scratch,
+                         nullptr)
+                  .ok());
+  ASSERT_TRUE(data == Slice(content.data(), 50));
+  ASSERT_TRUE(readahead_env->DeleteFile(file_name).ok());
+}
+
+void EnvFlinkTestSuites::testStatistics() {
+  const std::string file_name = "statistics";
+  const std::string content = "Hello Statistics";
+  FlinkFileSystemOptions options;
+  options.statistics = CreateDBStatistics();
+  std::unique_ptr<Env> stats_env;
+  ASSERT_TRUE(NewFlinkEnv(base_path_, &stats_env, nullptr, options).ok());
+
+  std::unique_ptr<WritableFile> write_file;
+  ASSERT_TRUE(
+      stats_env->NewWritableFile(file_name, &write_file, EnvOptions()).ok());
+  ASSERT_TRUE(write_file->Append(content).ok());
+  ASSERT_TRUE(write_file->Sync().ok());
+  ASSERT_TRUE(write_file->Close().ok());
+  ASSERT_TRUE(stats_env->FileExists(file_name).ok());
+  uint64_t file_size;
+  ASSERT_TRUE(stats_env->GetFileSize(file_name, &file_size).ok());
+  ASSERT_TRUE(stats_env->CreateDirIfMissing("stats-dir").ok());
+  ASSERT_TRUE(stats_env->DeleteDir("stats-dir").ok());
+
+  std::unique_ptr<RandomAccessFile> read_file;
+  ASSERT_TRUE(
+      stats_env->NewRandomAccessFile(file_name, &read_file, EnvOptions())
+          .ok());
+  char scratch[64];
+  Slice data;
+  ASSERT_TRUE(read_file->Read(0, content.size(), &data, scratch).ok());
+  read_file.reset();
+  ASSERT_TRUE(stats_env->DeleteFile(file_name).ok());
+
+  Statistics* stats = options.statistics.get();
+  ASSERT_TRUE(stats->getTickerCount(FLINK_FS_BYTES_WRITTEN) ==
+              content.size());
+  ASSERT_TRUE(stats->getTickerCount(FLINK_FS_BYTES_READ) == content.size());
+  for (uint32_t type :
+       {FLINK_FS_OPEN_MICROS, FLINK_FS_READ_MICROS, FLINK_FS_READ_BYTES,
+        FLINK_FS_WRITE_MICROS, FLINK_FS_SYNC_MICROS, FLINK_FS_CLOSE_MICROS,
+        FLINK_FS_EXISTS_MICROS, FLINK_FS_DELETE_MICROS,
+        FLINK_FS_GET_FILE_STATUS_MICROS, FLINK_FS_MKDIRS_MICROS}) {
+    HistogramData histogram;
+    stats->histogramData(type, &histogram);
+    ASSERT_TRUE(histogram.count > 0);
+  }
+}
+
+void EnvFlinkTestSuites::testLinkFileByCopy() {
+  const std::string file_name = "link-src";
+  const std::string target_name = "link-target";
+  const std::string content = "Hello Link";
+  generateFile(file_name, content);
+  // The mock file system does not link but copies the file remotely
+  ASSERT_TRUE(flink_env_->LinkFile(file_name, target_name).ok());
+  ASSERT_TRUE(flink_env_->DeleteFile(file_name).ok());
+  ASSERT_TRUE(flink_env_->FileExists(target_name).ok());
+
+  std::unique_ptr<SequentialFile> sequential_file;
+  ASSERT_TRUE(flink_env_
+                  ->NewSequentialFile(target_name, &sequential_file,
+                                      EnvOptions())
+                  .ok());
+  char scratch[64];
+  Slice data;
+  ASSERT_TRUE(sequential_file->Read(sizeof(scratch), &data, scratch).ok());
+  ASSERT_TRUE(data == content);
+  ASSERT_TRUE(flink_env_->DeleteFile(target_name).ok());
+}
+
+void EnvFlinkTestSuites::runBenchmarks(int numOps) {
+  if (flink_env_ == nullptr) {
+    setUp();
+  }
+  const std::string file_name = "benchmark-file";
+  const size_t append_size = 100, read_size = 4096;
+  auto logNanosPerOp = [numOps](const std::string& name,
+                                std::chrono::steady_clock::time_point start) {
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+    LOG(name + ": " + std::to_string(nanos / numOps) + " ns/op");
+  };
+
+  std::unique_ptr<WritableFile> writable_file;
+  ASSERT_TRUE(
+      flink_env_->NewWritableFile(file_name, &writable_file, EnvOptions())
+          .ok());
+  const std::string small_data(append_size, 'a');
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numOps; i++) {
+    ASSERT_TRUE(writable_file->Append(small_data).ok());
+  }
+  logNanosPerOp("Append " + std::to_string(append_size) + " bytes", start);
+  const std::string large_data(128 << 10, 'b');
+  ASSERT_TRUE(writable_file->Append(large_data).ok());
+  ASSERT_TRUE(writable_file->Close().ok());
+
+  const uint64_t file_size =
+      append_size * static_cast<uint64_t>(numOps) + large_data.size();
+  std::unique_ptr<RandomAccessFile> random_access_file;
+  ASSERT_TRUE(
+      flink_env_
+          ->NewRandomAccessFile(file_name, &random_access_file, EnvOptions())
+          .ok());
+  std::string scratch(large_data.size(), '\0');
+  Slice data;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numOps; i++) {
+    uint64_t offset = (static_cast<uint64_t>(i) * 7919) %
+                      (file_size - large_data.size() - read_size + 1);
+    ASSERT_TRUE(
+        random_access_file->Read(offset, read_size, &data, &scratch[0]).ok());
+    ASSERT_TRUE(data.size() == read_size);
+  }
+  logNanosPerOp("Random read " + std::to_string(read_size) + " bytes", start);
+  ASSERT_TRUE(random_access_file
+                  ->Read(file_size - large_data.size(), large_data.size(),
+                         &data, &scratch[0])
+                  .ok());
+  ASSERT_TRUE(data == large_data);
+  ASSERT_TRUE(
+      random_access_file->Read(0, append_size, &data, &scratch[0]).ok());
+  ASSERT_TRUE(data == small_data);
+
+  uint64_t size;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numOps; i++) {
+    ASSERT_TRUE(flink_env_->GetFileSize(file_name, &size).ok());
+  }
+  logNanosPerOp("GetFileSize", start);
+  ASSERT_TRUE(size == file_size);
+  ASSERT_TRUE(flink_env_->DeleteFile(file_name).ok());
 }
 
-void EnvFlinkTestSuites::generateFile(const std::string& fileName) {
+void EnvFlinkTestSuites::generateFile(const std::string& fileName,
+                                      const std::string& content) {
   // Generate a file manually
   const std::string prefix = "file:";
   std::string writeFileName = base_path_ + fileName;
@@ -170,7 +575,7 @@ void EnvFlinkTestSuites::generateFile(const std::string& fileName) {
     writeFileName = writeFileName.substr(prefix.size());
   }
   std::ofstream writeFile(writeFileName);
-  writeFile << "Hello World";
+  writeFile << content;
   writeFile.close();
 }
 }  // namespace ROCKSDB_NAMESPACE
\ No newline at end of file
@@ -24,6 +24,8 @@ class EnvFlinkTestSuites {
  public:
   EnvFlinkTestSuites(const std::string& basePath);
   void runAllTestSuites();
+  // Measures the latency of small JNI-bound file operations, numOps each.
+  void runBenchmarks(int numOps);
 
  private:
   std::unique_ptr<ROCKSDB_NAMESPACE::Env> flink_env_;
@@ -33,7 +35,15 @@ class EnvFlinkTestSuites {
   void testFileOperation();
   void testGetChildren();
   void testFileReadAndWrite();
+  void testConcurrentRandomRead();
+  void testLocalFileCache();
+  void testStagedUpload();
+  void testFileStatusCacheAndBatchDelete();
+  void testRemoteReadahead();
+  void testStatistics();
+  void testLinkFileByCopy();
 
-  void generateFile(const std::string& fileName);
+  void generateFile(const std::string& fileName,
+                    const std::string& content = "Hello World");
 };
 }  // namespace ROCKSDB_NAMESPACE
\ No newline at end of file
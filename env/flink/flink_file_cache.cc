@@ -0,0 +1,349 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "env/flink/flink_file_cache.h"
+
+#include <algorithm>
+
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Writes to the remote file and a local copy at the same time. Failures of the
+// local copy are not visible to the caller, the file is just not cached then.
+class FlinkFileCache::CacheWarmingWritableFile
+    : public FSWritableFileOwnerWrapper {
+ public:
+  CacheWarmingWritableFile(FlinkFileCache* cache, const std::string& fname,
+                           std::unique_ptr<FSWritableFile>&& remote_file,
+                           std::unique_ptr<FSWritableFile>&& local_file)
+      : FSWritableFileOwnerWrapper(std::move(remote_file)),
+        cache_(cache),
+        fname_(fname),
+        local_file_(std::move(local_file)),
+        local_size_(0) {}
+
+  ~CacheWarmingWritableFile() override {
+    // Not closed by the caller, the content may be incomplete
+    AbandonLocalFile();
+  }
+
+  IOStatus Append(const Slice& data, const IOOptions& options,
+                  IODebugContext* dbg) override {
+    IOStatus s = target()->Append(data, options, dbg);
+    if (s.ok()) {
+      AppendLocalFile(data, options, dbg);
+    }
+    return s;
+  }
+
+  IOStatus Append(const Slice& data, const IOOptions& options,
+                  const DataVerificationInfo& verification_info,
+                  IODebugContext* dbg) override {
+    IOStatus s = target()->Append(data, options, verification_info, dbg);
+    if (s.ok()) {
+      AppendLocalFile(data, options, dbg);
+    }
+    return s;
+  }
+
+  IOStatus PositionedAppend(const Slice& data, uint64_t offset,
+                            const IOOptions& options,
+                            IODebugContext* dbg) override {
+    // Never used by SST writers, just give up caching
+    AbandonLocalFile();
+    return target()->PositionedAppend(data, offset, options, dbg);
+  }
+
+  IOStatus PositionedAppend(const Slice& data, uint64_t offset,
+                            const IOOptions& options,
+                            const DataVerificationInfo& verification_info,
+                            IODebugContext* dbg) override {
+    AbandonLocalFile();
+    return target()->PositionedAppend(data, offset, options, verification_info,
+                                      dbg);
+  }
+
+  IOStatus Truncate(uint64_t size, const IOOptions& options,
+                    IODebugContext* dbg) override {
+    AbandonLocalFile();
+    return target()->Truncate(size, options, dbg);
+  }
+
+  IOStatus Close(const IOOptions& options, IODebugContext* dbg) override {
+    IOStatus s = target()->Close(options, dbg);
+    if (local_file_ == nullptr) {
+      return s;
+    }
+    bool valid = s.ok() && local_file_->Close(options, dbg).ok();
+    local_file_.reset();
+    cache_->EndInsert(fname_, local_size_, valid);
+    return s;
+  }
+
+ private:
+  FlinkFileCache* cache_;
+  const std::string fname_;
+  std::unique_ptr<FSWritableFile> local_file_;
+  uint64_t local_size_;
+
+  void AppendLocalFile(const Slice& data, const IOOptions& options,
+                       IODebugContext* dbg) {
+    if (local_file_ == nullptr) {
+      return;
+    }
+    local_size_ += data.size();
+    if (local_size_ > cache_->GetCapacity() ||
+        !local_file_->Append(data, options, dbg).ok()) {
+      AbandonLocalFile();
+    }
+  }
+
+  void AbandonLocalFile() {
+    if (local_file_ != nullptr) {
+      local_file_->Close(IOOptions(), nullptr).PermitUncheckedError();
+      local_file_.reset();
+      cache_->EndInsert(fname_, 0, false);
+    }
+  }
+};
+
+FlinkFileCache::FlinkFileCache(const std::shared_ptr<FileSystem>& local_fs,
+                               const std::string& cache_dir, uint64_t capacity)
+    : local_fs_(local_fs),
+      cache_dir_(cache_dir),
+      capacity_(capacity),
+      usage_(0) {}
+
+IOStatus FlinkFileCache::Create(const std::shared_ptr<FileSystem>& local_fs,
+                                const std::string& cache_dir,
+                                uint64_t capacity,
+                                std::unique_ptr<FlinkFileCache>* result) {
+  result->reset();
+  IOStatus s = local_fs->CreateDirIfMissing(cache_dir, IOOptions(), nullptr);
+  if (!s.ok()) {
+    return s;
+  }
+  // The index isn't persisted, so files left by a previous process are
+  // useless
+  std::vector<std::string> children;
+  s = local_fs->GetChildren(cache_dir, IOOptions(), &children, nullptr);
+  if (!s.ok()) {
+    return s;
+  }
+  for (const auto& child : children) {
+    s = local_fs->DeleteFile(cache_dir + "/" + child, IOOptions(), nullptr);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+  result->reset(new FlinkFileCache(local_fs, cache_dir, capacity));
+  return IOStatus::OK();
+}
+
+bool FlinkFileCache::ShouldCache(const std::string& fname) {
+  return Slice(fname).ends_with(".sst");
+}
+
+std::string FlinkFileCache::LocalFileName(const std::string& fname) {
+  std::string local_name;
+  local_name.reserve(fname.size());
+  for (char c : fname) {
+    if (c == '/') {
+      local_name.append("%2F");
+    } else if (c == '%') {
+      local_name.append("%25");
+    } else {
+      local_name.push_back(c);
+    }
+  }
+  return local_name;
+}
+
+std::string FlinkFileCache::LocalPath(const std::string& fname) const {
+  return cache_dir_ + "/" + LocalFileName(fname);
+}
+
+IOStatus FlinkFileCache::NewRandomAccessFile(
+    const std::string& fname, const FileOptions& options,
+    std::unique_ptr<FSRandomAccessFile>* result, IODebugContext* dbg) {
+  {
+    MutexLock lock(&mutex_);
+    auto it = entries_.find(fname);
+    if (it == entries_.end()) {
+      return IOStatus::NotFound();
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru_iter);
+  }
+  // An evicted file may still be opened here since the local file is deleted
+  // outside the lock, it's just a miss then.
+  IOStatus s =
+      local_fs_->NewRandomAccessFile(LocalPath(fname), options, result, dbg);
+  if (!s.ok()) {
+    Erase(fname);
+    return IOStatus::NotFound();
+  }
+  return s;
+}
+
+IOStatus FlinkFileCache::Insert(const std::string& fname,
+                                FSRandomAccessFile* remote_file,
+                                uint64_t file_size, const IOOptions& options,
+                                IODebugContext* dbg) {
+  if (file_size > capacity_) {
+    return IOStatus::NoSpace("File is larger than the cache capacity");
+  }
+  if (!BeginInsert(fname)) {
+    return IOStatus::Busy();
+  }
+
+  std::unique_ptr<FSWritableFile> local_file;
+  IOStatus s = local_fs_->NewWritableFile(LocalPath(fname), FileOptions(),
+                                          &local_file, dbg);
+  const size_t kCopyBufferSize = 1024 * 1024;
+  std::unique_ptr<char[]> buffer(new char[kCopyBufferSize]);
+  uint64_t offset = 0;
+  while (s.ok() && offset < file_size) {
+    size_t n = static_cast<size_t>(
+        std::min(static_cast<uint64_t>(kCopyBufferSize), file_size - offset));
+    Slice data;
+    s = remote_file->Read(offset, n, options, &data, buffer.get(), dbg);
+    if (s.ok() && data.size() != n) {
+      s = IOStatus::Corruption("Remote file is shorter than expected");
+    }
+    if (s.ok()) {
+      s = local_file->Append(data, IOOptions(), dbg);
+    }
+    offset += n;
+  }
+  if (s.ok()) {
+    s = local_file->Close(IOOptions(), dbg);
+  }
+  EndInsert(fname, file_size, s.ok());
+  return s;
+}
+
+void FlinkFileCache::NewWritableFile(
+    const std::string& fname, const FileOptions& options,
+    std::unique_ptr<FSWritableFile>&& remote_file,
+    std::unique_ptr<FSWritableFile>* result, IODebugContext* dbg) {
+  std::unique_ptr<FSWritableFile> local_file;
+  if (BeginInsert(fname)) {
+    if (!local_fs_->NewWritableFile(LocalPath(fname), options, &local_file, dbg)
+             .ok()) {
+      local_file.reset();
+      EndInsert(fname, 0, false);
+    }
+  }
+  if (local_file == nullptr) {
+    *result = std::move(remote_file);
+    return;
+  }
+  result->reset(new CacheWarmingWritableFile(
+      this, fname, std::move(remote_file), std::move(local_file)));
+}
+
+void FlinkFileCache::InsertLocalFile(const std::string& fname,
+                                     const std::string& local_path,
+                                     uint64_t file_size) {
+  if (file_size <= capacity_ && BeginInsert(fname)) {
+    IOStatus s = local_fs_->RenameFile(local_path, LocalPath(fname),
+                                       IOOptions(), nullptr);
+    EndInsert(fname, file_size, s.ok());
+    if (s.ok()) {
+      return;
+    }
+  }
+  local_fs_->DeleteFile(local_path, IOOptions(), nullptr)
+      .PermitUncheckedError();
+}
+
+bool FlinkFileCache::BeginInsert(const std::string& fname) {
+  MutexLock lock(&mutex_);
+  if (entries_.find(fname) != entries_.end() ||
+      pending_.find(fname) != pending_.end()) {
+    return false;
+  }
+  pending_[fname] = false;
+  return true;
+}
+
+void FlinkFileCache::EndInsert(const std::string& fname, uint64_t size,
+                               bool valid) {
+  std::vector<std::string> to_delete;
+  {
+    MutexLock lock(&mutex_);
+    auto pending_it = pending_.find(fname);
+    assert(pending_it != pending_.end());
+    bool erased = pending_it->second;
+    pending_.erase(pending_it);
+    if (!valid || erased || size > capacity_) {
+      to_delete.push_back(fname);
+    } else {
+      lru_.push_front(fname);
+      entries_[fname] = {size, lru_.begin()};
+      usage_ += size;
+      // Evict least recently used files, but never the one just added
+      while (usage_ > capacity_ && lru_.size() > 1) {
+        const std::string& victim = lru_.back();
+        auto it = entries_.find(victim);
+        assert(it != entries_.end());
+        usage_ -= it->second.size;
+        to_delete.push_back(victim);
+        entries_.erase(it);
+        lru_.pop_back();
+      }
+    }
+  }
+  DeleteLocalFiles(to_delete);
+}
+
+void FlinkFileCache::Erase(const std::string& fname) {
+  {
+    MutexLock lock(&mutex_);
+    auto pending_it = pending_.find(fname);
+    if (pending_it != pending_.end()) {
+      // The local file is deleted once the insertion ends
+      pending_it->second = true;
+      return;
+    }
+    auto it = entries_.find(fname);
+    if (it == entries_.end()) {
+      return;
+    }
+    usage_ -= it->second.size;
+    lru_.erase(it->second.lru_iter);
+    entries_.erase(it);
+  }
+  DeleteLocalFiles({fname});
+}
+
+uint64_t FlinkFileCache::GetUsage() const {
+  MutexLock lock(&mutex_);
+  return usage_;
+}
+
+void FlinkFileCache::DeleteLocalFiles(const std::vector<std::string>& fnames) {
+  for (const auto& fname : fnames) {
+    // Open files are still readable after deleted on POSIX file systems
+    local_fs_->DeleteFile(LocalPath(fname), IOOptions(), nullptr)
+        .PermitUncheckedError();
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
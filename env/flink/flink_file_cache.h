@@ -0,0 +1,123 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/file_system.h"
+#include "rocksdb/io_status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A cache of whole remote SST files on a local directory. Files are added when
+// they are written (so freshly flushed or compacted files are warm) or when
+// they are opened for random reads, and evicted in LRU order once the total
+// size exceeds the capacity. The index is kept in memory only, the cache
+// directory is cleared on creation.
+class FlinkFileCache {
+ public:
+  // Create a cache under cache_dir of local_fs with capacity in bytes.
+  static IOStatus Create(const std::shared_ptr<FileSystem>& local_fs,
+                         const std::string& cache_dir, uint64_t capacity,
+                         std::unique_ptr<FlinkFileCache>* result);
+
+  ~FlinkFileCache() = default;
+
+  // Whether the file is a candidate of the cache, only SST files are cached as
+  // they are immutable once written.
+  static bool ShouldCache(const std::string& fname);
+
+  // Encodes the path fname as one local file name. '/' and the escape
+  // character '%' are escaped, so that different paths never collide.
+  static std::string LocalFileName(const std::string& fname);
+
+  // Opens the cached local copy of fname. Returns NotFound if not cached.
+  IOStatus NewRandomAccessFile(const std::string& fname,
+                               const FileOptions& options,
+                               std::unique_ptr<FSRandomAccessFile>* result,
+                               IODebugContext* dbg);
+
+  // Copies file_size bytes from remote_file into the cache. Returns Busy if
+  // fname is being added by another thread, or NoSpace if the file doesn't
+  // fit into the cache.
+  IOStatus Insert(const std::string& fname, FSRandomAccessFile* remote_file,
+                  uint64_t file_size, const IOOptions& options,
+                  IODebugContext* dbg);
+
+  // Wraps the writer of a remote file, so that the content is also written to
+  // a local copy which is added to the cache once the file is closed
+  // successfully.
+  void NewWritableFile(const std::string& fname, const FileOptions& options,
+                       std::unique_ptr<FSWritableFile>&& remote_file,
+                       std::unique_ptr<FSWritableFile>* result,
+                       IODebugContext* dbg);
+
+  // Moves an existing local file of local_fs into the cache as fname. The
+  // local file is deleted if it can't be cached.
+  void InsertLocalFile(const std::string& fname, const std::string& local_path,
+                       uint64_t file_size);
+
+  // Removes fname from the cache, e.g. when the remote file is deleted.
+  void Erase(const std::string& fname);
+
+  uint64_t GetCapacity() const { return capacity_; }
+
+  uint64_t GetUsage() const;
+
+ private:
+  class CacheWarmingWritableFile;
+
+  struct Entry {
+    uint64_t size;
+    std::list<std::string>::iterator lru_iter;
+  };
+
+  const std::shared_ptr<FileSystem> local_fs_;
+  const std::string cache_dir_;
+  const uint64_t capacity_;
+
+  mutable port::Mutex mutex_;
+  // Most recently used first
+  std::list<std::string> lru_;
+  std::unordered_map<std::string, Entry> entries_;
+  // Files being added, mapped to whether they are erased meanwhile
+  std::unordered_map<std::string, bool> pending_;
+  uint64_t usage_;
+
+  FlinkFileCache(const std::shared_ptr<FileSystem>& local_fs,
+                 const std::string& cache_dir, uint64_t capacity);
+
+  std::string LocalPath(const std::string& fname) const;
+
+  // Marks fname as being added. Returns false if it's cached or pending.
+  bool BeginInsert(const std::string& fname);
+
+  // Adds the local copy of fname into the cache, or drops it if it's not valid
+  // or fname was erased while being added.
+  void EndInsert(const std::string& fname, uint64_t size, bool valid);
+
+  void DeleteLocalFiles(const std::vector<std::string>& fnames);
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,222 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "env/flink/flink_file_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "file/file_util.h"
+#include "rocksdb/file_system.h"
+#include "test_util/testharness.h"
+#include "test_util/testutil.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// The "remote" files are just local files in another directory.
+class FlinkFileCacheTest : public testing::Test {
+ public:
+  FlinkFileCacheTest()
+      : fs_(FileSystem::Default()),
+        remote_dir_(test::PerThreadDBPath("flink_file_cache_remote")),
+        cache_dir_(test::PerThreadDBPath("flink_file_cache_local")) {
+    EXPECT_OK(DestroyDir(Env::Default(), remote_dir_));
+    EXPECT_OK(fs_->CreateDirIfMissing(remote_dir_, IOOptions(), nullptr));
+  }
+
+  ~FlinkFileCacheTest() override {
+    EXPECT_OK(DestroyDir(Env::Default(), remote_dir_));
+    EXPECT_OK(DestroyDir(Env::Default(), cache_dir_));
+  }
+
+  void WriteThroughCache(FlinkFileCache* cache, const std::string& fname,
+                         const std::string& content) {
+    std::unique_ptr<FSWritableFile> remote_file, file;
+    ASSERT_OK(fs_->NewWritableFile(remote_dir_ + "/" + fname, FileOptions(),
+                                   &remote_file, nullptr));
+    cache->NewWritableFile(fname, FileOptions(), std::move(remote_file), &file,
+                           nullptr);
+    ASSERT_OK(file->Append(content, IOOptions(), nullptr));
+    ASSERT_OK(file->Close(IOOptions(), nullptr));
+  }
+
+  std::string ReadFromCache(FlinkFileCache* cache, const std::string& fname,
+                            size_t n) {
+    std::unique_ptr<FSRandomAccessFile> file;
+    EXPECT_OK(cache->NewRandomAccessFile(fname, FileOptions(), &file, nullptr));
+    if (file == nullptr) {
+      return "";
+    }
+    std::string scratch(n, '\0');
+    Slice result;
+    EXPECT_OK(file->Read(0, n, IOOptions(), &result, &scratch[0], nullptr));
+    return result.ToString();
+  }
+
+  std::shared_ptr<FileSystem> fs_;
+  const std::string remote_dir_;
+  const std::string cache_dir_;
+};
+
+TEST_F(FlinkFileCacheTest, ShouldCache) {
+  ASSERT_TRUE(FlinkFileCache::ShouldCache("/db/000012.sst"));
+  ASSERT_FALSE(FlinkFileCache::ShouldCache("/db/MANIFEST-000001"));
+  ASSERT_FALSE(FlinkFileCache::ShouldCache("/db/000013.log"));
+}
+
+TEST_F(FlinkFileCacheTest, LocalFileName) {
+  ASSERT_EQ("%2Fdb%2F000012.sst",
+            FlinkFileCache::LocalFileName("/db/000012.sst"));
+  ASSERT_NE(FlinkFileCache::LocalFileName("a/b_c.sst"),
+            FlinkFileCache::LocalFileName("a_b/c.sst"));
+  ASSERT_NE(FlinkFileCache::LocalFileName("a%2Fb.sst"),
+            FlinkFileCache::LocalFileName("a/b.sst"));
+
+  // Paths which only differ in '/' are cached separately
+  std::unique_ptr<FlinkFileCache> cache;
+  ASSERT_OK(FlinkFileCache::Create(fs_, cache_dir_, 1024, &cache));
+  ASSERT_OK(WriteStringToFile(fs_.get(), "first", remote_dir_ + "/first"));
+  ASSERT_OK(WriteStringToFile(fs_.get(), "second", remote_dir_ + "/second"));
+  cache->InsertLocalFile("a/b_c.sst", remote_dir_ + "/first", 5);
+  cache->InsertLocalFile("a_b/c.sst", remote_dir_ + "/second", 6);
+  ASSERT_EQ(11U, cache->GetUsage());
+  ASSERT_EQ("first", ReadFromCache(cache.get(), "a/b_c.sst", 5));
+  ASSERT_EQ("second", ReadFromCache(cache.get(), "a_b/c.sst", 6));
+}
+
+TEST_F(FlinkFileCacheTest, WarmUpOnWrite) {
+  std::unique_ptr<FlinkFileCache> cache;
+  ASSERT_OK(FlinkFileCache::Create(fs_, cache_dir_, 1024, &cache));
+
+  WriteThroughCache(cache.get(), "000001.sst", "value1");
+  ASSERT_EQ(6U, cache->GetUsage());
+  ASSERT_EQ("value1", ReadFromCache(cache.get(), "000001.sst", 6));
+
+  // The remote file is written as well
+  uint64_t size;
+  ASSERT_OK(fs_->GetFileSize(remote_dir_ + "/000001.sst", IOOptions(), &size,
+                             nullptr));
+  ASSERT_EQ(6U, size);
+
+  // Files larger than the capacity are not cached
+  WriteThroughCache(cache.get(), "000002.sst", std::string(2048, 'v'));
+  ASSERT_EQ(6U, cache->GetUsage());
+  std::unique_ptr<FSRandomAccessFile> file;
+  ASSERT_TRUE(
+      cache->NewRandomAccessFile("000002.sst", FileOptions(), &file, nullptr)
+          .IsNotFound());
+}
+
+TEST_F(FlinkFileCacheTest, InsertAndErase) {
+  std::unique_ptr<FlinkFileCache> cache;
+  ASSERT_OK(FlinkFileCache::Create(fs_, cache_dir_, 1024, &cache));
+
+  const std::string content = "remote content";
+  ASSERT_OK(WriteStringToFile(fs_.get(), content,
+                              remote_dir_ + "/000003.sst"));
+  std::unique_ptr<FSRandomAccessFile> remote_file;
+  ASSERT_OK(fs_->NewRandomAccessFile(remote_dir_ + "/000003.sst",
+                                     FileOptions(), &remote_file, nullptr));
+  ASSERT_OK(cache->Insert("000003.sst", remote_file.get(), content.size(),
+                          IOOptions(), nullptr));
+  ASSERT_EQ(content.size(), cache->GetUsage());
+  ASSERT_EQ(content, ReadFromCache(cache.get(), "000003.sst", content.size()));
+
+  // Already cached
+  ASSERT_TRUE(cache
+                  ->Insert("000003.sst", remote_file.get(), content.size(),
+                           IOOptions(), nullptr)
+                  .IsBusy());
+
+  cache->Erase("000003.sst");
+  ASSERT_EQ(0U, cache->GetUsage());
+  std::unique_ptr<FSRandomAccessFile> file;
+  ASSERT_TRUE(
+      cache->NewRandomAccessFile("000003.sst", FileOptions(), &file, nullptr)
+          .IsNotFound());
+}
+
+TEST_F(FlinkFileCacheTest, InsertLocalFile) {
+  std::unique_ptr<FlinkFileCache> cache;
+  ASSERT_OK(FlinkFileCache::Create(fs_, cache_dir_, 1024, &cache));
+
+  const std::string local_path = remote_dir_ + "/staged";
+  ASSERT_OK(WriteStringToFile(fs_.get(), "staged", local_path));
+  cache->InsertLocalFile("000005.sst", local_path, 6);
+  ASSERT_EQ(6U, cache->GetUsage());
+  ASSERT_EQ("staged", ReadFromCache(cache.get(), "000005.sst", 6));
+  // Moved into the cache
+  ASSERT_TRUE(fs_->FileExists(local_path, IOOptions(), nullptr).IsNotFound());
+
+  // Dropped if it doesn't fit
+  ASSERT_OK(WriteStringToFile(fs_.get(), std::string(2048, 'v'), local_path));
+  cache->InsertLocalFile("000006.sst", local_path, 2048);
+  ASSERT_EQ(6U, cache->GetUsage());
+  ASSERT_TRUE(fs_->FileExists(local_path, IOOptions(), nullptr).IsNotFound());
+}
+
+TEST_F(FlinkFileCacheTest, EvictLeastRecentlyUsed) {
+  std::unique_ptr<FlinkFileCache> cache;
+  ASSERT_OK(FlinkFileCache::Create(fs_, cache_dir_, 300, &cache));
+
+  WriteThroughCache(cache.get(), "000001.sst", std::string(100, '1'));
+  WriteThroughCache(cache.get(), "000002.sst", std::string(100, '2'));
+  WriteThroughCache(cache.get(), "000003.sst", std::string(100, '3'));
+  ASSERT_EQ(300U, cache->GetUsage());
+
+  // Touch the first file so the second one becomes the least recently used
+  ASSERT_EQ(std::string(100, '1'),
+            ReadFromCache(cache.get(), "000001.sst", 100));
+  WriteThroughCache(cache.get(), "000004.sst", std::string(100, '4'));
+  ASSERT_EQ(300U, cache->GetUsage());
+
+  std::unique_ptr<FSRandomAccessFile> file;
+  ASSERT_TRUE(
+      cache->NewRandomAccessFile("000002.sst", FileOptions(), &file, nullptr)
+          .IsNotFound());
+  ASSERT_OK(
+      cache->NewRandomAccessFile("000001.sst", FileOptions(), &file, nullptr));
+  ASSERT_OK(
+      cache->NewRandomAccessFile("000004.sst", FileOptions(), &file, nullptr));
+}
+
+TEST_F(FlinkFileCacheTest, UnclosedFileNotCached) {
+  std::unique_ptr<FlinkFileCache> cache;
+  ASSERT_OK(FlinkFileCache::Create(fs_, cache_dir_, 1024, &cache));
+  {
+    std::unique_ptr<FSWritableFile> remote_file, file;
+    ASSERT_OK(fs_->NewWritableFile(remote_dir_ + "/000001.sst", FileOptions(),
+                                   &remote_file, nullptr));
+    cache->NewWritableFile("000001.sst", FileOptions(), std::move(remote_file),
+                           &file, nullptr);
+    ASSERT_OK(file->Append("partial", IOOptions(), nullptr));
+  }
+  ASSERT_EQ(0U, cache->GetUsage());
+  std::unique_ptr<FSRandomAccessFile> file;
+  ASSERT_TRUE(
+      cache->NewRandomAccessFile("000001.sst", FileOptions(), &file, nullptr)
+          .IsNotFound());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "env/flink/flink_file_status_cache.h"
+
+#include <iterator>
+
+#include "rocksdb/slice.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+std::string FlinkFileStatusCache::ParentDir(const std::string& path) {
+  size_t pos = path.find_last_of('/');
+  return pos == std::string::npos ? "" : path.substr(0, pos);
+}
+
+uint64_t FlinkFileStatusCache::GetDirVersion(const std::string& dir) const {
+  MutexLock lock(&mutex_);
+  auto it = dir_versions_.find(dir);
+  return it == dir_versions_.end() ? 0 : it->second;
+}
+
+bool FlinkFileStatusCache::IsDirVersion(const std::string& dir,
+                                        uint64_t dir_version) const {
+  mutex_.AssertHeld();
+  auto it = dir_versions_.find(dir);
+  return (it == dir_versions_.end() ? 0 : it->second) == dir_version;
+}
+
+void FlinkFileStatusCache::BumpDirVersion(const std::string& dir) {
+  mutex_.AssertHeld();
+  dir_versions_[dir]++;
+}
+
+void FlinkFileStatusCache::AddChildren(
+    const std::string& dir, uint64_t dir_version,
+    const std::vector<std::pair<std::string, FileStatus>>& children) {
+  MutexLock lock(&mutex_);
+  if (!IsDirVersion(dir, dir_version)) {
+    return;
+  }
+  for (const auto& child : children) {
+    if (writing_.find(child.first) == writing_.end()) {
+      entries_[child.first] = {child.second, true};
+    }
+  }
+  listed_dirs_.insert(dir);
+}
+
+void FlinkFileStatusCache::Add(const std::string& path, uint64_t dir_version,
+                               const FileStatus& status) {
+  MutexLock lock(&mutex_);
+  if (IsDirVersion(ParentDir(path), dir_version) &&
+      writing_.find(path) == writing_.end()) {
+    entries_[path] = {status, true};
+  }
+}
+
+FlinkFileStatusCache::LookupResult FlinkFileStatusCache::Lookup(
+    const std::string& path, FileStatus* status) const {
+  MutexLock lock(&mutex_);
+  if (writing_.find(path) != writing_.end()) {
+    return LookupResult::kUnknown;
+  }
+  auto it = entries_.find(path);
+  if (it != entries_.end()) {
+    if (!it->second.has_status) {
+      return LookupResult::kExists;
+    }
+    *status = it->second.status;
+    return LookupResult::kFound;
+  }
+  return listed_dirs_.find(ParentDir(path)) != listed_dirs_.end()
+             ? LookupResult::kNotFound
+             : LookupResult::kUnknown;
+}
+
+void FlinkFileStatusCache::BeginWrite(const std::string& path) {
+  MutexLock lock(&mutex_);
+  writing_[path]++;
+  entries_.erase(path);
+  BumpDirVersion(ParentDir(path));
+}
+
+void FlinkFileStatusCache::EndWrite(const std::string& path, bool created) {
+  MutexLock lock(&mutex_);
+  auto it = writing_.find(path);
+  assert(it != writing_.end());
+  if (--it->second == 0) {
+    writing_.erase(it);
+  }
+  if (created) {
+    // The size is only known by another remote call, but the listing of the
+    // directory is still complete
+    entries_[path] = {FileStatus(), false};
+  } else {
+    entries_.erase(path);
+    listed_dirs_.erase(ParentDir(path));
+  }
+  BumpDirVersion(ParentDir(path));
+}
+
+void FlinkFileStatusCache::Remove(const std::string& path) {
+  MutexLock lock(&mutex_);
+  entries_.erase(path);
+  BumpDirVersion(ParentDir(path));
+  // A directory created again has no listing
+  listed_dirs_.erase(path);
+}
+
+void FlinkFileStatusCache::Invalidate(const std::string& path) {
+  MutexLock lock(&mutex_);
+  entries_.erase(path);
+  listed_dirs_.erase(ParentDir(path));
+  BumpDirVersion(ParentDir(path));
+}
+
+void FlinkFileStatusCache::InvalidateDir(const std::string& dir) {
+  MutexLock lock(&mutex_);
+  const std::string prefix = dir + "/";
+  auto isUnderDir = [&dir, &prefix](const std::string& path) {
+    return path == dir || Slice(path).starts_with(prefix);
+  };
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    it = isUnderDir(it->first) ? entries_.erase(it) : std::next(it);
+  }
+  for (auto it = listed_dirs_.begin(); it != listed_dirs_.end();) {
+    it = isUnderDir(*it) ? listed_dirs_.erase(it) : std::next(it);
+  }
+  for (auto& dirVersion : dir_versions_) {
+    if (isUnderDir(dirVersion.first)) {
+      dirVersion.second++;
+    }
+  }
+  listed_dirs_.erase(ParentDir(dir));
+  BumpDirVersion(ParentDir(dir));
+}
+
+}  // namespace ROCKSDB_NAMESPACE
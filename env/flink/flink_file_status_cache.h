@@ -0,0 +1,105 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "port/port.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Caches the metadata of remote files, mostly from directory listings, so that
+// following FileExists/GetFileSize/... calls don't need a remote round-trip.
+// Files missing in a listed directory are known to be not found as well.
+//
+// Paths are full remote paths without trailing slashes. It's only correct if
+// all the modifications go through the owner, which reports them here after
+// they are done. Results of remote calls are only added if their directory is
+// not modified meanwhile, which is checked by the version of the directory
+// taken before the call.
+class FlinkFileStatusCache {
+ public:
+  struct FileStatus {
+    uint64_t size = 0;
+    uint64_t modification_time = 0;
+    bool is_dir = false;
+  };
+
+  enum class LookupResult {
+    kUnknown,
+    kNotFound,
+    // Exists, but the status is unknown
+    kExists,
+    kFound,
+  };
+
+  FlinkFileStatusCache() = default;
+
+  uint64_t GetDirVersion(const std::string& dir) const;
+
+  // Adds the listing of dir, children are pairs of full paths and statuses.
+  void AddChildren(
+      const std::string& dir, uint64_t dir_version,
+      const std::vector<std::pair<std::string, FileStatus>>& children);
+
+  // Adds the status of one path, dir_version is of its parent.
+  void Add(const std::string& path, uint64_t dir_version,
+           const FileStatus& status);
+
+  LookupResult Lookup(const std::string& path, FileStatus* status) const;
+
+  // A file being written changes its size, so it's not cached in between.
+  void BeginWrite(const std::string& path);
+  // created is false if the file failed to be created
+  void EndWrite(const std::string& path, bool created);
+
+  // The path is deleted.
+  void Remove(const std::string& path);
+
+  // The path is modified in an unknown way.
+  void Invalidate(const std::string& path);
+
+  // The directory is modified recursively in an unknown way.
+  void InvalidateDir(const std::string& dir);
+
+  static std::string ParentDir(const std::string& path);
+
+ private:
+  struct Entry {
+    FileStatus status;
+    bool has_status;
+  };
+
+  mutable port::Mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  // Directories whose all children are in entries_
+  std::unordered_set<std::string> listed_dirs_;
+  std::unordered_map<std::string, uint64_t> dir_versions_;
+  std::unordered_map<std::string, int> writing_;
+
+  // REQUIRES: mutex_ held
+  void BumpDirVersion(const std::string& dir);
+  bool IsDirVersion(const std::string& dir, uint64_t dir_version) const;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,140 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "env/flink/flink_file_status_cache.h"
+
+#include "test_util/testharness.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+using LookupResult = FlinkFileStatusCache::LookupResult;
+
+class FlinkFileStatusCacheTest : public testing::Test {
+ public:
+  static FlinkFileStatusCache::FileStatus FileOfSize(uint64_t size) {
+    FlinkFileStatusCache::FileStatus status;
+    status.size = size;
+    status.modification_time = 1000;
+    return status;
+  }
+
+  void ListDb(FlinkFileStatusCache* cache) {
+    cache->AddChildren("s3://bucket/db", cache->GetDirVersion("s3://bucket/db"),
+                       {{"s3://bucket/db/000001.sst", FileOfSize(10)},
+                        {"s3://bucket/db/MANIFEST-000002", FileOfSize(20)}});
+  }
+
+  LookupResult Lookup(FlinkFileStatusCache* cache, const std::string& path,
+                      uint64_t* size = nullptr) {
+    FlinkFileStatusCache::FileStatus status;
+    LookupResult result = cache->Lookup(path, &status);
+    if (size != nullptr) {
+      *size = status.size;
+    }
+    return result;
+  }
+};
+
+TEST_F(FlinkFileStatusCacheTest, Listing) {
+  FlinkFileStatusCache cache;
+  ASSERT_EQ(LookupResult::kUnknown,
+            Lookup(&cache, "s3://bucket/db/000001.sst"));
+
+  ListDb(&cache);
+  uint64_t size;
+  ASSERT_EQ(LookupResult::kFound,
+            Lookup(&cache, "s3://bucket/db/000001.sst", &size));
+  ASSERT_EQ(10U, size);
+  ASSERT_EQ(LookupResult::kNotFound,
+            Lookup(&cache, "s3://bucket/db/000003.sst"));
+  // Other directories are not listed
+  ASSERT_EQ(LookupResult::kUnknown,
+            Lookup(&cache, "s3://bucket/other/000001.sst"));
+  ASSERT_EQ(LookupResult::kUnknown, Lookup(&cache, "s3://bucket/db/sub/x"));
+}
+
+TEST_F(FlinkFileStatusCacheTest, Write) {
+  FlinkFileStatusCache cache;
+  ListDb(&cache);
+
+  cache.BeginWrite("s3://bucket/db/000003.sst");
+  ASSERT_EQ(LookupResult::kUnknown,
+            Lookup(&cache, "s3://bucket/db/000003.sst"));
+  cache.EndWrite("s3://bucket/db/000003.sst", true);
+  ASSERT_EQ(LookupResult::kExists, Lookup(&cache, "s3://bucket/db/000003.sst"));
+  // The listing is still complete
+  ASSERT_EQ(LookupResult::kNotFound,
+            Lookup(&cache, "s3://bucket/db/000004.sst"));
+
+  cache.BeginWrite("s3://bucket/db/000004.sst");
+  cache.EndWrite("s3://bucket/db/000004.sst", false);
+  ASSERT_EQ(LookupResult::kUnknown,
+            Lookup(&cache, "s3://bucket/db/000004.sst"));
+}
+
+TEST_F(FlinkFileStatusCacheTest, StaleResultsIgnored) {
+  FlinkFileStatusCache cache;
+  uint64_t dir_version = cache.GetDirVersion("s3://bucket/db");
+  // Modified while being listed
+  cache.BeginWrite("s3://bucket/db/000003.sst");
+  cache.EndWrite("s3://bucket/db/000003.sst", true);
+  cache.AddChildren("s3://bucket/db", dir_version,
+                    {{"s3://bucket/db/000001.sst", FileOfSize(10)}});
+  ASSERT_EQ(LookupResult::kUnknown,
+            Lookup(&cache, "s3://bucket/db/000001.sst"));
+  ASSERT_EQ(LookupResult::kUnknown,
+            Lookup(&cache, "s3://bucket/db/000004.sst"));
+
+  dir_version = cache.GetDirVersion("s3://bucket/db");
+  cache.Add("s3://bucket/db/000001.sst", dir_version, FileOfSize(10));
+  ASSERT_EQ(LookupResult::kFound, Lookup(&cache, "s3://bucket/db/000001.sst"));
+  cache.Remove("s3://bucket/db/000001.sst");
+  cache.Add("s3://bucket/db/000001.sst", dir_version, FileOfSize(10));
+  ASSERT_EQ(LookupResult::kUnknown,
+            Lookup(&cache, "s3://bucket/db/000001.sst"));
+}
+
+TEST_F(FlinkFileStatusCacheTest, RemoveAndInvalidate) {
+  FlinkFileStatusCache cache;
+  ListDb(&cache);
+
+  cache.Remove("s3://bucket/db/000001.sst");
+  ASSERT_EQ(LookupResult::kNotFound,
+            Lookup(&cache, "s3://bucket/db/000001.sst"));
+
+  cache.Invalidate("s3://bucket/db/MANIFEST-000002");
+  ASSERT_EQ(LookupResult::kUnknown,
+            Lookup(&cache, "s3://bucket/db/MANIFEST-000002"));
+  ASSERT_EQ(LookupResult::kUnknown,
+            Lookup(&cache, "s3://bucket/db/000001.sst"));
+
+  ListDb(&cache);
+  cache.InvalidateDir("s3://bucket/db");
+  ASSERT_EQ(LookupResult::kUnknown,
+            Lookup(&cache, "s3://bucket/db/000001.sst"));
+  ASSERT_EQ(LookupResult::kUnknown,
+            Lookup(&cache, "s3://bucket/db/000003.sst"));
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
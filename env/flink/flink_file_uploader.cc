@@ -0,0 +1,180 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "env/flink/flink_file_uploader.h"
+
+#include <algorithm>
+
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+FlinkFileUploader::FlinkFileUploader(size_t num_threads,
+                                     UploadFunction upload_function,
+                                     FinishFunction finish_function)
+    : upload_function_(std::move(upload_function)),
+      finish_function_(std::move(finish_function)),
+      work_cv_(&mutex_),
+      done_cv_(&mutex_),
+      closing_(false) {
+  for (size_t i = 0; i < std::max(num_threads, size_t{1}); i++) {
+    threads_.emplace_back([this]() { BackgroundUpload(); });
+  }
+}
+
+FlinkFileUploader::~FlinkFileUploader() {
+  {
+    MutexLock lock(&mutex_);
+    closing_ = true;
+    work_cv_.SignalAll();
+  }
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+  // The local files of failed uploads are deleted on the next start
+  for (auto& p : pending_) {
+    p.second.status.PermitUncheckedError();
+  }
+}
+
+void FlinkFileUploader::Schedule(const std::string& fname,
+                                 const std::string& local_path,
+                                 uint64_t size) {
+  MutexLock lock(&mutex_);
+  assert(!closing_);
+  assert(pending_.find(fname) == pending_.end());
+  pending_[fname] = {local_path, size, false, false, IOStatus::OK()};
+  queue_.push_back(fname);
+  work_cv_.Signal();
+}
+
+bool FlinkFileUploader::GetPending(const std::string& fname,
+                                   std::string* local_path,
+                                   uint64_t* size) const {
+  MutexLock lock(&mutex_);
+  auto it = pending_.find(fname);
+  if (it == pending_.end()) {
+    return false;
+  }
+  *local_path = it->second.local_path;
+  *size = it->second.size;
+  return true;
+}
+
+bool FlinkFileUploader::Cancel(const std::string& fname) {
+  Task task;
+  {
+    MutexLock lock(&mutex_);
+    auto it = pending_.find(fname);
+    if (it == pending_.end() || (it->second.started && !it->second.failed)) {
+      return false;
+    }
+    task = it->second;
+    task.status.PermitUncheckedError();
+    pending_.erase(it);
+    if (!task.started) {
+      queue_.erase(std::find(queue_.begin(), queue_.end(), fname));
+    }
+    done_cv_.SignalAll();
+  }
+  finish_function_(fname, task.local_path, task.size, IOStatus::Aborted());
+  return !task.started;
+}
+
+IOStatus FlinkFileUploader::Wait(const std::string& fname) {
+  MutexLock lock(&mutex_);
+  while (true) {
+    auto it = pending_.find(fname);
+    if (it == pending_.end()) {
+      return IOStatus::OK();
+    }
+    if (it->second.failed) {
+      return it->second.status;
+    }
+    done_cv_.Wait();
+  }
+}
+
+IOStatus FlinkFileUploader::WaitAll() {
+  std::vector<std::string> fnames;
+  {
+    MutexLock lock(&mutex_);
+    fnames.reserve(pending_.size());
+    for (const auto& p : pending_) {
+      fnames.push_back(p.first);
+    }
+  }
+  IOStatus status;
+  for (const auto& fname : fnames) {
+    IOStatus s = Wait(fname);
+    if (status.ok()) {
+      status = s;
+    } else {
+      s.PermitUncheckedError();
+    }
+  }
+  return status;
+}
+
+size_t FlinkFileUploader::NumPending() const {
+  MutexLock lock(&mutex_);
+  return pending_.size();
+}
+
+void FlinkFileUploader::BackgroundUpload() {
+  while (true) {
+    std::string fname;
+    Task task;
+    {
+      MutexLock lock(&mutex_);
+      while (queue_.empty() && !closing_) {
+        work_cv_.Wait();
+      }
+      if (queue_.empty()) {
+        return;
+      }
+      fname = queue_.front();
+      queue_.pop_front();
+      auto it = pending_.find(fname);
+      assert(it != pending_.end());
+      it->second.started = true;
+      task = it->second;
+    }
+
+    IOStatus s = upload_function_(fname, task.local_path);
+    if (s.ok()) {
+      // Finish before leaving the pending state, so the file is always
+      // available either from the local file or after the finish
+      finish_function_(fname, task.local_path, task.size, s);
+    }
+
+    MutexLock lock(&mutex_);
+    auto it = pending_.find(fname);
+    assert(it != pending_.end());
+    if (s.ok()) {
+      pending_.erase(it);
+    } else {
+      // The local file is kept, as the only copy of the file
+      it->second.failed = true;
+      it->second.status = s;
+    }
+    done_cv_.SignalAll();
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,100 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/io_status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Uploads files written to a local staging directory to the remote file system
+// by a fixed number of background threads. A file is pending from Schedule()
+// until its upload succeeds, and should be served from the local file
+// meanwhile. A file whose upload failed stays pending with its local file,
+// until cancelled.
+class FlinkFileUploader {
+ public:
+  // Uploads the local file as the remote file fname.
+  using UploadFunction = std::function<IOStatus(
+      const std::string& fname, const std::string& local_path)>;
+  // Called once the upload of fname succeeded or is cancelled, it's
+  // responsible for the local file afterwards.
+  using FinishFunction =
+      std::function<void(const std::string& fname,
+                         const std::string& local_path, uint64_t size,
+                         const IOStatus& status)>;
+
+  FlinkFileUploader(size_t num_threads, UploadFunction upload_function,
+                    FinishFunction finish_function);
+
+  // Uploads all the scheduled files before returning.
+  ~FlinkFileUploader();
+
+  void Schedule(const std::string& fname, const std::string& local_path,
+                uint64_t size);
+
+  // Returns true with the local file of fname if it's pending.
+  bool GetPending(const std::string& fname, std::string* local_path,
+                  uint64_t* size) const;
+
+  // Cancels the upload of fname if it's not started yet, or drops it if it
+  // failed. Returns true if cancelled before started, i.e. the remote file
+  // was never created.
+  bool Cancel(const std::string& fname);
+
+  // Waits until the upload of fname is not running or queued, and returns
+  // its status, OK if fname is not pending.
+  IOStatus Wait(const std::string& fname);
+
+  // Waits for the uploads scheduled before the call as Wait(), and returns
+  // the status of a failed one, if any.
+  IOStatus WaitAll();
+
+  size_t NumPending() const;
+
+ private:
+  struct Task {
+    std::string local_path;
+    uint64_t size;
+    bool started;
+    bool failed;
+    IOStatus status;
+  };
+
+  const UploadFunction upload_function_;
+  const FinishFunction finish_function_;
+
+  mutable port::Mutex mutex_;
+  port::CondVar work_cv_;
+  port::CondVar done_cv_;
+  std::deque<std::string> queue_;
+  std::unordered_map<std::string, Task> pending_;
+  bool closing_;
+  std::vector<port::Thread> threads_;
+
+  void BackgroundUpload();
+};
+
+}  // namespace ROCKSDB_NAMESPACE
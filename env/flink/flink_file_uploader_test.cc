@@ -0,0 +1,170 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "env/flink/flink_file_uploader.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "port/port.h"
+#include "test_util/testharness.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Uploads are recorded in memory, and blocked until unblocked by the test.
+class FlinkFileUploaderTest : public testing::Test {
+ public:
+  FlinkFileUploaderTest() : cv_(&mutex_), blocked_(false) {}
+
+  std::unique_ptr<FlinkFileUploader> NewUploader(size_t num_threads) {
+    return std::unique_ptr<FlinkFileUploader>(new FlinkFileUploader(
+        num_threads,
+        [this](const std::string& fname, const std::string& local_path) {
+          MutexLock lock(&mutex_);
+          while (blocked_) {
+            cv_.Wait();
+          }
+          if (local_path == "bad") {
+            return IOStatus::IOError("Upload failed");
+          }
+          uploaded_[fname] = local_path;
+          return IOStatus::OK();
+        },
+        [this](const std::string& fname, const std::string& /*local_path*/,
+               uint64_t /*size*/, const IOStatus& status) {
+          MutexLock lock(&mutex_);
+          finished_[fname] = status;
+        }));
+  }
+
+  void Block() {
+    MutexLock lock(&mutex_);
+    blocked_ = true;
+  }
+
+  void Unblock() {
+    MutexLock lock(&mutex_);
+    blocked_ = false;
+    cv_.SignalAll();
+  }
+
+  port::Mutex mutex_;
+  port::CondVar cv_;
+  bool blocked_;
+  std::map<std::string, std::string> uploaded_;
+  std::map<std::string, IOStatus> finished_;
+};
+
+TEST_F(FlinkFileUploaderTest, UploadAndWait) {
+  auto uploader = NewUploader(2);
+  Block();
+  uploader->Schedule("000001.sst", "local1", 10);
+  uploader->Schedule("000002.sst", "local2", 20);
+
+  std::string local_path;
+  uint64_t size;
+  ASSERT_TRUE(uploader->GetPending("000002.sst", &local_path, &size));
+  ASSERT_EQ("local2", local_path);
+  ASSERT_EQ(20U, size);
+  ASSERT_FALSE(uploader->GetPending("000003.sst", &local_path, &size));
+
+  Unblock();
+  ASSERT_OK(uploader->Wait("000001.sst"));
+  ASSERT_OK(uploader->Wait("000002.sst"));
+  ASSERT_EQ(0U, uploader->NumPending());
+  ASSERT_EQ("local1", uploaded_["000001.sst"]);
+  ASSERT_EQ("local2", uploaded_["000002.sst"]);
+  ASSERT_OK(finished_["000001.sst"]);
+  ASSERT_OK(finished_["000002.sst"]);
+}
+
+TEST_F(FlinkFileUploaderTest, ReportErrorPerFile) {
+  auto uploader = NewUploader(1);
+  uploader->Schedule("000001.sst", "bad", 10);
+  uploader->Schedule("000002.sst", "local2", 10);
+  ASSERT_TRUE(uploader->Wait("000001.sst").IsIOError());
+  ASSERT_OK(uploader->Wait("000002.sst"));
+  ASSERT_OK(finished_["000002.sst"]);
+
+  // The failed file is kept pending with its local file until cancelled
+  ASSERT_TRUE(uploader->Wait("000001.sst").IsIOError());
+  ASSERT_EQ(0U, finished_.count("000001.sst"));
+  std::string local_path;
+  uint64_t size;
+  ASSERT_TRUE(uploader->GetPending("000001.sst", &local_path, &size));
+  ASSERT_EQ("bad", local_path);
+
+  ASSERT_FALSE(uploader->Cancel("000001.sst"));
+  ASSERT_TRUE(finished_["000001.sst"].IsAborted());
+  ASSERT_OK(uploader->Wait("000001.sst"));
+  ASSERT_EQ(0U, uploader->NumPending());
+}
+
+TEST_F(FlinkFileUploaderTest, WaitAll) {
+  auto uploader = NewUploader(2);
+  ASSERT_OK(uploader->WaitAll());
+  uploader->Schedule("000001.sst", "local1", 10);
+  uploader->Schedule("000002.sst", "bad", 10);
+  uploader->Schedule("000003.sst", "local3", 10);
+  ASSERT_TRUE(uploader->WaitAll().IsIOError());
+  ASSERT_EQ(2U, uploaded_.size());
+  ASSERT_EQ(1U, uploader->NumPending());
+
+  // Until the failed file is dropped
+  ASSERT_TRUE(uploader->WaitAll().IsIOError());
+  uploader->Cancel("000002.sst");
+  ASSERT_OK(uploader->WaitAll());
+}
+
+TEST_F(FlinkFileUploaderTest, CancelQueued) {
+  auto uploader = NewUploader(1);
+  Block();
+  uploader->Schedule("000001.sst", "local1", 10);
+  uploader->Schedule("000002.sst", "local2", 10);
+
+  // The only thread is blocked by the first file, so the second one is
+  // still queued
+  ASSERT_TRUE(uploader->Cancel("000002.sst"));
+  ASSERT_TRUE(finished_["000002.sst"].IsAborted());
+  ASSERT_FALSE(uploader->Cancel("000003.sst"));
+
+  Unblock();
+  ASSERT_OK(uploader->Wait("000001.sst"));
+  ASSERT_FALSE(uploader->Cancel("000001.sst"));
+  ASSERT_EQ(1U, uploaded_.size());
+  ASSERT_EQ("local1", uploaded_["000001.sst"]);
+}
+
+TEST_F(FlinkFileUploaderTest, UploadAllOnDestruction) {
+  auto uploader = NewUploader(1);
+  for (int i = 0; i < 10; i++) {
+    uploader->Schedule(std::to_string(i) + ".sst", "local", 10);
+  }
+  uploader.reset();
+  ASSERT_EQ(10U, uploaded_.size());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,106 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "env/flink/flink_readahead_policy.h"
+
+#include <algorithm>
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// Weight of a new sample is 1/8
+uint64_t UpdateAverage(uint64_t average, uint64_t sample) {
+  return average == 0 ? sample : average - average / 8 + sample / 8;
+}
+}  // namespace
+
+FlinkReadaheadPolicy::FlinkReadaheadPolicy(size_t min_readahead_size,
+                                           size_t max_readahead_size,
+                                           size_t max_memory)
+    : min_readahead_size_(std::min(min_readahead_size, max_readahead_size)),
+      max_readahead_size_(max_readahead_size),
+      max_memory_(max_memory),
+      latency_micros_(0),
+      bytes_per_second_(0),
+      memory_usage_(0) {}
+
+void FlinkReadaheadPolicy::RecordRead(size_t n, uint64_t micros) {
+  micros = std::max(micros, uint64_t{1});
+  uint64_t latency = latency_micros_.load(std::memory_order_relaxed);
+  if (n <= kSmallReadSize) {
+    latency_micros_.store(UpdateAverage(latency, micros),
+                          std::memory_order_relaxed);
+    return;
+  }
+  // The latency part of the time is not known without small reads
+  if (latency == 0) {
+    return;
+  }
+  uint64_t transferMicros = micros > latency ? micros - latency : 1;
+  uint64_t throughput =
+      static_cast<uint64_t>(static_cast<double>(n) * 1000000 / transferMicros);
+  bytes_per_second_.store(
+      UpdateAverage(bytes_per_second_.load(std::memory_order_relaxed),
+                    throughput),
+      std::memory_order_relaxed);
+}
+
+size_t FlinkReadaheadPolicy::GetReadaheadSize(size_t n) const {
+  uint64_t latency = latency_micros_.load(std::memory_order_relaxed);
+  uint64_t throughput = bytes_per_second_.load(std::memory_order_relaxed);
+  size_t readaheadSize = min_readahead_size_;
+  if (latency > 0 && throughput > 0) {
+    double bandwidthDelayProduct =
+        static_cast<double>(throughput) * static_cast<double>(latency) /
+        1000000;
+    readaheadSize = static_cast<size_t>(
+        std::min(2 * bandwidthDelayProduct,
+                 static_cast<double>(max_readahead_size_)));
+    readaheadSize = std::max(readaheadSize, min_readahead_size_);
+  }
+  return std::max(readaheadSize, n);
+}
+
+uint64_t FlinkReadaheadPolicy::GetLatencyMicros() const {
+  return latency_micros_.load(std::memory_order_relaxed);
+}
+
+uint64_t FlinkReadaheadPolicy::GetBytesPerSecond() const {
+  return bytes_per_second_.load(std::memory_order_relaxed);
+}
+
+bool FlinkReadaheadPolicy::ReserveMemory(size_t n) {
+  size_t usage = memory_usage_.load(std::memory_order_relaxed);
+  do {
+    if (usage + n > max_memory_) {
+      return false;
+    }
+  } while (!memory_usage_.compare_exchange_weak(usage, usage + n,
+                                                std::memory_order_relaxed));
+  return true;
+}
+
+void FlinkReadaheadPolicy::ReleaseMemory(size_t n) {
+  memory_usage_.fetch_sub(n, std::memory_order_relaxed);
+}
+
+size_t FlinkReadaheadPolicy::GetMemoryUsage() const {
+  return memory_usage_.load(std::memory_order_relaxed);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
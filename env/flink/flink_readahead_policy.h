@@ -0,0 +1,72 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "rocksdb/rocksdb_namespace.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Sizes the readahead of remote files by the observed cost of remote reads.
+// A remote read costs a fixed latency per request plus the transfer time, so
+// the readahead is sized to take about as long to transfer as the latency,
+// i.e. twice the bandwidth-delay product, which keeps the fixed cost below
+// half of the total. The latency is learned from small reads and the
+// throughput from large reads.
+//
+// It also limits the total memory of readahead buffers of all the files.
+class FlinkReadaheadPolicy {
+ public:
+  // Reads up to this size are dominated by the latency.
+  static constexpr size_t kSmallReadSize = 64 * 1024;
+
+  FlinkReadaheadPolicy(size_t min_readahead_size, size_t max_readahead_size,
+                       size_t max_memory);
+
+  // Records a remote read of n bytes that took micros.
+  void RecordRead(size_t n, uint64_t micros);
+
+  // Returns the readahead size for a prefetch of n bytes, which is no smaller
+  // than n.
+  size_t GetReadaheadSize(size_t n) const;
+
+  // 0 if not learned yet
+  uint64_t GetLatencyMicros() const;
+  uint64_t GetBytesPerSecond() const;
+
+  // Reserves memory of a readahead buffer, returns false if over the limit.
+  bool ReserveMemory(size_t n);
+  void ReleaseMemory(size_t n);
+  size_t GetMemoryUsage() const;
+
+ private:
+  const size_t min_readahead_size_;
+  const size_t max_readahead_size_;
+  const size_t max_memory_;
+  // Exponentially weighted moving averages, updated without synchronization
+  // as a lost update just delays the adaption a bit.
+  std::atomic<uint64_t> latency_micros_;
+  std::atomic<uint64_t> bytes_per_second_;
+  std::atomic<size_t> memory_usage_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
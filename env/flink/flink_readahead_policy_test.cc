@@ -0,0 +1,76 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "env/flink/flink_readahead_policy.h"
+
+#include "test_util/testharness.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+TEST(FlinkReadaheadPolicyTest, MinSizeUntilLearned) {
+  FlinkReadaheadPolicy policy(1 << 20, 32 << 20, 64 << 20);
+  ASSERT_EQ(1U << 20, policy.GetReadaheadSize(4096));
+  // Never smaller than requested
+  ASSERT_EQ(2U << 20, policy.GetReadaheadSize(2 << 20));
+
+  // Large reads are ignored until the latency is known
+  policy.RecordRead(8 << 20, 100000);
+  ASSERT_EQ(0U, policy.GetBytesPerSecond());
+  ASSERT_EQ(1U << 20, policy.GetReadaheadSize(4096));
+}
+
+TEST(FlinkReadaheadPolicyTest, AdaptToLatencyAndThroughput) {
+  FlinkReadaheadPolicy policy(1 << 20, 32 << 20, 64 << 20);
+  // 20ms per request, and 8MB transferred in 80ms, i.e. 100MB/s
+  policy.RecordRead(4096, 20000);
+  policy.RecordRead(8000000, 100000);
+  ASSERT_EQ(20000U, policy.GetLatencyMicros());
+  ASSERT_EQ(100000000U, policy.GetBytesPerSecond());
+  // Twice the bandwidth-delay product
+  ASSERT_EQ(4000000U, policy.GetReadaheadSize(4096));
+
+  // Higher latency needs larger readahead, up to the max
+  for (int i = 0; i < 100; i++) {
+    policy.RecordRead(4096, 1000000);
+  }
+  ASSERT_EQ(32U << 20, policy.GetReadaheadSize(4096));
+
+  // Fast local-like reads fall back to the min
+  for (int i = 0; i < 100; i++) {
+    policy.RecordRead(4096, 100);
+  }
+  ASSERT_EQ(1U << 20, policy.GetReadaheadSize(4096));
+}
+
+TEST(FlinkReadaheadPolicyTest, MemoryLimit) {
+  FlinkReadaheadPolicy policy(1 << 20, 32 << 20, 100);
+  ASSERT_TRUE(policy.ReserveMemory(60));
+  ASSERT_FALSE(policy.ReserveMemory(60));
+  ASSERT_TRUE(policy.ReserveMemory(40));
+  ASSERT_EQ(100U, policy.GetMemoryUsage());
+  policy.ReleaseMemory(60);
+  ASSERT_TRUE(policy.ReserveMemory(60));
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
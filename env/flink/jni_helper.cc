@@ -52,6 +52,14 @@ IOStatus JavaClassCache::Init() {
       "java/nio/ByteBuffer";
   cached_java_classes_[CachedJavaClass::JC_THROWABLE].className =
       "java/lang/Throwable";
+  cached_java_classes_[CachedJavaClass::JC_FUTURE].className =
+      "java/util/concurrent/Future";
+  cached_java_classes_[CachedJavaClass::JC_INTEGER].className =
+      "java/lang/Integer";
+  cached_java_classes_[CachedJavaClass::JC_STRING].className =
+      "java/lang/String";
+  cached_java_classes_[CachedJavaClass::JC_FILE_NOT_FOUND_EXCEPTION]
+      .className = "java/io/FileNotFoundException";
   cached_java_classes_[CachedJavaClass::JC_FLINK_FILE_SYSTEM].className =
       "org/apache/flink/state/forst/fs/StringifiedForStFileSystem";
   cached_java_classes_[CachedJavaClass::JC_FLINK_FILE_STATUS].className =
@@ -113,6 +121,15 @@ IOStatus JavaClassCache::Init() {
   cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_DELETE]
       .signature = "(Ljava/lang/String;Z)Z";
 
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_DELETE_FILES]
+      .javaClassAndName = cached_java_classes_[JC_FLINK_FILE_SYSTEM];
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_DELETE_FILES]
+      .methodName = "deleteFiles";
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_DELETE_FILES]
+      .signature = "([Ljava/lang/String;)[Z";
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_DELETE_FILES]
+      .isOptional = true;
+
   cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_MKDIR]
       .javaClassAndName = cached_java_classes_[JC_FLINK_FILE_SYSTEM];
   cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_MKDIR]
@@ -134,6 +151,15 @@ IOStatus JavaClassCache::Init() {
   cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_LINK_FILE]
       .signature = "(Ljava/lang/String;Ljava/lang/String;)I";
 
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_COPY_FILE]
+      .javaClassAndName = cached_java_classes_[JC_FLINK_FILE_SYSTEM];
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_COPY_FILE]
+      .methodName = "copy";
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_COPY_FILE]
+      .signature = "(Ljava/lang/String;Ljava/lang/String;)I";
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_COPY_FILE]
+      .isOptional = true;
+
   cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_OPEN]
       .javaClassAndName = cached_java_classes_[JC_FLINK_FILE_SYSTEM];
   cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_SYSTEM_OPEN].methodName =
@@ -156,6 +182,24 @@ IOStatus JavaClassCache::Init() {
   cached_java_methods_[CachedJavaMethod::JM_FLINK_FS_INPUT_STREAM_RANDOM_READ]
       .signature = "(JLjava/nio/ByteBuffer;)I";
 
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FS_INPUT_STREAM_MULTI_READ]
+      .javaClassAndName = cached_java_classes_[JC_FLINK_FS_INPUT_STREAM];
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FS_INPUT_STREAM_MULTI_READ]
+      .methodName = "readFully";
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FS_INPUT_STREAM_MULTI_READ]
+      .signature = "([J[I[Ljava/nio/ByteBuffer;)V";
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FS_INPUT_STREAM_MULTI_READ]
+      .isOptional = true;
+
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FS_INPUT_STREAM_READ_ASYNC]
+      .javaClassAndName = cached_java_classes_[JC_FLINK_FS_INPUT_STREAM];
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FS_INPUT_STREAM_READ_ASYNC]
+      .methodName = "readAsync";
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FS_INPUT_STREAM_READ_ASYNC]
+      .signature = "(JLjava/nio/ByteBuffer;)Ljava/util/concurrent/Future;";
+  cached_java_methods_[CachedJavaMethod::JM_FLINK_FS_INPUT_STREAM_READ_ASYNC]
+      .isOptional = true;
+
   cached_java_methods_[CachedJavaMethod::JM_FLINK_FS_INPUT_STREAM_SKIP]
       .javaClassAndName = cached_java_classes_[JC_FLINK_FS_INPUT_STREAM];
   cached_java_methods_[CachedJavaMethod::JM_FLINK_FS_INPUT_STREAM_SKIP]
@@ -238,6 +282,25 @@ IOStatus JavaClassCache::Init() {
   cached_java_methods_[CachedJavaMethod::JM_FLINK_FILE_STATUS_IS_DIR]
       .signature = "()Z";
 
+  cached_java_methods_[CachedJavaMethod::JM_FUTURE_GET].javaClassAndName =
+      cached_java_classes_[JC_FUTURE];
+  cached_java_methods_[CachedJavaMethod::JM_FUTURE_GET].methodName = "get";
+  cached_java_methods_[CachedJavaMethod::JM_FUTURE_GET].signature =
+      "()Ljava/lang/Object;";
+
+  cached_java_methods_[CachedJavaMethod::JM_FUTURE_IS_DONE].javaClassAndName =
+      cached_java_classes_[JC_FUTURE];
+  cached_java_methods_[CachedJavaMethod::JM_FUTURE_IS_DONE].methodName =
+      "isDone";
+  cached_java_methods_[CachedJavaMethod::JM_FUTURE_IS_DONE].signature = "()Z";
+
+  cached_java_methods_[CachedJavaMethod::JM_INTEGER_INT_VALUE]
+      .javaClassAndName = cached_java_classes_[JC_INTEGER];
+  cached_java_methods_[CachedJavaMethod::JM_INTEGER_INT_VALUE].methodName =
+      "intValue";
+  cached_java_methods_[CachedJavaMethod::JM_INTEGER_INT_VALUE].signature =
+      "()I";
+
   // Create and set the jmethod based on the method names and signatures set
   // above
   int numCachedMethods =
@@ -255,6 +318,13 @@ IOStatus JavaClassCache::Init() {
           cached_java_methods_[i].signature);
     }
 
+    if (!cached_java_methods_[i].javaMethod &&
+        cached_java_methods_[i].isOptional) {
+      // Clear the NoSuchMethodError, the caller will fall back
+      jni_env_->ExceptionClear();
+      continue;
+    }
+
     if (!cached_java_methods_[i].javaMethod) {
       return IOStatus::IOError(std::string("Exception when GetMethodID, ")
                                    .append(cached_java_methods_[i].ToString()));
@@ -280,13 +350,13 @@ IOStatus JavaClassCache::initCachedClass(const char* className,
   return IOStatus::OK();
 }
 
-JavaClassCache::JavaClassContext JavaClassCache::GetJClass(
-    CachedJavaClass cachedJavaClass) {
+const JavaClassCache::JavaClassContext& JavaClassCache::GetJClass(
+    CachedJavaClass cachedJavaClass) const {
   return cached_java_classes_[cachedJavaClass];
 }
 
-JavaClassCache::JavaMethodContext JavaClassCache::GetJMethod(
-    CachedJavaMethod cachedJavaMethod) {
+const JavaClassCache::JavaMethodContext& JavaClassCache::GetJMethod(
+    CachedJavaMethod cachedJavaMethod) const {
   return cached_java_methods_[cachedJavaMethod];
 }
 
@@ -31,6 +31,10 @@ class JavaClassCache {
   typedef enum {
     JC_BYTE_BUFFER,
     JC_THROWABLE,
+    JC_FUTURE,
+    JC_INTEGER,
+    JC_STRING,
+    JC_FILE_NOT_FOUND_EXCEPTION,
     JC_FLINK_FILE_SYSTEM,
     JC_FLINK_FILE_STATUS,
     JC_FLINK_FS_INPUT_STREAM,
@@ -45,11 +49,14 @@ class JavaClassCache {
     JM_FLINK_FILE_SYSTEM_LIST_STATUS,
     JM_FLINK_FILE_SYSTEM_GET_FILE_STATUS,
     JM_FLINK_FILE_SYSTEM_DELETE,
+    JM_FLINK_FILE_SYSTEM_DELETE_FILES,
     JM_FLINK_FILE_SYSTEM_MKDIR,
     JM_FLINK_FILE_SYSTEM_RENAME_FILE,
     JM_FLINK_FILE_SYSTEM_OPEN,
     JM_FLINK_FS_INPUT_STREAM_SEQ_READ,
     JM_FLINK_FS_INPUT_STREAM_RANDOM_READ,
+    JM_FLINK_FS_INPUT_STREAM_MULTI_READ,
+    JM_FLINK_FS_INPUT_STREAM_READ_ASYNC,
     JM_FLINK_FS_INPUT_STREAM_SKIP,
     JM_FLINK_FS_INPUT_STREAM_CLOSE,
     JM_FLINK_FS_OUTPUT_STREAM_WRITE,
@@ -62,6 +69,10 @@ class JavaClassCache {
     JM_FLINK_FILE_STATUS_GET_MODIFICATION_TIME,
     JM_FLINK_FILE_STATUS_IS_DIR,
     JM_FLINK_FILE_SYSTEM_LINK_FILE,
+    JM_FLINK_FILE_SYSTEM_COPY_FILE,
+    JM_FUTURE_GET,
+    JM_FUTURE_IS_DONE,
+    JM_INTEGER_INT_VALUE,
     NUM_CACHED_METHODS
   } CachedJavaMethod;
 
@@ -82,6 +93,10 @@ class JavaClassCache {
     const char* methodName;
     const char* signature;
     bool isStatic = false;
+    // Optional methods are allowed to be absent on the Java side, e.g. when
+    // running with an older Flink version. Their javaMethod is left nullptr
+    // and callers must fall back to other methods.
+    bool isOptional = false;
 
     std::string ToString() const {
       return javaClassAndName.ToString()
@@ -90,7 +105,9 @@ class JavaClassCache {
           .append(", signature: ")
           .append(signature)
           .append(", isStatic:")
-          .append(isStatic ? "true" : "false");
+          .append(isStatic ? "true" : "false")
+          .append(", isOptional:")
+          .append(isOptional ? "true" : "false");
     }
   };
 
@@ -103,10 +120,10 @@ class JavaClassCache {
                          std::unique_ptr<JavaClassCache>* javaClassCache);
 
   // Get JavaClassContext by specific CachedJavaClass.
-  JavaClassContext GetJClass(CachedJavaClass cachedJavaClass);
+  const JavaClassContext& GetJClass(CachedJavaClass cachedJavaClass) const;
 
   // Get JavaMethodContext by specific CachedJavaMethod.
-  JavaMethodContext GetJMethod(CachedJavaMethod cachedJavaMethod);
+  const JavaMethodContext& GetJMethod(CachedJavaMethod cachedJavaMethod) const;
 
  private:
   JNIEnv* jni_env_;
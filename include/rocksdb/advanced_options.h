@@ -824,6 +824,37 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through SetOptions() API
   size_t max_successive_merges = 0;
 
+  // Maximum number of successive merge operations on a key in the memtable
+  // before they are folded into the base value of the key, if it is in the
+  // memtable too.
+  //
+  // Like max_successive_merges, but the value of the key is only calculated
+  // from the memtable, i.e. if the merge operations apply to a Put, a
+  // PutEntity or a deletion of the key in the memtable, and is inserted into
+  // the memtable instead of the merge operation. The DB is never read, so
+  // hot keys, e.g. aggregates updated many times between flushes, keep
+  // short merge chains in the memtable at the cost of a lookup in the
+  // memtable every time the maximum is reached. The older merge operations
+  // stay in the memtable for the snapshots taken before. If the base value
+  // is not in the memtable, the merge operations are left to
+  // max_successive_merges, if enabled, or to flushes and compactions.
+  //
+  // Every fold inserts a full copy of the merged value into the memtable.
+  // This suits merge operators whose result stays small, e.g. counters. For
+  // operators whose result grows with each operand, e.g. appending to a
+  // list, a key merged M times between flushes writes about
+  // M^2 / (2 * memtable_max_successive_merges) operands' worth of copies,
+  // which costs memtable memory, earlier flushes and larger L0 files. For
+  // such column families, e.g. list state, leave this disabled and use a
+  // merge operator with partial merges, e.g. ListAppendOperator, which
+  // combines the operands in flushes and compactions without copying the
+  // whole value on every fold.
+  //
+  // Default: 0 (disabled)
+  //
+  // Dynamically changeable through SetOptions() API
+  size_t memtable_max_successive_merges = 0;
+
   // This flag specifies that the implementation should optimize the filters
   // mainly for cases where keys are found rather than also optimize for keys
   // missed. This would be used in cases where the application knows that
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -451,6 +452,21 @@ Status DeleteFilesInRanges(DB* db, ColumnFamilyHandle* column_family,
                            const RangePtr* ranges, size_t n,
                            bool include_end = true);
 
+// Delete the files of the column family, except those in level 0, for which
+// `should_delete` returns true given their table properties. Like
+// DeleteFilesInRanges(), the files are dropped as a whole, so `should_delete`
+// should only accept files whose data is all obsolete, e.g. expired, and that
+// shadow no live data in older files. Files containing tombstones should not
+// be accepted as their deletion may bring back deleted keys.
+// Files being compacted, and files sharing a boundary user key with another
+// file of the same level, are skipped.
+// `num_deleted`, if not nullptr, is set to the number of deleted files.
+// Snapshots before the delete might not see the data of the deleted files.
+Status DeleteFilesByTableProperties(
+    DB* db, ColumnFamilyHandle* column_family,
+    const std::function<bool(const TableProperties&)>& should_delete,
+    uint64_t* num_deleted = nullptr);
+
 // Verify the checksum of file
 Status VerifySstFileChecksum(const Options& options,
                              const EnvOptions& env_options,
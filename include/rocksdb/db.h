@@ -969,6 +969,21 @@ class DB {
       const std::vector<ColumnFamilyHandle*>& column_families,
       std::vector<Iterator*>* iterators) = 0;
 
+  // Return a heap-allocated iterator over the keys of column_family starting
+  // with prefix, like NewIterator() with options bounded by prefix and its
+  // successor, so that SeekToFirst() and SeekToLast() position the iterator
+  // within the prefix and it becomes invalid past it in both directions. The
+  // bounds are owned by the iterator and only narrow those of options.
+  // auto_prefix_mode is enabled, so that the prefix bloom filters prune the
+  // files without the prefix if the prefix_extractor of column_family maps
+  // the keys to prefix.
+  //
+  // Only supported with the bytewise comparator; otherwise the iterator has a
+  // NotSupported status.
+  Iterator* NewPrefixIterator(const ReadOptions& options,
+                              ColumnFamilyHandle* column_family,
+                              const Slice& prefix);
+
   // Return a handle to the current DB state.  Iterators created with
   // this handle will all observe a stable snapshot of the current DB
   // state.  The caller must call ReleaseSnapshot(result) when the
@@ -1883,15 +1898,35 @@ class DB {
       const std::vector<const ExportImportFilesMetaData*>& metadatas,
       ColumnFamilyHandle** handle) = 0;
 
+  // EXPERIMENTAL
+  // Overload of the CreateColumnFamilyWithImport() that also clips the new
+  // ColumnFamily to the range [begin_key, end_key) like ClipColumnFamily(),
+  // e.g. to restore a ColumnFamily from several others when rescaling.
+  // Files of `metadatas` which are entirely outside the range are neither
+  // copied nor moved, so they are left for the caller to clean up. Only the
+  // files overlapping the range boundaries are clipped afterwards. The user
+  // keys of the imported files which overlap the range must not overlap
+  // between the ColumnFamilies.
+  virtual Status CreateColumnFamilyWithImport(
+      const ColumnFamilyOptions& options, const std::string& column_family_name,
+      const ImportColumnFamilyOptions& import_options,
+      const std::vector<const ExportImportFilesMetaData*>& metadatas,
+      const Slice& begin_key, const Slice& end_key,
+      ColumnFamilyHandle** handle);
+
   // EXPERIMENTAL
   // ClipColumnFamily() will clip the entries in the CF according to the range
   // [begin_key, end_key). Returns OK on success, and a non-OK status on error.
-  // Any entries outside this range will be completely deleted (including
-  // tombstones).
+  // Any entries outside this range, including tombstones, are no longer
+  // visible once it returns. Files crossing the range boundaries are not
+  // rewritten but narrowed to the range and marked for compaction, so their
+  // entries outside the range stay on disk, hidden, until the files are
+  // compacted. RepairDB() keeps the narrowed boundaries only if it can read
+  // them from the newest MANIFEST; otherwise it rebuilds the boundaries from
+  // the file contents and the hidden entries reappear.
   // The main difference between ClipColumnFamily(begin, end) and
-  // DeleteRange(begin, end)
-  // is that the former physically deletes all keys outside the range, but is
-  // more heavyweight than the latter.
+  // DeleteRange(begin, end) is that the former leaves no tombstones covering
+  // the keys outside the range, but is more heavyweight than the latter.
   // This feature is mainly used to ensure that there is no overlapping Key when
   // calling CreateColumnFamilyWithImport() to import multiple CFs.
   // Note that: concurrent updates cannot be performed during Clip.
@@ -17,9 +17,15 @@
 // The factory will be passed an MemTableAllocator object when a new MemTableRep
 // is requested.
 //
-// Users can implement their own memtable representations. We include three
+// Users can implement their own memtable representations. We include four
 // types built in:
 //  - SkipListRep: This is the default; it is backed by a skip list.
+//  - BTreeRep: This is backed by a B+-tree with cache-line-sized nodes. The
+//  keys are stored uncompressed, but with the bytewise comparator each node
+//  caches prefix-truncated comparison heads: the first 8 bytes of its keys
+//  after the prefix shared by its fence keys. So comparisons of short keys
+//  sharing long prefixes mostly read the heads. Like SkipListRep, it is
+//  ordered and iterates without copying the keys.
 //  - HashSkipListRep: The memtable rep that is best used for keys that are
 //  structured like "prefix:suffix" where iteration within a prefix is
 //  common and iteration across different prefixes is rare. It is backed by
@@ -29,7 +35,7 @@
 // has been called, the vector will only be sorted once. It is optimized for
 // random-write-heavy workloads.
 //
-// The last four implementations are designed for situations in which
+// HashSkipListRep and VectorRep are designed for situations in which
 // iteration over the entire collection is rare since doing so requires all the
 // keys to be copied into a sorted data structure.
 
@@ -49,6 +55,7 @@ namespace ROCKSDB_NAMESPACE {
 
 class Arena;
 class Allocator;
+class Comparator;
 class LookupKey;
 class SliceTransform;
 class Logger;
@@ -80,6 +87,12 @@ class MemTableRep {
     virtual int operator()(const char* prefix_len_key,
                            const Slice& key) const = 0;
 
+    // Returns the comparator of the user keys of the internal keys, or
+    // nullptr if the keys are not compared as internal keys. Lets the
+    // representations compare the bytes of the user keys themselves when
+    // it is the bytewise comparator.
+    virtual const Comparator* user_comparator() const { return nullptr; }
+
     virtual ~KeyComparator() {}
   };
 
@@ -386,6 +399,34 @@ class VectorRepFactory : public MemTableRepFactory {
                                          Logger* logger) override;
 };
 
+// This creates MemTableReps that are backed by a B+-tree. The nodes span a few
+// cache lines and hold the first bytes of their keys after the prefix shared
+// by all the keys of the node, so that most comparisons of short keys with
+// long common prefixes, e.g. the keys of Flink state, do not read the keys
+// themselves. The first bytes of the keys are only used with the bytewise
+// comparator. Inserts are concurrent with reads and other inserts, with
+// optimistic lock coupling.
+class BTreeRepFactory : public MemTableRepFactory {
+ public:
+  BTreeRepFactory() {}
+
+  // Methods for Configurable/Customizable class overrides
+  static const char* kClassName() { return "BTreeRepFactory"; }
+  static const char* kNickName() { return "btree"; }
+  const char* Name() const override { return kClassName(); }
+  const char* NickName() const override { return kNickName(); }
+
+  // Methods for MemTableRepFactory class overrides
+  using MemTableRepFactory::CreateMemTableRep;
+  MemTableRep* CreateMemTableRep(const MemTableRep::KeyComparator&,
+                                 Allocator*, const SliceTransform*,
+                                 Logger* logger) override;
+
+  bool IsInsertConcurrentlySupported() const override { return true; }
+
+  bool CanHandleDuplicatedKey() const override { return true; }
+};
+
 // This class contains a fixed array of buckets, each
 // pointing to a skiplist (null if the bucket is empty).
 // bucket_count: number of fixed array buckets
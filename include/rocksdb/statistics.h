@@ -537,6 +537,11 @@ enum Tickers : uint32_t {
   COMPRESSED_SECONDARY_CACHE_PROMOTIONS,
   COMPRESSED_SECONDARY_CACHE_PROMOTION_SKIPS,
 
+  // Bytes read from and written to Flink FileSystem through JNI, only
+  // recorded if FlinkFileSystemOptions::statistics is set.
+  FLINK_FS_BYTES_READ,
+  FLINK_FS_BYTES_WRITTEN,
+
   TICKER_ENUM_MAX
 };
 
@@ -666,6 +671,28 @@ enum Histograms : uint32_t {
   // system's prefetch) from the end of SST table during block based table open
   TABLE_OPEN_PREFETCH_TAIL_READ_BYTES,
 
+  // Latency of Flink FileSystem operations through JNI, only recorded if
+  // FlinkFileSystemOptions::statistics is set.
+  // Opening an input stream or creating an output stream
+  FLINK_FS_OPEN_MICROS,
+  FLINK_FS_READ_MICROS,
+  // Size of each read
+  FLINK_FS_READ_BYTES,
+  FLINK_FS_WRITE_MICROS,
+  // Flush or sync of an output stream
+  FLINK_FS_SYNC_MICROS,
+  FLINK_FS_CLOSE_MICROS,
+  FLINK_FS_LIST_MICROS,
+  // Checking the existence of a path
+  FLINK_FS_EXISTS_MICROS,
+  FLINK_FS_RENAME_MICROS,
+  FLINK_FS_DELETE_MICROS,
+  FLINK_FS_LINK_MICROS,
+  // Getting the status of a path
+  FLINK_FS_GET_FILE_STATUS_MICROS,
+  // Creating a directory and its parents
+  FLINK_FS_MKDIRS_MICROS,
+
   HISTOGRAM_ENUM_MAX
 };
 
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "rocksdb/status.h"
@@ -24,6 +25,13 @@ class Checkpoint {
   // Creates a Checkpoint object to be used for creating openable snapshots
   static Status Create(DB* db, Checkpoint** checkpoint_ptr);
 
+  // Like Create(), but the created Checkpoint links or copies the files of a
+  // checkpoint in up to max_background_operations threads in parallel, which
+  // speeds up checkpoints on file systems with a high latency per file
+  // operation, e.g. remote ones.
+  static Status Create(DB* db, Checkpoint** checkpoint_ptr,
+                       int max_background_operations);
+
   // Builds an openable snapshot of RocksDB. checkpoint_dir should contain an
   // absolute path. The specified directory should not exist, since it will be
   // created by the API.
@@ -47,6 +55,22 @@ class Checkpoint {
                                   uint64_t log_size_for_flush = 0,
                                   uint64_t* sequence_number_ptr = nullptr);
 
+  // Builds an incremental snapshot of RocksDB on top of a previous one. Like
+  // CreateCheckpoint(), except that the SST and blob files named in
+  // previous_files, e.g. the files of the previous checkpoint, are neither
+  // linked nor copied into checkpoint_dir, as these files are immutable.
+  // new_files is set to the names of the files in checkpoint_dir, and
+  // reused_files to the names of the files of previous_files which are part
+  // of the snapshot. Only the new files are then to be transferred, and the
+  // snapshot is openable once the reused files are put into checkpoint_dir.
+  // The file names are relative to the checkpoint directory.
+  virtual Status CreateIncrementalCheckpoint(
+      const std::string& checkpoint_dir,
+      const std::unordered_set<std::string>& previous_files,
+      std::vector<std::string>* new_files,
+      std::vector<std::string>* reused_files, uint64_t log_size_for_flush = 0,
+      uint64_t* sequence_number_ptr = nullptr);
+
   // Exports all live SST files of a specified Column Family onto export_dir,
   // returning SST files information in metadata.
   // - SST files will be created as hard links when the directory specified
@@ -21,6 +21,8 @@ package org.apache.flink.state.forst.fs;
 import java.io.IOException;
 import java.io.InputStream;
 import java.nio.ByteBuffer;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.Future;
 import org.apache.flink.core.fs.LocalDataInputStream;
 import org.apache.flink.core.fs.Path;
 
@@ -100,6 +102,33 @@ public class ByteBufferReadableFSDataInputStream extends InputStream {
     return readFullyFromFSDataInputStream(localDataInputStream, bb);
   }
 
+  /**
+   * Read multiple ranges, the range i into buffers[i], and lengths[i] is overwritten with the
+   * number of bytes actually read, which may be fewer than requested at the end of file.
+   * Implementations could fetch ranges in parallel. Safe for concurrent use by multiple threads.
+   */
+  public void readFully(long[] positions, int[] lengths, ByteBuffer[] buffers)
+      throws IOException {
+    for (int i = 0; i < positions.length; i++) {
+      lengths[i] = readFully(positions[i], buffers[i]);
+    }
+  }
+
+  /**
+   * Read asynchronously, the returned future completes with the total number of bytes read into
+   * the buffer. Real implementations submit the read to an executor, while this mock completes it
+   * in place.
+   */
+  public Future<Integer> readAsync(long position, ByteBuffer bb) {
+    CompletableFuture<Integer> future = new CompletableFuture<>();
+    try {
+      future.complete(readFully(position, bb));
+    } catch (IOException e) {
+      future.completeExceptionally(e);
+    }
+    return future;
+  }
+
   @Override
   public long skip(long n) throws IOException {
     seek(getPos() + n);
@@ -124,6 +124,24 @@ public class ForStFlinkFileSystem extends FileSystem {
     return -1;
   }
 
+  /**
+   * Copies the file within the file system, e.g. by a server-side copy on object stores. This mock
+   * copies the file through streams.
+   *
+   * @return 0 if copied, -1 if not supported.
+   */
+  public int copy(Path src, Path dst) throws IOException {
+    try (InputStream in = flinkFS.open(src);
+         OutputStream out = flinkFS.create(dst, WriteMode.OVERWRITE)) {
+      byte[] buffer = new byte[64 * 1024];
+      int n;
+      while ((n = in.read(buffer)) > 0) {
+        out.write(buffer, 0, n);
+      }
+    }
+    return 0;
+  }
+
   @Override
   public boolean isDistributedFS() {
     return flinkFS.isDistributedFS();
@@ -55,6 +55,14 @@ public class StringifiedForStFileSystem {
     return fileSystem.delete(new Path(path), recursive);
   }
 
+  public boolean[] deleteFiles(String[] paths) throws IOException {
+    boolean[] deleted = new boolean[paths.length];
+    for (int i = 0; i < paths.length; i++) {
+      deleted[i] = fileSystem.delete(new Path(paths[i]), false);
+    }
+    return deleted;
+  }
+
   public boolean mkdirs(String path) throws IOException {
     return fileSystem.mkdirs(new Path(path));
   }
@@ -74,4 +82,8 @@ public class StringifiedForStFileSystem {
   public int link(String src, String dst) throws IOException {
     return fileSystem.link(new Path(src), new Path(dst));
   }
+
+  public int copy(String src, String dst) throws IOException {
+    return fileSystem.copy(new Path(src), new Path(dst));
+  }
 }
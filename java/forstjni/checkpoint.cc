@@ -21,14 +21,15 @@
 /*
  * Class:     org_forstdb_Checkpoint
  * Method:    newCheckpoint
- * Signature: (J)J
+ * Signature: (JI)J
  */
-jlong Java_org_forstdb_Checkpoint_newCheckpoint(JNIEnv* /*env*/,
-                                                jclass /*jclazz*/,
-                                                jlong jdb_handle) {
+jlong Java_org_forstdb_Checkpoint_newCheckpoint(
+    JNIEnv* /*env*/, jclass /*jclazz*/, jlong jdb_handle,
+    jint jmax_background_operations) {
   auto* db = reinterpret_cast<ROCKSDB_NAMESPACE::DB*>(jdb_handle);
   ROCKSDB_NAMESPACE::Checkpoint* checkpoint;
-  ROCKSDB_NAMESPACE::Checkpoint::Create(db, &checkpoint);
+  ROCKSDB_NAMESPACE::Checkpoint::Create(
+      db, &checkpoint, static_cast<int>(jmax_background_operations));
   return GET_CPLUSPLUS_POINTER(checkpoint);
 }
 
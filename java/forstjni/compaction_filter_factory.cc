@@ -23,8 +23,10 @@ jlong Java_org_forstdb_AbstractCompactionFilterFactory_createNewCompactionFilter
     JNIEnv* env, jobject jobj) {
   auto* cff =
       new ROCKSDB_NAMESPACE::CompactionFilterFactoryJniCallback(env, jobj);
-  auto* ptr_sptr_cff = new std::shared_ptr<
-      ROCKSDB_NAMESPACE::CompactionFilterFactoryJniCallback>(cff);
+  // Held as the base class, like the native factories, so that the options
+  // take either kind of handle
+  auto* ptr_sptr_cff =
+      new std::shared_ptr<ROCKSDB_NAMESPACE::CompactionFilterFactory>(cff);
   return GET_CPLUSPLUS_POINTER(ptr_sptr_cff);
 }
 
@@ -36,7 +38,6 @@ jlong Java_org_forstdb_AbstractCompactionFilterFactory_createNewCompactionFilter
 void Java_org_forstdb_AbstractCompactionFilterFactory_disposeInternal(
     JNIEnv*, jobject, jlong jhandle) {
   auto* ptr_sptr_cff = reinterpret_cast<
-      std::shared_ptr<ROCKSDB_NAMESPACE::CompactionFilterFactoryJniCallback>*>(
-      jhandle);
+      std::shared_ptr<ROCKSDB_NAMESPACE::CompactionFilterFactory>*>(jhandle);
   delete ptr_sptr_cff;
 }
@@ -23,16 +23,18 @@
 #include "include/org_forstdb_FlinkEnv.h"
 
 #include "java/forstjni/portal.h"
+#include "java/forstjni/statisticsjni.h"
 #include "rocksdb/env.h"
 
 /*
  * Class:     org_forstdb_FlinkEnv
  * Method:    createFlinkEnv
- * Signature: (Ljava/lang/String;Ljava/lang/Object;)J
+ * Signature: (Ljava/lang/String;Ljava/lang/Object;J)J
  */
 jlong Java_org_forstdb_FlinkEnv_createFlinkEnv(JNIEnv* env, jclass,
                                                jstring base_path,
-                                               jobject file_system_instance_) {
+                                               jobject file_system_instance_,
+                                               jlong jstatistics_handle) {
   jboolean has_exception = JNI_FALSE;
   auto path =
       ROCKSDB_NAMESPACE::JniUtil::copyStdString(env, base_path, &has_exception);
@@ -41,9 +43,15 @@ jlong Java_org_forstdb_FlinkEnv_createFlinkEnv(JNIEnv* env, jclass,
         env, "Could not copy jstring to std::string");
     return 0;
   }
+  ROCKSDB_NAMESPACE::FlinkFileSystemOptions options;
+  if (jstatistics_handle != 0) {
+    options.statistics =
+        *reinterpret_cast<std::shared_ptr<ROCKSDB_NAMESPACE::StatisticsJni>*>(
+            jstatistics_handle);
+  }
   std::unique_ptr<ROCKSDB_NAMESPACE::Env> flink_env;
-  auto status =
-      ROCKSDB_NAMESPACE::NewFlinkEnv(path, &flink_env, file_system_instance_);
+  auto status = ROCKSDB_NAMESPACE::NewFlinkEnv(path, &flink_env,
+                                               file_system_instance_, options);
   if (!status.ok()) {
     ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(env, status);
     return 0;
@@ -60,6 +60,24 @@ JNIEXPORT void JNICALL Java_org_forstdb_EnvFlinkTestSuite_runAllTestSuites(
   }
 }
 
+/*
+ * Class:     org_forstdb_EnvFlinkTestSuite
+ * Method:    runBenchmarks
+ * Signature: (JI)V
+ */
+JNIEXPORT void JNICALL Java_org_forstdb_EnvFlinkTestSuite_runBenchmarks(
+    JNIEnv* jniEnv, jobject, jlong objectHandle, jint numOps) {
+  auto env_flink_test_suites =
+      reinterpret_cast<ROCKSDB_NAMESPACE::EnvFlinkTestSuites*>(objectHandle);
+  env_flink_test_suites->runBenchmarks(static_cast<int>(numOps));
+  if (jniEnv->ExceptionCheck()) {
+    jthrowable throwable = jniEnv->ExceptionOccurred();
+    jniEnv->ExceptionDescribe();
+    jniEnv->ExceptionClear();
+    jniEnv->Throw(throwable);
+  }
+}
+
 /*
  * Class:     org_forstdb_EnvFlinkTestSuite
  * Method:    disposeInternal
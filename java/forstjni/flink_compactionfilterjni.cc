@@ -6,24 +6,89 @@
 #include <include/rocksdb/env.h>
 #include <jni.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+
 #include "include/org_forstdb_FlinkCompactionFilter.h"
 #include "loggerjnicallback.h"
 #include "portal.h"
 #include "forstjni/jnicallback.h"
 #include "utilities/flink/flink_compaction_filter.h"
 
+// Compaction threads call back into Java for many keys, attaching and
+// detaching them for every call costs more than the call itself. So they are
+// attached once as daemon threads and detached when they exit.
+class ThreadJniAttachment {
+ public:
+  ~ThreadJniAttachment() {
+    if (m_jvm != nullptr) {
+      m_jvm->DetachCurrentThread();
+    }
+  }
+
+  JNIEnv* GetJniEnv(JavaVM* jvm) {
+    JNIEnv* env = nullptr;
+    const jint env_rs =
+        jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6);
+    if (env_rs == JNI_OK) {
+      return env;
+    }
+    if (env_rs == JNI_EDETACHED &&
+        jvm->AttachCurrentThreadAsDaemon(reinterpret_cast<void**>(&env),
+                                         nullptr) == JNI_OK) {
+      m_jvm = jvm;
+      return env;
+    }
+    std::cerr << "ThreadJniAttachment::GetJniEnv - Fatal: could not attach "
+                 "current thread to JVM!"
+              << std::endl;
+    return nullptr;
+  }
+
+ private:
+  JavaVM* m_jvm = nullptr;
+};
+
 class JniCallbackBase : public ROCKSDB_NAMESPACE::JniCallback {
  public:
   JniCallbackBase(JNIEnv* env, jobject jcallback_obj)
       : JniCallback(env, jcallback_obj) {}
 
  protected:
-  inline void CheckAndRethrowException(JNIEnv* env) const {
-    if (env->ExceptionCheck()) {
-      jthrowable obj = env->ExceptionOccurred();
-      env->ExceptionDescribe();
-      env->Throw(obj);
+  // The thread stays attached after the call.
+  inline JNIEnv* getAttachedJniEnv() const {
+    thread_local ThreadJniAttachment attachment;
+    return attachment.GetJniEnv(m_jvm);
+  }
+
+  // The compaction thread never returns to Java, so an exception must not be
+  // left pending on it. Returns true if the call threw an exception, which is
+  // described, logged and cleared.
+  inline bool ClearException(JNIEnv* env, ROCKSDB_NAMESPACE::Logger* logger,
+                             const char* method) const {
+    if (!env->ExceptionCheck()) {
+      return false;
     }
+    env->ExceptionDescribe();
+    env->ExceptionClear();
+    ROCKSDB_NAMESPACE::Error(logger, "Exception thrown by Java %s", method);
+    return true;
+  }
+};
+
+// Keeps all the list elements, used if the Java list element filter could not
+// be created.
+class UnexpiredListElementFilter
+    : public ROCKSDB_NAMESPACE::flink::FlinkCompactionFilter::ListElementFilter {
+ public:
+  std::size_t NextUnexpiredOffset(
+      const ROCKSDB_NAMESPACE::Slice& /*list*/, int64_t /*ttl*/,
+      int64_t /*current_timestamp*/) const override {
+    return 0;
   }
 };
 
@@ -32,46 +97,106 @@ class JniCallbackBase : public ROCKSDB_NAMESPACE::JniCallback {
 // this case to compute the offset of the next element. The filter wraps java
 // object implenented in Flink. The java object holds element serializer and
 // performs filtering.
+//
+// The list is passed in a direct ByteBuffer which is reused by the calls and
+// only reallocated to grow, a filter is only used by one compaction thread.
+// If the Java call fails, the list is kept as if its head were unexpired.
 class JavaListElementFilter
     : public ROCKSDB_NAMESPACE::flink::FlinkCompactionFilter::ListElementFilter,
       JniCallbackBase {
  public:
-  JavaListElementFilter(JNIEnv* env, jobject jlist_filter)
-      : JniCallbackBase(env, jlist_filter) {
+  JavaListElementFilter(JNIEnv* env, jobject jlist_filter,
+                        std::shared_ptr<ROCKSDB_NAMESPACE::Logger> logger)
+      : JniCallbackBase(env, jlist_filter),
+        m_logger(std::move(logger)),
+        m_jnext_unexpired_offset_methodid(nullptr),
+        m_jbuffer(nullptr),
+        m_buffer_capacity(0) {
     jclass jclazz = ROCKSDB_NAMESPACE::JavaClass::getJClass(
         env, "org/forstdb/FlinkCompactionFilter$ListElementFilter");
     if (jclazz == nullptr) {
       // exception occurred accessing class
       return;
     }
-    m_jnext_unexpired_offset_methodid =
-        env->GetMethodID(jclazz, "nextUnexpiredOffset", "([BJJ)I");
+    m_jnext_unexpired_offset_methodid = env->GetMethodID(
+        jclazz, "nextUnexpiredOffset", "(Ljava/nio/ByteBuffer;IJJ)I");
     assert(m_jnext_unexpired_offset_methodid != nullptr);
+    env->DeleteLocalRef(jclazz);
+  }
+
+  ~JavaListElementFilter() override {
+    if (m_jbuffer != nullptr) {
+      jboolean attached_thread = JNI_FALSE;
+      JNIEnv* env = getJniEnv(&attached_thread);
+      assert(env != nullptr);
+      env->DeleteGlobalRef(m_jbuffer);
+      releaseJniEnv(attached_thread);
+    }
   }
 
   std::size_t NextUnexpiredOffset(const ROCKSDB_NAMESPACE::Slice& list,
                                   int64_t ttl,
                                   int64_t current_timestamp) const override {
-    jboolean attached_thread = JNI_FALSE;
-    JNIEnv* env = getJniEnv(&attached_thread);
-    jbyteArray jlist = ROCKSDB_NAMESPACE::JniUtil::copyBytes(env, list);
-    CheckAndRethrowException(env);
-    if (jlist == nullptr) {
-      return static_cast<std::size_t>(-1);
+    JNIEnv* env = getAttachedJniEnv();
+    if (env == nullptr || m_jnext_unexpired_offset_methodid == nullptr ||
+        list.size() > static_cast<std::size_t>(INT_MAX)) {
+      return 0;
+    }
+    if (!EnsureBufferCapacity(env, list.size())) {
+      ClearException(env, m_logger.get(), "ByteBuffer allocation");
+      return 0;
+    }
+    if (!list.empty()) {
+      memcpy(m_buffer.get(), list.data(), list.size());
     }
     auto jl_ttl = static_cast<jlong>(ttl);
     auto jl_current_timestamp = static_cast<jlong>(current_timestamp);
-    jint next_offset =
-        env->CallIntMethod(m_jcallback_obj, m_jnext_unexpired_offset_methodid,
-                           jlist, jl_ttl, jl_current_timestamp);
-    CheckAndRethrowException(env);
-    env->DeleteLocalRef(jlist);
-    releaseJniEnv(attached_thread);
+    jint next_offset = env->CallIntMethod(
+        m_jcallback_obj, m_jnext_unexpired_offset_methodid, m_jbuffer,
+        static_cast<jint>(list.size()), jl_ttl, jl_current_timestamp);
+    if (ClearException(env, m_logger.get(),
+                       "ListElementFilter#nextUnexpiredOffset") ||
+        next_offset < 0) {
+      return 0;
+    }
     return static_cast<std::size_t>(next_offset);
   };
 
  private:
+  bool EnsureBufferCapacity(JNIEnv* env, std::size_t size) const {
+    if (m_jbuffer != nullptr && size <= m_buffer_capacity) {
+      return true;
+    }
+    std::size_t capacity = std::max(
+        size, std::min(m_buffer_capacity * 2, static_cast<size_t>(INT_MAX)));
+    capacity = std::max(capacity, kMinBufferCapacity);
+    std::unique_ptr<char[]> buffer(new char[capacity]);
+    jobject jbuffer = env->NewDirectByteBuffer(buffer.get(),
+                                               static_cast<jlong>(capacity));
+    if (jbuffer == nullptr) {
+      return false;
+    }
+    jobject jbuffer_global = env->NewGlobalRef(jbuffer);
+    env->DeleteLocalRef(jbuffer);
+    if (jbuffer_global == nullptr) {
+      return false;
+    }
+    if (m_jbuffer != nullptr) {
+      env->DeleteGlobalRef(m_jbuffer);
+    }
+    m_jbuffer = jbuffer_global;
+    m_buffer = std::move(buffer);
+    m_buffer_capacity = capacity;
+    return true;
+  }
+
+  static constexpr std::size_t kMinBufferCapacity = 4096;
+
+  std::shared_ptr<ROCKSDB_NAMESPACE::Logger> m_logger;
   jmethodID m_jnext_unexpired_offset_methodid;
+  mutable jobject m_jbuffer;
+  mutable std::unique_ptr<char[]> m_buffer;
+  mutable std::size_t m_buffer_capacity;
 };
 
 class JavaListElemenFilterFactory
@@ -91,18 +216,26 @@ class JavaListElemenFilterFactory
         jclazz, "createListElementFilter",
         "()Lorg/forstdb/FlinkCompactionFilter$ListElementFilter;");
     assert(m_jcreate_filter_methodid != nullptr);
+    env->DeleteLocalRef(jclazz);
   }
 
   ROCKSDB_NAMESPACE::flink::FlinkCompactionFilter::ListElementFilter*
   CreateListElementFilter(
-      std::shared_ptr<ROCKSDB_NAMESPACE::Logger> /*logger*/) const override {
-    jboolean attached_thread = JNI_FALSE;
-    JNIEnv* env = getJniEnv(&attached_thread);
+      std::shared_ptr<ROCKSDB_NAMESPACE::Logger> logger) const override {
+    JNIEnv* env = getAttachedJniEnv();
+    assert(env != nullptr);
     auto jlist_filter =
         env->CallObjectMethod(m_jcallback_obj, m_jcreate_filter_methodid);
-    auto list_filter = new JavaListElementFilter(env, jlist_filter);
-    CheckAndRethrowException(env);
-    releaseJniEnv(attached_thread);
+    if (ClearException(env, logger.get(),
+                       "ListElementFilterFactory#createListElementFilter") ||
+        jlist_filter == nullptr) {
+      if (jlist_filter != nullptr) {
+        env->DeleteLocalRef(jlist_filter);
+      }
+      return new UnexpiredListElementFilter();
+    }
+    auto list_filter = new JavaListElementFilter(env, jlist_filter, logger);
+    env->DeleteLocalRef(jlist_filter);
     return list_filter;
   };
 
@@ -114,8 +247,9 @@ class JavaTimeProvider
     : public ROCKSDB_NAMESPACE::flink::FlinkCompactionFilter::TimeProvider,
       JniCallbackBase {
  public:
-  JavaTimeProvider(JNIEnv* env, jobject jtime_provider)
-      : JniCallbackBase(env, jtime_provider) {
+  JavaTimeProvider(JNIEnv* env, jobject jtime_provider,
+                   std::shared_ptr<ROCKSDB_NAMESPACE::Logger> logger)
+      : JniCallbackBase(env, jtime_provider), m_logger(std::move(logger)) {
     jclass jclazz = ROCKSDB_NAMESPACE::JavaClass::getJClass(
         env, "org/forstdb/FlinkCompactionFilter$TimeProvider");
     if (jclazz == nullptr) {
@@ -125,19 +259,23 @@ class JavaTimeProvider
     m_jcurrent_timestamp_methodid =
         env->GetMethodID(jclazz, "currentTimestamp", "()J");
     assert(m_jcurrent_timestamp_methodid != nullptr);
+    env->DeleteLocalRef(jclazz);
   }
 
+  // Nothing is expired by the minimal timestamp, returned if the call fails.
   int64_t CurrentTimestamp() const override {
-    jboolean attached_thread = JNI_FALSE;
-    JNIEnv* env = getJniEnv(&attached_thread);
+    JNIEnv* env = getAttachedJniEnv();
+    assert(env != nullptr);
     auto jtimestamp =
         env->CallLongMethod(m_jcallback_obj, m_jcurrent_timestamp_methodid);
-    CheckAndRethrowException(env);
-    releaseJniEnv(attached_thread);
+    if (ClearException(env, m_logger.get(), "TimeProvider#currentTimestamp")) {
+      return std::numeric_limits<int64_t>::min();
+    }
     return static_cast<int64_t>(jtimestamp);
   };
 
  private:
+  std::shared_ptr<ROCKSDB_NAMESPACE::Logger> m_logger;
   jmethodID m_jcurrent_timestamp_methodid;
 };
 
@@ -195,13 +333,13 @@ jlong Java_org_forstdb_FlinkCompactionFilter_createNewFlinkCompactionFilter0(
       *(reinterpret_cast<std::shared_ptr<
             ROCKSDB_NAMESPACE::flink::FlinkCompactionFilter::ConfigHolder>*>(
           config_holder_handle));
-  auto time_provider = new JavaTimeProvider(env, jtime_provider);
   auto logger =
       logger_handle == 0
           ? nullptr
           : *(reinterpret_cast<
                 std::shared_ptr<ROCKSDB_NAMESPACE::LoggerJniCallback>*>(
                 logger_handle));
+  auto time_provider = new JavaTimeProvider(env, jtime_provider, logger);
   return reinterpret_cast<jlong>(
       new ROCKSDB_NAMESPACE::flink::FlinkCompactionFilter(
           config_holder,
@@ -211,6 +349,86 @@ jlong Java_org_forstdb_FlinkCompactionFilter_createNewFlinkCompactionFilter0(
           logger));
 }
 
+/*
+ * Class:     org_forstdb_FlinkCompactionFilter
+ * Method:    createNewFlinkCompactionFilter1
+ * Signature: (JJJ)J
+ */
+jlong Java_org_forstdb_FlinkCompactionFilter_createNewFlinkCompactionFilter1(
+    JNIEnv* /* env */, jclass /* jcls */, jlong config_holder_handle,
+    jlong time_provider_handle, jlong logger_handle) {
+  auto config_holder =
+      *(reinterpret_cast<std::shared_ptr<
+            ROCKSDB_NAMESPACE::flink::FlinkCompactionFilter::ConfigHolder>*>(
+          config_holder_handle));
+  auto current_timestamp =
+      *(reinterpret_cast<std::shared_ptr<std::atomic<int64_t>>*>(
+          time_provider_handle));
+  auto logger =
+      logger_handle == 0
+          ? nullptr
+          : *(reinterpret_cast<
+                std::shared_ptr<ROCKSDB_NAMESPACE::LoggerJniCallback>*>(
+                logger_handle));
+  return reinterpret_cast<jlong>(
+      new ROCKSDB_NAMESPACE::flink::FlinkCompactionFilter(
+          config_holder,
+          std::unique_ptr<
+              ROCKSDB_NAMESPACE::flink::FlinkCompactionFilter::TimeProvider>(
+              new ROCKSDB_NAMESPACE::flink::FlinkCompactionFilter::
+                  SharedTimeProvider(current_timestamp)),
+          logger));
+}
+
+/*
+ * Class:     org_forstdb_FlinkCompactionFilter
+ * Method:    createNativeTimeProvider
+ * Signature: (J)J
+ */
+jlong Java_org_forstdb_FlinkCompactionFilter_createNativeTimeProvider(
+    JNIEnv* /* env */, jclass /* jcls */, jlong jcurrent_timestamp) {
+  return reinterpret_cast<jlong>(new std::shared_ptr<std::atomic<int64_t>>(
+      new std::atomic<int64_t>(static_cast<int64_t>(jcurrent_timestamp))));
+}
+
+/*
+ * Class:     org_forstdb_FlinkCompactionFilter
+ * Method:    disposeNativeTimeProvider
+ * Signature: (J)V
+ */
+void Java_org_forstdb_FlinkCompactionFilter_disposeNativeTimeProvider(
+    JNIEnv* /* env */, jclass /* jcls */, jlong handle) {
+  delete reinterpret_cast<std::shared_ptr<std::atomic<int64_t>>*>(handle);
+}
+
+/*
+ * Class:     org_forstdb_FlinkCompactionFilter
+ * Method:    setNativeTimeProviderTimestamp
+ * Signature: (JJ)V
+ */
+void Java_org_forstdb_FlinkCompactionFilter_setNativeTimeProviderTimestamp(
+    JNIEnv* /* env */, jclass /* jcls */, jlong handle,
+    jlong jcurrent_timestamp) {
+  auto* current_timestamp =
+      reinterpret_cast<std::shared_ptr<std::atomic<int64_t>>*>(handle);
+  (*current_timestamp)
+      ->store(static_cast<int64_t>(jcurrent_timestamp),
+              std::memory_order_relaxed);
+}
+
+/*
+ * Class:     org_forstdb_FlinkCompactionFilter
+ * Method:    getNativeTimeProviderTimestamp
+ * Signature: (J)J
+ */
+jlong Java_org_forstdb_FlinkCompactionFilter_getNativeTimeProviderTimestamp(
+    JNIEnv* /* env */, jclass /* jcls */, jlong handle) {
+  auto* current_timestamp =
+      reinterpret_cast<std::shared_ptr<std::atomic<int64_t>>*>(handle);
+  return static_cast<jlong>(
+      (*current_timestamp)->load(std::memory_order_relaxed));
+}
+
 /*
  * Class:     org_forstdb_FlinkCompactionFilter
  * Method:    configureFlinkCompactionFilter
@@ -240,3 +458,84 @@ jboolean Java_org_forstdb_FlinkCompactionFilter_configureFlinkCompactionFilter(
                           ListElementFilterFactory>(list_filter_factory)};
   return static_cast<jboolean>(config_holder->Configure(config));
 }
+
+/*
+ * Class:     org_forstdb_FlinkCompactionFilter
+ * Method:    createNewFlinkCompactionFilterFactory
+ * Signature: (JJJ)J
+ */
+jlong Java_org_forstdb_FlinkCompactionFilter_createNewFlinkCompactionFilterFactory(
+    JNIEnv* /* env */, jclass /* jcls */, jlong config_holder_handle,
+    jlong time_provider_handle, jlong logger_handle) {
+  auto config_holder =
+      *(reinterpret_cast<std::shared_ptr<
+            ROCKSDB_NAMESPACE::flink::FlinkCompactionFilter::ConfigHolder>*>(
+          config_holder_handle));
+  auto current_timestamp =
+      *(reinterpret_cast<std::shared_ptr<std::atomic<int64_t>>*>(
+          time_provider_handle));
+  auto logger =
+      logger_handle == 0
+          ? nullptr
+          : *(reinterpret_cast<
+                std::shared_ptr<ROCKSDB_NAMESPACE::LoggerJniCallback>*>(
+                logger_handle));
+  return reinterpret_cast<jlong>(
+      new std::shared_ptr<ROCKSDB_NAMESPACE::CompactionFilterFactory>(
+          new ROCKSDB_NAMESPACE::flink::FlinkCompactionFilterFactory(
+              config_holder, current_timestamp, logger)));
+}
+
+/*
+ * Class:     org_forstdb_FlinkCompactionFilter
+ * Method:    disposeFlinkCompactionFilterFactory
+ * Signature: (J)V
+ */
+void Java_org_forstdb_FlinkCompactionFilter_disposeFlinkCompactionFilterFactory(
+    JNIEnv* /* env */, jclass /* jcls */, jlong handle) {
+  delete reinterpret_cast<
+      std::shared_ptr<ROCKSDB_NAMESPACE::CompactionFilterFactory>*>(handle);
+}
+
+/*
+ * Class:     org_forstdb_FlinkCompactionFilter
+ * Method:    addFlinkTtlTablePropertiesCollectorFactory
+ * Signature: (JJ)V
+ */
+void Java_org_forstdb_FlinkCompactionFilter_addFlinkTtlTablePropertiesCollectorFactory(
+    JNIEnv* /* env */, jclass /* jcls */, jlong cf_options_handle,
+    jlong config_holder_handle) {
+  auto* cf_options =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyOptions*>(
+          cf_options_handle);
+  auto config_holder =
+      *(reinterpret_cast<std::shared_ptr<
+            ROCKSDB_NAMESPACE::flink::FlinkCompactionFilter::ConfigHolder>*>(
+          config_holder_handle));
+  cf_options->table_properties_collector_factories.emplace_back(
+      std::make_shared<
+          ROCKSDB_NAMESPACE::flink::FlinkTtlTablePropertiesCollectorFactory>(
+          config_holder));
+}
+
+/*
+ * Class:     org_forstdb_FlinkCompactionFilter
+ * Method:    deleteExpiredFiles
+ * Signature: (JJJJ)J
+ */
+jlong Java_org_forstdb_FlinkCompactionFilter_deleteExpiredFiles(
+    JNIEnv* env, jclass /* jcls */, jlong jdb_handle, jlong jcf_handle,
+    jlong jttl, jlong jcurrent_timestamp) {
+  auto* db = reinterpret_cast<ROCKSDB_NAMESPACE::DB*>(jdb_handle);
+  auto* column_family =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyHandle*>(jcf_handle);
+  uint64_t num_deleted = 0;
+  ROCKSDB_NAMESPACE::Status s = ROCKSDB_NAMESPACE::flink::DeleteExpiredFiles(
+      db, column_family == nullptr ? db->DefaultColumnFamily() : column_family,
+      static_cast<int64_t>(jttl), static_cast<int64_t>(jcurrent_timestamp),
+      &num_deleted);
+  if (!s.ok()) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(env, s);
+  }
+  return static_cast<jlong>(num_deleted);
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// This file implements the "bridge" between Java and C++ for the Flink
+// key-group utilities in utilities/flink/flink_key_groups.h.
+
+#include <jni.h>
+
+#include <memory>
+
+#include "include/org_forstdb_FlinkKeyGroupSstPartitionerFactory.h"
+#include "include/org_forstdb_FlinkKeyGroups.h"
+#include "forstjni/cplusplus_to_java_convert.h"
+#include "forstjni/portal.h"
+#include "utilities/flink/flink_key_groups.h"
+
+/*
+ * Class:     org_forstdb_FlinkKeyGroupSstPartitionerFactory
+ * Method:    newFlinkKeyGroupSstPartitionerFactory0
+ * Signature: (IJ)J
+ */
+jlong Java_org_forstdb_FlinkKeyGroupSstPartitionerFactory_newFlinkKeyGroupSstPartitionerFactory0(
+    JNIEnv*, jclass, jint jprefix_bytes, jlong jmin_file_size) {
+  auto* ptr = new std::shared_ptr<ROCKSDB_NAMESPACE::SstPartitionerFactory>(
+      std::make_shared<
+          ROCKSDB_NAMESPACE::flink::FlinkKeyGroupSstPartitionerFactory>(
+          static_cast<std::size_t>(jprefix_bytes),
+          static_cast<uint64_t>(jmin_file_size)));
+  return GET_CPLUSPLUS_POINTER(ptr);
+}
+
+/*
+ * Class:     org_forstdb_FlinkKeyGroupSstPartitionerFactory
+ * Method:    disposeInternal
+ * Signature: (J)V
+ */
+void Java_org_forstdb_FlinkKeyGroupSstPartitionerFactory_disposeInternal(
+    JNIEnv*, jobject, jlong jhandle) {
+  auto* ptr = reinterpret_cast<
+      std::shared_ptr<ROCKSDB_NAMESPACE::SstPartitionerFactory>*>(jhandle);
+  delete ptr;  // delete std::shared_ptr
+}
+
+/*
+ * Class:     org_forstdb_FlinkKeyGroups
+ * Method:    addKeyGroupTablePropertiesCollector
+ * Signature: (JI)V
+ */
+void Java_org_forstdb_FlinkKeyGroups_addKeyGroupTablePropertiesCollector(
+    JNIEnv*, jclass, jlong jcf_options_handle, jint jprefix_bytes) {
+  auto* cf_options = reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyOptions*>(
+      jcf_options_handle);
+  cf_options->table_properties_collector_factories.emplace_back(
+      std::make_shared<ROCKSDB_NAMESPACE::flink::
+                           FlinkKeyGroupTablePropertiesCollectorFactory>(
+          static_cast<std::size_t>(jprefix_bytes)));
+}
+
+/*
+ * Class:     org_forstdb_FlinkKeyGroups
+ * Method:    deleteKeyGroupRange
+ * Signature: (JJIII)V
+ */
+void Java_org_forstdb_FlinkKeyGroups_deleteKeyGroupRange(
+    JNIEnv* env, jclass, jlong jdb_handle, jlong jcf_handle,
+    jint jfirst_key_group, jint jlast_key_group, jint jprefix_bytes) {
+  auto* db = reinterpret_cast<ROCKSDB_NAMESPACE::DB*>(jdb_handle);
+  auto* column_family =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyHandle*>(jcf_handle);
+  ROCKSDB_NAMESPACE::Status s = ROCKSDB_NAMESPACE::flink::DeleteKeyGroupRange(
+      db, column_family == nullptr ? db->DefaultColumnFamily() : column_family,
+      static_cast<int>(jfirst_key_group), static_cast<int>(jlast_key_group),
+      static_cast<std::size_t>(jprefix_bytes));
+  if (!s.ok()) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(env, s);
+  }
+}
+
+/*
+ * Class:     org_forstdb_FlinkKeyGroups
+ * Method:    clipKeyGroupRange
+ * Signature: (JJIII)V
+ */
+void Java_org_forstdb_FlinkKeyGroups_clipKeyGroupRange(
+    JNIEnv* env, jclass, jlong jdb_handle, jlong jcf_handle,
+    jint jfirst_key_group, jint jlast_key_group, jint jprefix_bytes) {
+  auto* db = reinterpret_cast<ROCKSDB_NAMESPACE::DB*>(jdb_handle);
+  auto* column_family =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyHandle*>(jcf_handle);
+  ROCKSDB_NAMESPACE::Status s = ROCKSDB_NAMESPACE::flink::ClipKeyGroupRange(
+      db, column_family == nullptr ? db->DefaultColumnFamily() : column_family,
+      static_cast<int>(jfirst_key_group), static_cast<int>(jlast_key_group),
+      static_cast<std::size_t>(jprefix_bytes));
+  if (!s.ok()) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(env, s);
+  }
+}
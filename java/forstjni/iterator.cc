@@ -338,3 +338,80 @@ jint Java_org_forstdb_RocksIterator_valueByteArray0(
 
   return static_cast<jsize>(value_slice.size());
 }
+
+/*
+ * Writes the length in big endian, the byte order of Java's ByteBuffer.
+ */
+static char* PutBigEndian32(char* dst, uint32_t length) {
+  dst[0] = static_cast<char>((length >> 24) & 0xff);
+  dst[1] = static_cast<char>((length >> 16) & 0xff);
+  dst[2] = static_cast<char>((length >> 8) & 0xff);
+  dst[3] = static_cast<char>(length & 0xff);
+  return dst + 4;
+}
+
+/*
+ * Copies the entries from the current one into the buffer, each as the key
+ * length, the key, the value length and the value, and moves the iterator
+ * past them. Stops at maxEntries entries, at the first entry which does not
+ * fit the rest of the buffer, or at the first key without the prefix.
+ *
+ * Returns the number of entries in the upper 32 bits and the number of bytes
+ * written in the lower 32 bits.
+ *
+ * Class:     org_forstdb_RocksIterator
+ * Method:    nextBatch0
+ * Signature: (JLjava/nio/ByteBuffer;III[B)J
+ */
+jlong Java_org_forstdb_RocksIterator_nextBatch0(
+    JNIEnv* env, jobject /*jobj*/, jlong handle, jobject jtarget,
+    jint jtarget_off, jint jtarget_len, jint jmax_entries,
+    jbyteArray jprefix) {
+  auto* it = reinterpret_cast<ROCKSDB_NAMESPACE::Iterator*>(handle);
+  char* target = reinterpret_cast<char*>(env->GetDirectBufferAddress(jtarget));
+  if (target == nullptr || jtarget_off < 0 || jtarget_len < 0 ||
+      env->GetDirectBufferCapacity(jtarget) - jtarget_off < jtarget_len) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(
+        env, "Invalid target argument");
+    return 0;
+  }
+
+  std::string prefix;
+  if (jprefix != nullptr) {
+    const jsize prefix_len = env->GetArrayLength(jprefix);
+    prefix.resize(prefix_len);
+    env->GetByteArrayRegion(jprefix, 0, prefix_len,
+                            reinterpret_cast<jbyte*>(&prefix[0]));
+    if (env->ExceptionCheck()) {
+      // exception thrown: ArrayIndexOutOfBoundsException
+      return 0;
+    }
+  }
+
+  char* dst = target + jtarget_off;
+  size_t remaining = static_cast<size_t>(jtarget_len);
+  jint num_entries = 0;
+  while (num_entries < jmax_entries && it->Valid()) {
+    const ROCKSDB_NAMESPACE::Slice key = it->key();
+    if (!key.starts_with(prefix)) {
+      break;
+    }
+    const ROCKSDB_NAMESPACE::Slice value = it->value();
+    const size_t entry_size = 8 + key.size() + value.size();
+    if (entry_size > remaining) {
+      break;
+    }
+    dst = PutBigEndian32(dst, static_cast<uint32_t>(key.size()));
+    memcpy(dst, key.data(), key.size());
+    dst += key.size();
+    dst = PutBigEndian32(dst, static_cast<uint32_t>(value.size()));
+    memcpy(dst, value.data(), value.size());
+    dst += value.size();
+    remaining -= entry_size;
+    num_entries++;
+    it->Next();
+  }
+
+  const jlong num_bytes = static_cast<jlong>(jtarget_len - remaining);
+  return (static_cast<jlong>(num_entries) << 32) | num_bytes;
+}
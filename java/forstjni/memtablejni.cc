@@ -5,6 +5,7 @@
 //
 // This file implements the "bridge" between Java and C++ for MemTables.
 
+#include "include/org_forstdb_BTreeMemTableConfig.h"
 #include "include/org_forstdb_HashLinkedListMemTableConfig.h"
 #include "include/org_forstdb_HashSkipListMemTableConfig.h"
 #include "include/org_forstdb_SkipListMemTableConfig.h"
@@ -92,3 +93,13 @@ jlong Java_org_forstdb_SkipListMemTableConfig_newMemTableFactoryHandle0(
   ROCKSDB_NAMESPACE::IllegalArgumentExceptionJni::ThrowNew(env, s);
   return 0;
 }
+
+/*
+ * Class:     org_forstdb_BTreeMemTableConfig
+ * Method:    newMemTableFactoryHandle0
+ * Signature: ()J
+ */
+jlong Java_org_forstdb_BTreeMemTableConfig_newMemTableFactoryHandle0(
+    JNIEnv* /*env*/, jobject /*jobj*/) {
+  return GET_CPLUSPLUS_POINTER(new ROCKSDB_NAMESPACE::BTreeRepFactory());
+}
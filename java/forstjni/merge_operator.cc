@@ -16,6 +16,7 @@
 #include <memory>
 #include <string>
 
+#include "include/org_forstdb_ListAppendOperator.h"
 #include "include/org_forstdb_StringAppendOperator.h"
 #include "include/org_forstdb_UInt64AddOperator.h"
 #include "rocksdb/db.h"
@@ -70,6 +71,48 @@ void Java_org_forstdb_StringAppendOperator_disposeInternal(JNIEnv* /*env*/,
   delete sptr_string_append_op;  // delete std::shared_ptr
 }
 
+/*
+ * Class:     org_forstdb_ListAppendOperator
+ * Method:    newSharedListAppendOperator
+ * Signature: (C)J
+ */
+jlong Java_org_forstdb_ListAppendOperator_newSharedListAppendOperator__C(
+    JNIEnv* /*env*/, jclass /*jclazz*/, jchar jdelim) {
+  auto* sptr_list_append_op =
+      new std::shared_ptr<ROCKSDB_NAMESPACE::MergeOperator>(
+          ROCKSDB_NAMESPACE::MergeOperators::CreateListAppendOperator(
+              (char)jdelim));
+  return GET_CPLUSPLUS_POINTER(sptr_list_append_op);
+}
+
+jlong Java_org_forstdb_ListAppendOperator_newSharedListAppendOperator__Ljava_lang_String_2(
+    JNIEnv* env, jclass /*jclass*/, jstring jdelim) {
+  jboolean has_exception = JNI_FALSE;
+  auto delim =
+      ROCKSDB_NAMESPACE::JniUtil::copyStdString(env, jdelim, &has_exception);
+  if (has_exception == JNI_TRUE) {
+    return 0;
+  }
+  auto* sptr_list_append_op =
+      new std::shared_ptr<ROCKSDB_NAMESPACE::MergeOperator>(
+          ROCKSDB_NAMESPACE::MergeOperators::CreateListAppendOperator(delim));
+  return GET_CPLUSPLUS_POINTER(sptr_list_append_op);
+}
+
+/*
+ * Class:     org_forstdb_ListAppendOperator
+ * Method:    disposeInternal
+ * Signature: (J)V
+ */
+void Java_org_forstdb_ListAppendOperator_disposeInternal(JNIEnv* /*env*/,
+                                                         jobject /*jobj*/,
+                                                         jlong jhandle) {
+  auto* sptr_list_append_op =
+      reinterpret_cast<std::shared_ptr<ROCKSDB_NAMESPACE::MergeOperator>*>(
+          jhandle);
+  delete sptr_list_append_op;  // delete std::shared_ptr
+}
+
 /*
  * Class:     org_forstdb_UInt64AddOperator
  * Method:    newSharedUInt64AddOperator
@@ -4220,7 +4220,7 @@ void Java_org_forstdb_ColumnFamilyOptions_setCompactionFilterFactoryHandle(
     JNIEnv*, jobject, jlong jopt_handle,
     jlong jcompactionfilterfactory_handle) {
   auto* cff_factory = reinterpret_cast<
-      std::shared_ptr<ROCKSDB_NAMESPACE::CompactionFilterFactoryJniCallback>*>(
+      std::shared_ptr<ROCKSDB_NAMESPACE::CompactionFilterFactory>*>(
       jcompactionfilterfactory_handle);
   reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyOptions*>(jopt_handle)
       ->compaction_filter_factory = *cff_factory;
@@ -5184,6 +5184,10 @@ class TickerTypeJni {
       case ROCKSDB_NAMESPACE::Tickers::
           COMPRESSED_SECONDARY_CACHE_PROMOTION_SKIPS:
         return -0x46;
+      case ROCKSDB_NAMESPACE::Tickers::FLINK_FS_BYTES_READ:
+        return -0x47;
+      case ROCKSDB_NAMESPACE::Tickers::FLINK_FS_BYTES_WRITTEN:
+        return -0x48;
       case ROCKSDB_NAMESPACE::Tickers::TICKER_ENUM_MAX:
         // 0x5F was the max value in the initial copy of tickers to Java.
         // Since these values are exposed directly to Java clients, we keep
@@ -5570,6 +5574,10 @@ class TickerTypeJni {
       case -0x46:
         return ROCKSDB_NAMESPACE::Tickers::
             COMPRESSED_SECONDARY_CACHE_PROMOTION_SKIPS;
+      case -0x47:
+        return ROCKSDB_NAMESPACE::Tickers::FLINK_FS_BYTES_READ;
+      case -0x48:
+        return ROCKSDB_NAMESPACE::Tickers::FLINK_FS_BYTES_WRITTEN;
       case 0x5F:
         // 0x5F was the max value in the initial copy of tickers to Java.
         // Since these values are exposed directly to Java clients, we keep
@@ -5716,6 +5724,32 @@ class HistogramTypeJni {
       case ROCKSDB_NAMESPACE::Histograms::
           FILE_READ_VERIFY_FILE_CHECKSUMS_MICROS:
         return 0x41;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_OPEN_MICROS:
+        return 0x42;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_READ_MICROS:
+        return 0x43;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_READ_BYTES:
+        return 0x44;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_WRITE_MICROS:
+        return 0x45;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_SYNC_MICROS:
+        return 0x46;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_CLOSE_MICROS:
+        return 0x47;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_LIST_MICROS:
+        return 0x48;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_EXISTS_MICROS:
+        return 0x49;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_RENAME_MICROS:
+        return 0x4A;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_DELETE_MICROS:
+        return 0x4B;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_LINK_MICROS:
+        return 0x4C;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_GET_FILE_STATUS_MICROS:
+        return 0x4D;
+      case ROCKSDB_NAMESPACE::Histograms::FLINK_FS_MKDIRS_MICROS:
+        return 0x4E;
       case ROCKSDB_NAMESPACE::Histograms::HISTOGRAM_ENUM_MAX:
         // 0x1F for backwards compatibility on current minor version.
         return 0x1F;
@@ -5853,6 +5887,32 @@ class HistogramTypeJni {
       case 0x41:
         return ROCKSDB_NAMESPACE::Histograms::
             FILE_READ_VERIFY_FILE_CHECKSUMS_MICROS;
+      case 0x42:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_OPEN_MICROS;
+      case 0x43:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_READ_MICROS;
+      case 0x44:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_READ_BYTES;
+      case 0x45:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_WRITE_MICROS;
+      case 0x46:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_SYNC_MICROS;
+      case 0x47:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_CLOSE_MICROS;
+      case 0x48:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_LIST_MICROS;
+      case 0x49:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_EXISTS_MICROS;
+      case 0x4A:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_RENAME_MICROS;
+      case 0x4B:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_DELETE_MICROS;
+      case 0x4C:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_LINK_MICROS;
+      case 0x4D:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_GET_FILE_STATUS_MICROS;
+      case 0x4E:
+        return ROCKSDB_NAMESPACE::Histograms::FLINK_FS_MKDIRS_MICROS;
       case 0x1F:
         // 0x1F for backwards compatibility on current minor version.
         return ROCKSDB_NAMESPACE::Histograms::HISTOGRAM_ENUM_MAX;
@@ -548,6 +548,86 @@ jlong Java_org_forstdb_RocksDB_createColumnFamilyWithImport(
   return GET_CPLUSPLUS_POINTER(cf_handle);
 }
 
+/*
+ * Class:     org_forstdb_RocksDB
+ * Method:    createColumnFamilyWithImportAndClip
+ * Signature: (J[BIJJ[J[B[B)J
+ */
+jlong Java_org_forstdb_RocksDB_createColumnFamilyWithImportAndClip(
+    JNIEnv* env, jobject, jlong jdb_handle, jbyteArray jcf_name,
+    jint jcf_name_len, jlong j_cf_options, jlong j_cf_import_options,
+    jlongArray j_metadata_handle_array, jbyteArray jbegin_key,
+    jbyteArray jend_key) {
+  auto* db = reinterpret_cast<ROCKSDB_NAMESPACE::DB*>(jdb_handle);
+  jboolean has_exception = JNI_FALSE;
+  const std::string cf_name =
+      ROCKSDB_NAMESPACE::JniUtil::byteString<std::string>(
+          env, jcf_name, jcf_name_len,
+          [](const char* str, const size_t len) {
+            return std::string(str, len);
+          },
+          &has_exception);
+  if (has_exception == JNI_TRUE) {
+    // exception occurred
+    return 0;
+  }
+  const std::string begin_key =
+      ROCKSDB_NAMESPACE::JniUtil::byteString<std::string>(
+          env, jbegin_key,
+          [](const char* str, const size_t len) {
+            return std::string(str, len);
+          },
+          &has_exception);
+  if (has_exception == JNI_TRUE) {
+    // exception occurred
+    return 0;
+  }
+  const std::string end_key =
+      ROCKSDB_NAMESPACE::JniUtil::byteString<std::string>(
+          env, jend_key,
+          [](const char* str, const size_t len) {
+            return std::string(str, len);
+          },
+          &has_exception);
+  if (has_exception == JNI_TRUE) {
+    // exception occurred
+    return 0;
+  }
+  auto* cf_options =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyOptions*>(j_cf_options);
+
+  auto* cf_import_options =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ImportColumnFamilyOptions*>(
+          j_cf_import_options);
+
+  std::vector<const ROCKSDB_NAMESPACE::ExportImportFilesMetaData*> metadatas;
+  jlong* ptr_metadata_handle_array =
+      env->GetLongArrayElements(j_metadata_handle_array, nullptr);
+  if (ptr_metadata_handle_array == nullptr) {
+    // exception thrown: OutOfMemoryError
+    return 0;
+  }
+  const jsize array_size = env->GetArrayLength(j_metadata_handle_array);
+  for (jsize i = 0; i < array_size; ++i) {
+    metadatas.push_back(
+        reinterpret_cast<ROCKSDB_NAMESPACE::ExportImportFilesMetaData*>(
+            ptr_metadata_handle_array[i]));
+  }
+  env->ReleaseLongArrayElements(j_metadata_handle_array,
+                                ptr_metadata_handle_array, JNI_ABORT);
+
+  ROCKSDB_NAMESPACE::ColumnFamilyHandle* cf_handle = nullptr;
+  ROCKSDB_NAMESPACE::Status s = db->CreateColumnFamilyWithImport(
+      *cf_options, cf_name, *cf_import_options, metadatas, begin_key, end_key,
+      &cf_handle);
+  if (!s.ok()) {
+    // error occurred
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(env, s);
+    return 0;
+  }
+  return GET_CPLUSPLUS_POINTER(cf_handle);
+}
+
 /*
  * Class:     org_forstdb_RocksDB
  * Method:    dropColumnFamily
@@ -1285,6 +1365,71 @@ jint Java_org_forstdb_RocksDB_getDirect(JNIEnv* env, jobject /*jdb*/,
       jkey, jkey_off, jkey_len, jval, jval_off, jval_len, &has_exception);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// ROCKSDB_NAMESPACE::DB::GetMergeOperands
+
+/*
+ * Copies the merge operands of the key into the buffer, each as its length in
+ * big endian and its contents, without merging them.
+ *
+ * Returns the number of operands in the upper 32 bits and the number of bytes
+ * written in the lower 32 bits, or kNotFound.
+ *
+ * Class:     org_forstdb_RocksDB
+ * Method:    getMergeOperands
+ * Signature: (JJJ[BILjava/nio/ByteBuffer;III)J
+ */
+jlong Java_org_forstdb_RocksDB_getMergeOperands(
+    JNIEnv* env, jobject /*jdb*/, jlong jdb_handle, jlong jropt_handle,
+    jlong jcf_handle, jbyteArray jkey, jint jkey_len, jobject jtarget,
+    jint jtarget_off, jint jtarget_len, jint jmax_operands) {
+  auto* db = reinterpret_cast<ROCKSDB_NAMESPACE::DB*>(jdb_handle);
+  auto* cf_handle =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyHandle*>(jcf_handle);
+  auto& read_options =
+      *reinterpret_cast<ROCKSDB_NAMESPACE::ReadOptions*>(jropt_handle);
+  try {
+    ROCKSDB_NAMESPACE::JByteArraySlice key(env, jkey, 0, jkey_len);
+    ROCKSDB_NAMESPACE::JDirectBufferSlice target(env, jtarget, jtarget_off,
+                                                 jtarget_len);
+    if (jmax_operands <= 0) {
+      ROCKSDB_NAMESPACE::KVException::ThrowNew(
+          env, "Invalid maxOperands argument (not positive)");
+    }
+    std::vector<ROCKSDB_NAMESPACE::PinnableSlice> operands(jmax_operands);
+    ROCKSDB_NAMESPACE::GetMergeOperandsOptions options;
+    options.expected_max_number_of_operands = jmax_operands;
+    int num_operands = 0;
+    ROCKSDB_NAMESPACE::KVException::ThrowOnError(
+        env, db->GetMergeOperands(read_options, cf_handle, key.slice(),
+                                  operands.data(), &options, &num_operands));
+
+    char* dst = const_cast<char*>(target.slice().data());
+    size_t remaining = target.slice().size();
+    for (int i = 0; i < num_operands; i++) {
+      const ROCKSDB_NAMESPACE::PinnableSlice& operand = operands[i];
+      if (operand.size() + 4 > remaining) {
+        ROCKSDB_NAMESPACE::KVException::ThrowOnError(
+            env, ROCKSDB_NAMESPACE::Status::Incomplete(
+                     "The merge operands do not fit the buffer"));
+      }
+      const uint32_t size = static_cast<uint32_t>(operand.size());
+      dst[0] = static_cast<char>((size >> 24) & 0xff);
+      dst[1] = static_cast<char>((size >> 16) & 0xff);
+      dst[2] = static_cast<char>((size >> 8) & 0xff);
+      dst[3] = static_cast<char>(size & 0xff);
+      memcpy(dst + 4, operand.data(), operand.size());
+      dst += 4 + operand.size();
+      remaining -= 4 + operand.size();
+    }
+    const jlong num_bytes =
+        static_cast<jlong>(target.slice().size() - remaining);
+    return (static_cast<jlong>(num_operands) << 32) | num_bytes;
+  } catch (ROCKSDB_NAMESPACE::KVException& e) {
+    return e.Code();
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // ROCKSDB_NAMESPACE::DB::Merge
 
@@ -2228,6 +2373,133 @@ void Java_org_forstdb_RocksDB_multiGet__JJ_3J_3Ljava_nio_ByteBuffer_2_3I_3I_3Lja
 //        final long[] columnFamilyHandles, final ByteBuffer[] keysArray,
 //        final ByteBuffer[] valuesArray);
 
+/*
+ * Class:     org_forstdb_RocksDB
+ * Method:    multiGetIntoBuffer
+ * Signature: (JJJLjava/nio/ByteBuffer;[ILjava/nio/ByteBuffer;II[I[B)I
+ */
+jint Java_org_forstdb_RocksDB_multiGetIntoBuffer(
+    JNIEnv* env, jobject, jlong jdb_handle, jlong jropt_handle,
+    jlong jcf_handle, jobject jkeys, jintArray jkey_offsets, jobject jvalues,
+    jint jvalues_off, jint jvalues_len, jintArray jvalue_lengths,
+    jbyteArray jstatus_codes) {
+  auto* db = reinterpret_cast<ROCKSDB_NAMESPACE::DB*>(jdb_handle);
+  auto* cf_handle =
+      jcf_handle == 0
+          ? db->DefaultColumnFamily()
+          : reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyHandle*>(
+                jcf_handle);
+  const auto& read_opts =
+      *reinterpret_cast<ROCKSDB_NAMESPACE::ReadOptions*>(jropt_handle);
+
+  const jsize num_offsets = env->GetArrayLength(jkey_offsets);
+  if (num_offsets < 1) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(
+        env, "Invalid key offsets argument (no end offset)");
+    return 0;
+  }
+  const jsize num_keys = num_offsets - 1;
+  if (env->GetArrayLength(jvalue_lengths) < num_keys ||
+      env->GetArrayLength(jstatus_codes) < num_keys) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(
+        env,
+        "Invalid value lengths or status codes argument (shorter than the "
+        "number of keys)");
+    return 0;
+  }
+
+  char* keys_address = static_cast<char*>(env->GetDirectBufferAddress(jkeys));
+  const jlong keys_capacity = env->GetDirectBufferCapacity(jkeys);
+  if (keys_address == nullptr || keys_capacity < 0) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(
+        env,
+        "Invalid key argument (argument is not a valid direct ByteBuffer)");
+    return 0;
+  }
+  char* values_address =
+      static_cast<char*>(env->GetDirectBufferAddress(jvalues));
+  const jlong values_capacity = env->GetDirectBufferCapacity(jvalues);
+  if (values_address == nullptr || values_capacity < 0) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(
+        env,
+        "Invalid value argument (argument is not a valid direct ByteBuffer)");
+    return 0;
+  }
+  if (jvalues_off < 0 || jvalues_len < 0 ||
+      values_capacity - jvalues_off < jvalues_len) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(
+        env,
+        "Invalid value argument. Capacity is less than requested region "
+        "(offset + length).");
+    return 0;
+  }
+
+  std::vector<jint> key_offsets(num_offsets);
+  env->GetIntArrayRegion(jkey_offsets, 0, num_offsets, key_offsets.data());
+  if (env->ExceptionCheck()) {
+    // exception thrown: ArrayIndexOutOfBoundsException
+    return 0;
+  }
+  std::vector<ROCKSDB_NAMESPACE::Slice> keys;
+  keys.reserve(num_keys);
+  for (jsize i = 0; i < num_keys; i++) {
+    if (key_offsets[i] < 0 || key_offsets[i] > key_offsets[i + 1] ||
+        key_offsets[i + 1] > keys_capacity) {
+      ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(
+          env,
+          "Invalid key offsets argument (not ascending within the capacity "
+          "of the keys)");
+      return 0;
+    }
+    keys.emplace_back(keys_address + key_offsets[i],
+                      key_offsets[i + 1] - key_offsets[i]);
+  }
+
+  std::vector<ROCKSDB_NAMESPACE::PinnableSlice> values(num_keys);
+  std::vector<ROCKSDB_NAMESPACE::Status> statuses(num_keys);
+  db->MultiGet(read_opts, cf_handle, num_keys, keys.data(), values.data(),
+               statuses.data());
+
+  // Copy the values found one after the other, up to the first one which does
+  // not fit, so that the caller can resume from there.
+  std::vector<jint> value_lengths(num_keys);
+  std::vector<jbyte> status_codes(num_keys);
+  char* dst = values_address + jvalues_off;
+  size_t remaining = static_cast<size_t>(jvalues_len);
+  jint num_complete = num_keys;
+  for (jsize i = 0; i < num_keys; i++) {
+    value_lengths[i] = 0;
+    if (!statuses[i].ok()) {
+      status_codes[i] = ROCKSDB_NAMESPACE::StatusJni::toJavaStatusCode(
+          statuses[i].code());
+      continue;
+    }
+    const size_t size = values[i].size();
+    value_lengths[i] = static_cast<jint>(size);
+    if (num_complete == num_keys && size <= remaining) {
+      memcpy(dst, values[i].data(), size);
+      dst += size;
+      remaining -= size;
+      status_codes[i] = ROCKSDB_NAMESPACE::StatusJni::toJavaStatusCode(
+          ROCKSDB_NAMESPACE::Status::Code::kOk);
+    } else {
+      if (num_complete == num_keys) {
+        num_complete = i;
+      }
+      status_codes[i] = ROCKSDB_NAMESPACE::StatusJni::toJavaStatusCode(
+          ROCKSDB_NAMESPACE::Status::Code::kIncomplete);
+    }
+  }
+
+  env->SetIntArrayRegion(jvalue_lengths, 0, num_keys, value_lengths.data());
+  if (env->ExceptionCheck()) {
+    // exception thrown: ArrayIndexOutOfBoundsException
+    return 0;
+  }
+  env->SetByteArrayRegion(jstatus_codes, 0, num_keys, status_codes.data());
+  return num_complete;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // ROCKSDB_NAMESPACE::DB::KeyMayExist
 bool key_may_exist_helper(JNIEnv* env, jlong jdb_handle, jlong jcf_handle,
@@ -2636,6 +2908,32 @@ jlong Java_org_forstdb_RocksDB_iterator(JNIEnv*, jobject, jlong db_handle,
   return GET_CPLUSPLUS_POINTER(db->NewIterator(read_options, cf_handle));
 }
 
+/*
+ * Class:     org_forstdb_RocksDB
+ * Method:    prefixIterator
+ * Signature: (JJJ[BI)J
+ */
+jlong Java_org_forstdb_RocksDB_prefixIterator(JNIEnv* env, jobject,
+                                              jlong db_handle, jlong jcf_handle,
+                                              jlong jread_options_handle,
+                                              jbyteArray jprefix,
+                                              jint jprefix_len) {
+  auto* db = reinterpret_cast<ROCKSDB_NAMESPACE::DB*>(db_handle);
+  auto* cf_handle =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyHandle*>(jcf_handle);
+  auto& read_options =
+      *reinterpret_cast<ROCKSDB_NAMESPACE::ReadOptions*>(jread_options_handle);
+  std::string prefix(static_cast<size_t>(jprefix_len), '\0');
+  env->GetByteArrayRegion(jprefix, 0, jprefix_len,
+                          reinterpret_cast<jbyte*>(&prefix[0]));
+  if (env->ExceptionCheck()) {
+    // exception thrown: ArrayIndexOutOfBoundsException
+    return 0;
+  }
+  return GET_CPLUSPLUS_POINTER(
+      db->NewPrefixIterator(read_options, cf_handle, prefix));
+}
+
 /*
  * Class:     org_forstdb_RocksDB
  * Method:    iterators
@@ -226,6 +226,41 @@ void Java_org_forstdb_WriteBatch_putDirect(JNIEnv* env, jobject /*jobj*/,
       put, env, jkey, jkey_offset, jkey_len, jval, jval_offset, jval_len);
 }
 
+/*
+ * Class:     org_forstdb_WriteBatch
+ * Method:    appendRecordsDirect
+ * Signature: (JLjava/nio/ByteBuffer;III)V
+ */
+void Java_org_forstdb_WriteBatch_appendRecordsDirect(JNIEnv* env,
+                                                     jobject /*jobj*/,
+                                                     jlong jwb_handle,
+                                                     jobject jrecords,
+                                                     jint jrecords_offset,
+                                                     jint jrecords_len,
+                                                     jint jcount) {
+  auto* wb = reinterpret_cast<ROCKSDB_NAMESPACE::WriteBatch*>(jwb_handle);
+  assert(wb != nullptr);
+  char* records =
+      reinterpret_cast<char*>(env->GetDirectBufferAddress(jrecords));
+  if (records == nullptr || jrecords_offset < 0 || jrecords_len < 0 ||
+      jcount < 0 ||
+      env->GetDirectBufferCapacity(jrecords) <
+          static_cast<jlong>(jrecords_offset) + jrecords_len) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(
+        env, "Invalid records argument");
+    return;
+  }
+
+  // The records are validated and copied once into the batch, without any
+  // call back into Java
+  auto s = ROCKSDB_NAMESPACE::WriteBatchInternal::AppendRecords(
+      wb, ROCKSDB_NAMESPACE::Slice(records + jrecords_offset, jrecords_len),
+      static_cast<uint32_t>(jcount));
+  if (!s.ok()) {
+    ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(env, s);
+  }
+}
+
 /*
  * Class:     org_forstdb_WriteBatch
  * Method:    merge
@@ -18,6 +18,18 @@ public abstract class AbstractCompactionFilterFactory<T extends AbstractCompacti
     super(0L);
   }
 
+  /**
+   * Constructs a factory whose native handle is created by
+   * {@link #initializeNative(long...)} from the given handles, for
+   * subclasses backed by a native factory.
+   *
+   * @param nativeParameterHandles handles passed to
+   *     {@link #initializeNative(long...)}
+   */
+  protected AbstractCompactionFilterFactory(final long... nativeParameterHandles) {
+    super(nativeParameterHandles);
+  }
+
   @Override
   protected long initializeNative(final long... nativeParameterHandles) {
     return createNewCompactionFilterFactory0();
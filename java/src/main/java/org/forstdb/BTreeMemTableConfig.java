@@ -0,0 +1,26 @@
+// Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+package org.forstdb;
+
+/**
+ * The config for B+-tree memtable representation.
+ * <p>
+ * The B+-tree compares short keys sharing long prefixes, e.g. the serialized
+ * key-group, key and namespace of Flink state, mostly without reading the
+ * keys themselves, when the bytewise comparator is used. It supports
+ * concurrent memtable writes.
+ */
+public class BTreeMemTableConfig extends MemTableConfig {
+  /**
+   * BTreeMemTableConfig constructor
+   */
+  public BTreeMemTableConfig() {}
+
+  @Override protected long newMemTableFactoryHandle() {
+    return newMemTableFactoryHandle0();
+  }
+
+  private native long newMemTableFactoryHandle0();
+}
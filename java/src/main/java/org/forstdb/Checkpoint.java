@@ -24,6 +24,25 @@ public class Checkpoint extends RocksObject {
    *     instance is not initialized.
    */
   public static Checkpoint create(final RocksDB db) {
+    return create(db, 1);
+  }
+
+  /**
+   * Creates a Checkpoint object to be used for creating open-able
+   * snapshots, which links or copies the files of a snapshot in parallel.
+   *
+   * @param db {@link RocksDB} instance.
+   * @param maxBackgroundOperations the max number of threads linking or
+   *     copying files, more threads speed up snapshots on remote file
+   *     systems.
+   * @return a Checkpoint instance.
+   *
+   * @throws java.lang.IllegalArgumentException if {@link RocksDB}
+   *     instance is null.
+   * @throws java.lang.IllegalStateException if {@link RocksDB}
+   *     instance is not initialized.
+   */
+  public static Checkpoint create(final RocksDB db, final int maxBackgroundOperations) {
     if (db == null) {
       throw new IllegalArgumentException(
           "RocksDB instance shall not be null.");
@@ -31,7 +50,7 @@ public class Checkpoint extends RocksObject {
       throw new IllegalStateException(
           "RocksDB instance must be initialized.");
     }
-    return new Checkpoint(db);
+    return new Checkpoint(db, maxBackgroundOperations);
   }
 
   /**
@@ -56,11 +75,11 @@ public class Checkpoint extends RocksObject {
         exportColumnFamily(nativeHandle_, columnFamilyHandle.nativeHandle_, exportPath));
   }
 
-  private Checkpoint(final RocksDB db) {
-    super(newCheckpoint(db.nativeHandle_));
+  private Checkpoint(final RocksDB db, final int maxBackgroundOperations) {
+    super(newCheckpoint(db.nativeHandle_, maxBackgroundOperations));
   }
 
-  private static native long newCheckpoint(long dbHandle);
+  private static native long newCheckpoint(long dbHandle, int maxBackgroundOperations);
   @Override protected final native void disposeInternal(final long handle);
 
   private native void createCheckpoint(long handle, String checkpointPath)
@@ -37,12 +37,24 @@ public class EnvFlinkTestSuite implements AutoCloseable {
 
   private native void runAllTestSuites(long nativeObjectHandle);
 
+  private native void runBenchmarks(long nativeObjectHandle, int numOps);
+
   private native void disposeInternal(long nativeObjectHandle);
 
   public void runAllTestSuites() {
     runAllTestSuites(nativeObjectHandle);
   }
 
+  /**
+   * Measures the latency of small file operations going through JNI, which are
+   * printed as nanoseconds per operation.
+   *
+   * @param numOps the number of operations of each kind
+   */
+  public void runBenchmarks(int numOps) {
+    runBenchmarks(nativeObjectHandle, numOps);
+  }
+
   @Override
   public void close() throws Exception {
     disposeInternal(nativeObjectHandle);
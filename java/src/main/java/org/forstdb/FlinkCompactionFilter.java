@@ -5,6 +5,8 @@
 
 package org.forstdb;
 
+import java.nio.ByteBuffer;
+
 /**
  * Just a Java wrapper around FlinkCompactionFilter implemented in C++.
  *
@@ -25,18 +27,56 @@ public class FlinkCompactionFilter extends AbstractCompactionFilter<Slice> {
 
   public FlinkCompactionFilter(
       ConfigHolder configHolder, TimeProvider timeProvider, Logger logger) {
-    super(createNewFlinkCompactionFilter0(
-        configHolder.nativeHandle_, timeProvider, logger == null ? 0 : logger.nativeHandle_));
+    super(timeProvider instanceof NativeTimeProvider
+            ? createNewFlinkCompactionFilter1(configHolder.nativeHandle_,
+                ((NativeTimeProvider) timeProvider).nativeHandle_,
+                logger == null ? 0 : logger.nativeHandle_)
+            : createNewFlinkCompactionFilter0(configHolder.nativeHandle_, timeProvider,
+                logger == null ? 0 : logger.nativeHandle_));
   }
 
   private native static long createNewFlinkCompactionFilter0(
       long configHolderHandle, TimeProvider timeProvider, long loggerHandle);
+  private native static long createNewFlinkCompactionFilter1(
+      long configHolderHandle, long timeProviderHandle, long loggerHandle);
+  private native static long createNewFlinkCompactionFilterFactory(
+      long configHolderHandle, long timeProviderHandle, long loggerHandle);
+  private native static void disposeFlinkCompactionFilterFactory(long factoryHandle);
+  private native static void addFlinkTtlTablePropertiesCollectorFactory(
+      long columnFamilyOptionsHandle, long configHolderHandle);
+  private native static long deleteExpiredFiles(
+      long dbHandle, long columnFamilyHandle, long ttl, long currentTimestamp)
+      throws RocksDBException;
+  private native static long createNativeTimeProvider(long currentTimestamp);
+  private native static void disposeNativeTimeProvider(long timeProviderHandle);
+  private native static void setNativeTimeProviderTimestamp(
+      long timeProviderHandle, long currentTimestamp);
+  private native static long getNativeTimeProviderTimestamp(long timeProviderHandle);
   private native static long createNewFlinkCompactionFilterConfigHolder();
   private native static void disposeFlinkCompactionFilterConfigHolder(long configHolderHandle);
   private native static boolean configureFlinkCompactionFilter(long configHolderHandle,
       int stateType, int timestampOffset, long ttl, long queryTimeAfterNumEntries,
       int fixedElementLength, ListElementFilterFactory listElementFilterFactory);
 
+  /**
+   * Drops the table files, except those in level 0, whose state entries are all expired according
+   * to the timestamps recorded by the collector added with {@link
+   * FlinkCompactionFilterFactory#addTtlTablePropertiesCollector(ColumnFamilyOptions)}, instead of
+   * rewriting them in compactions.
+   *
+   * @param db the database.
+   * @param columnFamily the column family of the state, or null for the default one.
+   * @param ttl the time-to-live of the state in milliseconds.
+   * @param currentTimestamp the timestamp to check expiration against.
+   * @return the number of deleted files.
+   * @throws RocksDBException thrown if error happens in underlying native library.
+   */
+  public static long deleteExpiredFiles(final RocksDB db, final ColumnFamilyHandle columnFamily,
+      final long ttl, final long currentTimestamp) throws RocksDBException {
+    return deleteExpiredFiles(db.nativeHandle_,
+        columnFamily == null ? 0 : columnFamily.nativeHandle_, ttl, currentTimestamp);
+  }
+
   public interface ListElementFilter {
     /**
      * Gets offset of the first unexpired element in the list.
@@ -52,6 +92,31 @@ public class FlinkCompactionFilter extends AbstractCompactionFilter<Slice> {
      */
     @SuppressWarnings("unused")
     int nextUnexpiredOffset(byte[] list, long ttl, long currentTimestamp);
+
+    /**
+     * Gets offset of the first unexpired element in the list.
+     *
+     * <p>This is the method called by native code. The list is passed in a direct buffer which
+     * is reused by the calls, so it must not be accessed after the call returns. Implementations
+     * can override it to read the list without copying, by default the list is copied to call
+     * {@link #nextUnexpiredOffset(byte[], long, long)}.
+     *
+     * @param list direct buffer holding the serialised list of elements with timestamp from
+     *     index 0, its position and limit are undefined
+     * @param length byte length of the list
+     * @param ttl time-to-live of the list elements
+     * @param currentTimestamp current timestamp to check expiration against
+     * @return offset of the first unexpired element in the list
+     */
+    @SuppressWarnings("unused")
+    default int nextUnexpiredOffset(
+        ByteBuffer list, int length, long ttl, long currentTimestamp) {
+      byte[] bytes = new byte[length];
+      ByteBuffer view = list.duplicate();
+      view.clear();
+      view.get(bytes);
+      return nextUnexpiredOffset(bytes, ttl, currentTimestamp);
+    }
   }
 
   public interface ListElementFilterFactory {
@@ -126,6 +191,41 @@ public class FlinkCompactionFilter extends AbstractCompactionFilter<Slice> {
     long currentTimestamp();
   }
 
+  /**
+   * Provides the current timestamp which is kept in native memory and set from Java, e.g.
+   * periodically by a timer.
+   *
+   * <p>Unlike other {@link TimeProvider}s, it is read by the compaction threads without calling
+   * back into Java, so they do not have to be attached to the JVM. The filters expire state
+   * against the last set timestamp.
+   */
+  public static class NativeTimeProvider extends RocksObject implements TimeProvider {
+    public NativeTimeProvider(long currentTimestamp) {
+      super(createNativeTimeProvider(currentTimestamp));
+    }
+
+    public void setCurrentTimestamp(long currentTimestamp) {
+      setNativeTimeProviderTimestamp(nativeHandle_, currentTimestamp);
+    }
+
+    @Override
+    public long currentTimestamp() {
+      return getNativeTimeProviderTimestamp(nativeHandle_);
+    }
+
+    @Override
+    protected void disposeInternal(long handle) {
+      disposeNativeTimeProvider(handle);
+    }
+  }
+
+  /**
+   * Creates the {@link FlinkCompactionFilter}s of a column family, which are configured at once.
+   *
+   * <p>With a {@link NativeTimeProvider} the factory is implemented in C++, so compactions neither
+   * call back into Java to create the filters nor have to be attached to the JVM. Otherwise each
+   * compaction calls {@link #createCompactionFilter(Context)}.
+   */
   public static class FlinkCompactionFilterFactory
       extends AbstractCompactionFilterFactory<FlinkCompactionFilter> {
     private final ConfigHolder configHolder;
@@ -139,11 +239,35 @@ public class FlinkCompactionFilter extends AbstractCompactionFilter<Slice> {
 
     @SuppressWarnings("WeakerAccess")
     public FlinkCompactionFilterFactory(TimeProvider timeProvider, Logger logger) {
-      this.configHolder = new ConfigHolder();
+      this(new ConfigHolder(), timeProvider, logger);
+    }
+
+    private FlinkCompactionFilterFactory(
+        ConfigHolder configHolder, TimeProvider timeProvider, Logger logger) {
+      super(timeProvider instanceof NativeTimeProvider
+              ? new long[] {configHolder.nativeHandle_,
+                  ((NativeTimeProvider) timeProvider).nativeHandle_,
+                  logger == null ? 0 : logger.nativeHandle_}
+              : new long[] {0L});
+      this.configHolder = configHolder;
       this.timeProvider = timeProvider;
       this.logger = logger;
     }
 
+    @Override
+    protected long initializeNative(final long... nativeParameterHandles) {
+      if (nativeParameterHandles.length != 3) {
+        return super.initializeNative(nativeParameterHandles);
+      }
+      return createNewFlinkCompactionFilterFactory(
+          nativeParameterHandles[0], nativeParameterHandles[1], nativeParameterHandles[2]);
+    }
+
+    /** Returns true if the filters are created natively, see {@link NativeTimeProvider}. */
+    public boolean isNative() {
+      return timeProvider instanceof NativeTimeProvider;
+    }
+
     @Override
     public void close() {
       super.close();
@@ -153,6 +277,26 @@ public class FlinkCompactionFilter extends AbstractCompactionFilter<Slice> {
       }
     }
 
+    @Override
+    protected void disposeInternal() {
+      if (isNative()) {
+        disposeFlinkCompactionFilterFactory(nativeHandle_);
+      } else {
+        super.disposeInternal();
+      }
+    }
+
+    /**
+     * Adds a collector to the options which records the range of the state timestamps of each
+     * table file, with the config of this factory, for {@link #deleteExpiredFiles(RocksDB,
+     * ColumnFamilyHandle, long, long)}.
+     *
+     * @param options the options of the column family this factory is set to.
+     */
+    public void addTtlTablePropertiesCollector(final ColumnFamilyOptions options) {
+      addFlinkTtlTablePropertiesCollectorFactory(options.nativeHandle_, configHolder.nativeHandle_);
+    }
+
     @Override
     public FlinkCompactionFilter createCompactionFilter(Context context) {
       return new FlinkCompactionFilter(configHolder, timeProvider, logger);
@@ -32,10 +32,28 @@ public class FlinkEnv extends Env {
    * formatted as "{fs-schema-supported-by-flink}://xxx"
    */
   public FlinkEnv(final String basePath, final Object fileSystem) {
-    super(createFlinkEnv(basePath, fileSystem));
+    super(createFlinkEnv(basePath, fileSystem, 0));
   }
 
-  private static native long createFlinkEnv(final String basePath, final Object fileSystem);
+  /**
+   * <p>Creates a new environment that is used for Flink environment, and
+   * records the latencies and bytes of the Flink FileSystem calls in the
+   * given statistics.</p>
+   *
+   * <p>Pass the same statistics to {@link DBOptions#setStatistics(Statistics)}
+   * to read them along with the statistics of the DB.</p>
+   *
+   * @param basePath the base path string for the given Flink file system,
+   * formatted as "{fs-schema-supported-by-flink}://xxx"
+   * @param fileSystem the Flink file system
+   * @param statistics the statistics to record into
+   */
+  public FlinkEnv(final String basePath, final Object fileSystem, final Statistics statistics) {
+    super(createFlinkEnv(basePath, fileSystem, statistics.nativeHandle_));
+  }
+
+  private static native long createFlinkEnv(
+      final String basePath, final Object fileSystem, final long statisticsHandle);
 
   @Override protected final native void disposeInternal(final long handle);
 }
\ No newline at end of file
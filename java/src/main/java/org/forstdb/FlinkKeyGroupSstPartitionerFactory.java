@@ -0,0 +1,26 @@
+// Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+package org.forstdb;
+
+/**
+ * Partitions the SST files of compactions between Flink key-groups, so that a file holds the keys
+ * of a single key-group unless it is still smaller than the min file size. See {@link
+ * FlinkKeyGroups} for the operations on key-group ranges taking advantage of such files.
+ */
+public class FlinkKeyGroupSstPartitionerFactory extends SstPartitionerFactory {
+  public FlinkKeyGroupSstPartitionerFactory(final int prefixBytes) {
+    this(prefixBytes, 0);
+  }
+
+  public FlinkKeyGroupSstPartitionerFactory(final int prefixBytes, final long minFileSize) {
+    super(newFlinkKeyGroupSstPartitionerFactory0(prefixBytes, minFileSize));
+  }
+
+  private static native long newFlinkKeyGroupSstPartitionerFactory0(
+      int prefixBytes, long minFileSize);
+
+  @Override protected final native void disposeInternal(final long handle);
+}
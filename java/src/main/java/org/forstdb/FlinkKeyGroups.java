@@ -0,0 +1,83 @@
+// Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+package org.forstdb;
+
+/**
+ * Operations on the Flink keyed state of a range of key-groups, e.g. after rescaling.
+ *
+ * <p>The keys are prefixed with their key-group in {@link #keyGroupPrefixBytes(int)} bytes. With
+ * a {@link FlinkKeyGroupSstPartitionerFactory} and the collector added by {@link
+ * #addKeyGroupTablePropertiesCollector(ColumnFamilyOptions, int)}, whole files are dropped instead
+ * of their keys.
+ */
+public final class FlinkKeyGroups {
+  private FlinkKeyGroups() {}
+
+  /**
+   * Returns the number of bytes of the key-group prefix for the max parallelism.
+   *
+   * @param maxParallelism the max parallelism of the job.
+   * @return 1 if the max parallelism is at most 128, 2 otherwise.
+   */
+  public static int keyGroupPrefixBytes(final int maxParallelism) {
+    return maxParallelism > 128 ? 2 : 1;
+  }
+
+  /**
+   * Adds a collector to the options which records the key-group range of each table file.
+   *
+   * @param options the options of the column family.
+   * @param prefixBytes the number of bytes of the key-group prefix.
+   */
+  public static void addKeyGroupTablePropertiesCollector(
+      final ColumnFamilyOptions options, final int prefixBytes) {
+    addKeyGroupTablePropertiesCollector(options.nativeHandle_, prefixBytes);
+  }
+
+  /**
+   * Deletes the keys of the key-groups in [firstKeyGroup, lastKeyGroup]. The files of level 1 and
+   * below entirely in the key-groups are dropped, only the remaining keys are deleted with a
+   * range deletion. Snapshots before the delete might not see the data of the dropped files.
+   *
+   * @param db the database.
+   * @param columnFamily the column family, or null for the default one.
+   * @param firstKeyGroup the first key-group to delete.
+   * @param lastKeyGroup the last key-group to delete.
+   * @param prefixBytes the number of bytes of the key-group prefix.
+   * @throws RocksDBException thrown if error happens in underlying native library.
+   */
+  public static void deleteKeyGroupRange(final RocksDB db, final ColumnFamilyHandle columnFamily,
+      final int firstKeyGroup, final int lastKeyGroup, final int prefixBytes)
+      throws RocksDBException {
+    deleteKeyGroupRange(db.nativeHandle_, columnFamily == null ? 0 : columnFamily.nativeHandle_,
+        firstKeyGroup, lastKeyGroup, prefixBytes);
+  }
+
+  /**
+   * Keeps only the keys of the key-groups in [firstKeyGroup, lastKeyGroup], dropping or clipping
+   * the files of the column family. The column family must not be written concurrently.
+   *
+   * @param db the database.
+   * @param columnFamily the column family, or null for the default one.
+   * @param firstKeyGroup the first key-group to keep.
+   * @param lastKeyGroup the last key-group to keep.
+   * @param prefixBytes the number of bytes of the key-group prefix.
+   * @throws RocksDBException thrown if error happens in underlying native library.
+   */
+  public static void clipKeyGroupRange(final RocksDB db, final ColumnFamilyHandle columnFamily,
+      final int firstKeyGroup, final int lastKeyGroup, final int prefixBytes)
+      throws RocksDBException {
+    clipKeyGroupRange(db.nativeHandle_, columnFamily == null ? 0 : columnFamily.nativeHandle_,
+        firstKeyGroup, lastKeyGroup, prefixBytes);
+  }
+
+  private static native void addKeyGroupTablePropertiesCollector(
+      long columnFamilyOptionsHandle, int prefixBytes);
+  private static native void deleteKeyGroupRange(long dbHandle, long columnFamilyHandle,
+      int firstKeyGroup, int lastKeyGroup, int prefixBytes) throws RocksDBException;
+  private static native void clipKeyGroupRange(long dbHandle, long columnFamilyHandle,
+      int firstKeyGroup, int lastKeyGroup, int prefixBytes) throws RocksDBException;
+}
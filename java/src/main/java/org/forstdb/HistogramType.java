@@ -185,6 +185,71 @@ public enum HistogramType {
 
   FILE_READ_VERIFY_FILE_CHECKSUMS_MICROS((byte) 0x41),
 
+  /**
+   * Latency of opening an input stream or creating an output stream of Flink FileSystem.
+   */
+  FLINK_FS_OPEN_MICROS((byte) 0x42),
+
+  /**
+   * Latency of reads from Flink FileSystem.
+   */
+  FLINK_FS_READ_MICROS((byte) 0x43),
+
+  /**
+   * Size of reads from Flink FileSystem.
+   */
+  FLINK_FS_READ_BYTES((byte) 0x44),
+
+  /**
+   * Latency of writes to Flink FileSystem.
+   */
+  FLINK_FS_WRITE_MICROS((byte) 0x45),
+
+  /**
+   * Latency of flushing or syncing an output stream of Flink FileSystem.
+   */
+  FLINK_FS_SYNC_MICROS((byte) 0x46),
+
+  /**
+   * Latency of closing a stream of Flink FileSystem.
+   */
+  FLINK_FS_CLOSE_MICROS((byte) 0x47),
+
+  /**
+   * Latency of listing a directory of Flink FileSystem.
+   */
+  FLINK_FS_LIST_MICROS((byte) 0x48),
+
+  /**
+   * Latency of checking the existence of a path of Flink FileSystem.
+   */
+  FLINK_FS_EXISTS_MICROS((byte) 0x49),
+
+  /**
+   * Latency of renames in Flink FileSystem.
+   */
+  FLINK_FS_RENAME_MICROS((byte) 0x4A),
+
+  /**
+   * Latency of deletes in Flink FileSystem.
+   */
+  FLINK_FS_DELETE_MICROS((byte) 0x4B),
+
+  /**
+   * Latency of links in Flink FileSystem.
+   */
+  FLINK_FS_LINK_MICROS((byte) 0x4C),
+
+  /**
+   * Latency of getting the status of a path of Flink FileSystem.
+   */
+  FLINK_FS_GET_FILE_STATUS_MICROS((byte) 0x4D),
+
+  /**
+   * Latency of creating directories in Flink FileSystem.
+   */
+  FLINK_FS_MKDIRS_MICROS((byte) 0x4E),
+
   // 0x1F for backwards compatibility on current minor version.
   HISTOGRAM_ENUM_MAX((byte) 0x1F);
 
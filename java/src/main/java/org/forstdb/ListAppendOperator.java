@@ -0,0 +1,33 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+package org.forstdb;
+
+/**
+ * ListAppendOperator is a merge operator for lists of elements joined by a
+ * delimiter, e.g. list states, where each operand appends elements.
+ * <p>
+ * Unlike {@link StringAppendOperator}, the operands are only concatenated
+ * once per merge, and flushes and compactions collapse runs of operands into
+ * a single segment of the list. The segments can be read without
+ * concatenating them with {@link RocksDB#getMergeOperands}.
+ */
+public class ListAppendOperator extends MergeOperator {
+  public ListAppendOperator() {
+    this(',');
+  }
+
+  public ListAppendOperator(final char delim) {
+    super(newSharedListAppendOperator(delim));
+  }
+
+  public ListAppendOperator(final String delim) {
+    super(newSharedListAppendOperator(delim));
+  }
+
+  private static native long newSharedListAppendOperator(final char delim);
+  private static native long newSharedListAppendOperator(final String delim);
+  @Override protected final native void disposeInternal(final long handle);
+}
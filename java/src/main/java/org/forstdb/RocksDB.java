@@ -825,6 +825,43 @@ public class RocksDB extends RocksObject {
     return columnFamilyHandle;
   }
 
+  /**
+   * Creates a new column family by importing the column families of
+   * {@code metadatas}, clipped to the range [beginKey, endKey) like
+   * {@link #clipColumnFamily(ColumnFamilyHandle, byte[], byte[])}, e.g. to
+   * restore a column family from several others when rescaling.
+   * Files entirely outside the range are not imported at all, and only the
+   * files overlapping the range boundaries are clipped afterwards.
+   *
+   * @param columnFamilyDescriptor column family to be created.
+   * @param importColumnFamilyOptions options of the import.
+   * @param metadatas the column families to import.
+   * @param beginKey First key of the new column family (inclusive)
+   * @param endKey Last key of the new column family (exclusive)
+   * @return {@link org.forstdb.ColumnFamilyHandle} instance.
+   *
+   * @throws RocksDBException thrown if error happens in underlying
+   *    native library.
+   */
+  public ColumnFamilyHandle createColumnFamilyWithImport(
+      final ColumnFamilyDescriptor columnFamilyDescriptor,
+      final ImportColumnFamilyOptions importColumnFamilyOptions,
+      final List<ExportImportFilesMetaData> metadatas, final byte[] beginKey,
+      final byte[] endKey) throws RocksDBException {
+    final int metadataNum = metadatas.size();
+    final long[] metadataHandleList = new long[metadataNum];
+    for (int i = 0; i < metadataNum; i++) {
+      metadataHandleList[i] = metadatas.get(i).getNativeHandle();
+    }
+    final ColumnFamilyHandle columnFamilyHandle = new ColumnFamilyHandle(this,
+        createColumnFamilyWithImportAndClip(nativeHandle_, columnFamilyDescriptor.getName(),
+            columnFamilyDescriptor.getName().length,
+            columnFamilyDescriptor.getOptions().nativeHandle_,
+            importColumnFamilyOptions.nativeHandle_, metadataHandleList, beginKey, endKey));
+    ownedColumnFamilyHandles.add(columnFamilyHandle);
+    return columnFamilyHandle;
+  }
+
   /**
    * Drops the column family specified by {@code columnFamilyHandle}. This call
    * only records a drop record in the manifest and prevents the column
@@ -2557,6 +2594,106 @@ public class RocksDB extends RocksObject {
     return results;
   }
 
+  /**
+   * Fetches the values of a batch of keys of a column family with a single
+   * JNI call and without allocating objects per key.
+   * <p>
+   * The keys are concatenated in one direct buffer, and the values found are
+   * copied one after the other into another direct buffer, in the order of the
+   * keys, up to the first value which does not fit the remaining space. That
+   * value and the following values found are marked
+   * {@link Status.Code#Incomplete}, and the lookup can be resumed from the
+   * returned index with a drained buffer.
+   * </p>
+   *
+   * @param readOptions Read options
+   * @param columnFamilyHandle the column family of the keys, or null for the
+   *     default column family
+   * @param keys direct buffer of the concatenated keys
+   * @param keyOffsets the ascending positions of the keys in {@code keys},
+   *     followed by the end of the last key, i.e. the key i is at
+   *     [keyOffsets[i], keyOffsets[i + 1])
+   * @param values direct buffer receiving the values from its position, which
+   *     is advanced past the copied values
+   * @param valueLengths receives the size of the value of each key, also of the
+   *     values which did not fit, or 0 if the key is not found
+   * @param statusCodes receives the {@link Status.Code} of each key:
+   *     {@link Status.Code#Ok} if its value was copied,
+   *     {@link Status.Code#NotFound} if it does not exist,
+   *     {@link Status.Code#Incomplete} if its value was not copied, or the
+   *     error of its lookup
+   * @return the index of the first key whose value was not copied, or the
+   *     number of keys if all the values were copied
+   * @throws RocksDBException if error happens in underlying native library.
+   * @throws IllegalArgumentException thrown if the buffers are not direct or
+   *     the arrays are too short.
+   */
+  public int multiGetIntoBuffer(final ReadOptions readOptions,
+      final ColumnFamilyHandle columnFamilyHandle, final ByteBuffer keys,
+      final int[] keyOffsets, final ByteBuffer values, final int[] valueLengths,
+      final byte[] statusCodes) throws RocksDBException {
+    if (!keys.isDirect() || !values.isDirect()) {
+      throw new IllegalArgumentException("Key and value buffers must be direct byte buffers");
+    }
+    final int numKeys = keyOffsets.length - 1;
+    if (numKeys < 0 || valueLengths.length < numKeys || statusCodes.length < numKeys) {
+      throw new IllegalArgumentException(
+          "For each key there must be a value length and a status code.");
+    }
+
+    final int numComplete = multiGetIntoBuffer(nativeHandle_, readOptions.nativeHandle_,
+        columnFamilyHandle == null ? 0 : columnFamilyHandle.nativeHandle_, keys, keyOffsets,
+        values, values.position(), values.remaining(), valueLengths, statusCodes);
+
+    int copied = 0;
+    for (int i = 0; i < numComplete; i++) {
+      if (statusCodes[i] == Status.Code.Ok.getValue()) {
+        copied += valueLengths[i];
+      }
+    }
+    values.position(values.position() + copied);
+    return numComplete;
+  }
+
+  /**
+   * Copies the merge operands of a key into a direct buffer without merging
+   * them, e.g. the segments of a list merged by {@link ListAppendOperator},
+   * so that reading a long list does not concatenate it natively.
+   * <p>
+   * Each operand is written as its length, as a big endian int, i.e. to be
+   * read with {@link ByteBuffer#getInt()} in the default byte order, followed
+   * by its contents, from the oldest to the newest. A Put or a merge result
+   * under the operands is returned as the first operand.
+   * </p>
+   *
+   * @param readOptions Read options
+   * @param columnFamilyHandle the column family of the key
+   * @param key the key
+   * @param operands the direct buffer receiving the operands from its position,
+   *     which is advanced past the written operands
+   * @param maxOperands the maximum number of operands expected
+   * @return the number of operands, or {@link #NOT_FOUND} if the key does not
+   *     exist
+   * @throws RocksDBException if error happens in underlying native library,
+   *     with the status Incomplete if the key has more than maxOperands
+   *     operands or the operands do not fit the buffer
+   */
+  public int getMergeOperands(final ReadOptions readOptions,
+      final ColumnFamilyHandle columnFamilyHandle, final byte[] key, final ByteBuffer operands,
+      final int maxOperands) throws RocksDBException {
+    if (!operands.isDirect()) {
+      throw new IllegalArgumentException("The operands buffer must be a direct byte buffer");
+    }
+    final long result = getMergeOperands(nativeHandle_, readOptions.nativeHandle_,
+        columnFamilyHandle.nativeHandle_, key, key.length, operands, operands.position(),
+        operands.remaining(), maxOperands);
+    if (result == NOT_FOUND) {
+      return NOT_FOUND;
+    }
+    operands.position(operands.position() + (int) result);
+    return (int) (result >>> 32);
+  }
+
   /**
    *  Check if a key exists in the database.
    *  This method is not as lightweight as {@code keyMayExist} but it gives a 100% guarantee
@@ -3315,6 +3452,35 @@ public class RocksDB extends RocksObject {
         this, iterator(nativeHandle_, columnFamilyHandle.nativeHandle_, readOptions.nativeHandle_));
   }
 
+  /**
+   * <p>Return a heap-allocated iterator over the keys of a ColumnFamily
+   * starting with a prefix. The iteration is bounded natively by the prefix
+   * and its successor, so that the iterator becomes invalid past the prefix
+   * in both directions without checking the keys in Java, and the files
+   * without the prefix are skipped with the prefix bloom filters when the
+   * prefix extractor of the ColumnFamily maps the keys to the prefix. The
+   * bounds only narrow those of {@code readOptions}.</p>
+   *
+   * <p>Only supported with the bytewise comparator, otherwise the status of
+   * the iterator is NotSupported.</p>
+   *
+   * <p>Caller should close the iterator when it is no longer needed.
+   * The returned iterator should be closed before this db is closed.
+   * </p>
+   *
+   * @param columnFamilyHandle {@link org.forstdb.ColumnFamilyHandle}
+   *     instance
+   * @param readOptions {@link ReadOptions} instance.
+   * @param prefix the prefix of the keys to iterate over.
+   * @return instance of iterator object.
+   */
+  public RocksIterator newPrefixIterator(final ColumnFamilyHandle columnFamilyHandle,
+      final ReadOptions readOptions, final byte[] prefix) {
+    return new RocksIterator(this,
+        prefixIterator(nativeHandle_, columnFamilyHandle.nativeHandle_, readOptions.nativeHandle_,
+            prefix, prefix.length));
+  }
+
   /**
    * Returns iterators from a consistent database state across multiple
    * column families. Iterators are heap allocated and need to be deleted
@@ -4859,6 +5025,11 @@ public class RocksDB extends RocksObject {
       final int columnFamilyNamelen, final long columnFamilyOptions,
       final long importColumnFamilyOptions, final long[] metadataHandleList)
       throws RocksDBException;
+  private native long createColumnFamilyWithImportAndClip(final long handle,
+      final byte[] columnFamilyName, final int columnFamilyNamelen,
+      final long columnFamilyOptions, final long importColumnFamilyOptions,
+      final long[] metadataHandleList, final byte[] beginKey, final byte[] endKey)
+      throws RocksDBException;
   private native void dropColumnFamily(
       final long handle, final long cfHandle) throws RocksDBException;
   private native void dropColumnFamilies(final long handle,
@@ -4984,6 +5155,10 @@ public class RocksDB extends RocksObject {
       final long[] columnFamilyHandles, final ByteBuffer[] keysArray, final int[] keyOffsets,
       final int[] keyLengths, final ByteBuffer[] valuesArray, final int[] valuesSizeArray,
       final Status[] statusArray);
+  private native int multiGetIntoBuffer(final long dbHandle, final long rOptHandle,
+      final long cfHandle, final ByteBuffer keys, final int[] keyOffsets, final ByteBuffer values,
+      final int valuesOffset, final int valuesLength, final int[] valueLengths,
+      final byte[] statusCodes);
 
   private native boolean keyExists(final long handle, final long cfHandle, final long readOptHandle,
       final byte[] key, final int keyOffset, final int keyLength);
@@ -5001,6 +5176,8 @@ public class RocksDB extends RocksObject {
       int keyLength, ByteBuffer value, int valueOffset, int valueLength, long cfHandle)
       throws RocksDBException;
   private native long iterator(final long handle, final long cfHandle, final long readOptHandle);
+  private native long prefixIterator(final long handle, final long cfHandle,
+      final long readOptHandle, final byte[] prefix, final int prefixLength);
   private native long[] iterators(final long handle,
       final long[] columnFamilyHandles, final long readOptHandle)
       throws RocksDBException;
@@ -5016,6 +5193,9 @@ public class RocksDB extends RocksObject {
   private native int getDirect(long handle, long readOptHandle, ByteBuffer key, int keyOffset,
       int keyLength, ByteBuffer value, int valueOffset, int valueLength, long cfHandle)
       throws RocksDBException;
+  private native long getMergeOperands(long handle, long readOptHandle, long cfHandle,
+      byte[] key, int keyLength, ByteBuffer operands, int operandsOffset, int operandsLength,
+      int maxOperands) throws RocksDBException;
   private native boolean keyMayExistDirect(final long handle, final long cfHhandle,
       final long readOptHandle, final ByteBuffer key, final int keyOffset, final int keyLength);
   private native int[] keyMayExistDirectFoundValue(final long handle, final long cfHhandle,
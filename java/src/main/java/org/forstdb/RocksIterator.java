@@ -188,6 +188,38 @@ public class RocksIterator extends AbstractRocksIterator<RocksDB> {
     return valueByteArray0(nativeHandle_, value, offset, len);
   }
 
+  /**
+   * <p>Copies the current entry and those following it into a direct buffer
+   * with a single JNI call, and moves the iterator past the copied entries.</p>
+   *
+   * <p>Each entry is written as the key length, the key, the value length and
+   * the value, with the lengths as big endian ints, i.e. to be read with
+   * {@link ByteBuffer#getInt()} in the default byte order. The copy stops after
+   * {@code maxEntries} entries, at the first entry which does not fit the
+   * remaining space of the buffer, at the first key which does not start with
+   * {@code prefix}, or at the end of the iteration, including the upper bound
+   * of the read options. The iterator is then left at the first entry not
+   * copied, or invalid. If no entry is copied although the iterator is valid
+   * and in the prefix, the current entry is larger than the buffer and can be
+   * read with {@link #key(ByteBuffer)} and {@link #value(ByteBuffer)}.</p>
+   *
+   * @param buffer the direct buffer receiving the entries from its position,
+   *     which is advanced past the written entries.
+   * @param maxEntries the maximum number of entries to copy.
+   * @param prefix the prefix of the keys to copy, or null to copy any key.
+   * @return the number of entries copied.
+   */
+  public int nextBatch(final ByteBuffer buffer, final int maxEntries, final byte[] prefix) {
+    assert isOwningHandle();
+    if (!buffer.isDirect()) {
+      throw new IllegalArgumentException("The buffer must be a direct byte buffer");
+    }
+    final long result = nextBatch0(
+        nativeHandle_, buffer, buffer.position(), buffer.remaining(), maxEntries, prefix);
+    buffer.position(buffer.position() + (int) result);
+    return (int) (result >>> 32);
+  }
+
   @Override protected final native void disposeInternal(final long handle);
   @Override final native boolean isValid0(long handle);
   @Override final native void seekToFirst0(long handle);
@@ -215,4 +247,6 @@ public class RocksIterator extends AbstractRocksIterator<RocksDB> {
   private native int keyByteArray0(long handle, byte[] array, int arrayOffset, int arrayLen);
   private native int valueDirect0(long handle, ByteBuffer buffer, int bufferOffset, int bufferLen);
   private native int valueByteArray0(long handle, byte[] array, int arrayOffset, int arrayLen);
+  private native long nextBatch0(long handle, ByteBuffer buffer, int bufferOffset, int bufferLen,
+      int maxEntries, byte[] prefix);
 }
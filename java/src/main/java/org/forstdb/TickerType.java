@@ -776,6 +776,16 @@ public enum TickerType {
 
     PREFETCH_HITS((byte) -0x42),
 
+    /**
+     * Bytes read from Flink FileSystem.
+     */
+    FLINK_FS_BYTES_READ((byte) -0x47),
+
+    /**
+     * Bytes written to Flink FileSystem.
+     */
+    FLINK_FS_BYTES_WRITTEN((byte) -0x48),
+
     TICKER_ENUM_MAX((byte) 0x5F);
 
     private final byte value;
@@ -63,6 +63,42 @@ public class WriteBatch extends AbstractWriteBatch {
     iterate(nativeHandle_, handler.nativeHandle_);
   }
 
+  /**
+   * Appends the records serialized by a {@link WriteBatchRecordWriter} with a
+   * single JNI call, and clears the writer for reuse.
+   * <p>
+   * The records are validated and copied once into the native batch, without
+   * any per-record JNI call.
+   *
+   * @param writer the writer holding the records.
+   *
+   * @throws RocksDBException if the records are invalid or the batch would
+   *     exceed its max bytes, in which case nothing is appended.
+   */
+  public void append(final WriteBatchRecordWriter writer) throws RocksDBException {
+    final ByteBuffer records = writer.buffer();
+    appendRecordsDirect(nativeHandle_, records, 0, records.position(), writer.count());
+    writer.clear();
+  }
+
+  /**
+   * Appends records serialized in the native WriteBatch record format, without
+   * the batch header, from the position to the limit of a direct buffer with
+   * a single JNI call. Only Put, Merge, Delete, SingleDelete and DeleteRange
+   * records are accepted. The position of the buffer is set to its limit.
+   *
+   * @param records direct buffer holding the records.
+   * @param count the number of records in the buffer.
+   *
+   * @throws RocksDBException if the records are invalid or the batch would
+   *     exceed its max bytes, in which case nothing is appended.
+   */
+  public void appendRecords(final ByteBuffer records, final int count) throws RocksDBException {
+    assert records.isDirect();
+    appendRecordsDirect(nativeHandle_, records, records.position(), records.remaining(), count);
+    records.position(records.limit());
+  }
+
   /**
    * Retrieve the serialized version of this batch.
    *
@@ -262,6 +298,8 @@ public class WriteBatch extends AbstractWriteBatch {
 
   private static native long newWriteBatch(final int reserved_bytes);
   private static native long newWriteBatch(final byte[] serialized, final int serializedLength);
+  private native void appendRecordsDirect(final long handle, final ByteBuffer records,
+      final int recordsOffset, final int recordsLength, final int count) throws RocksDBException;
   private native void iterate(final long handle, final long handlerHandle)
       throws RocksDBException;
   private native byte[] data(final long nativeHandle) throws RocksDBException;
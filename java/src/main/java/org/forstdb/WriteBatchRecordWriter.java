@@ -0,0 +1,193 @@
+// Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+package org.forstdb;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Serializes updates in the native WriteBatch record format into a direct
+ * buffer, so that many updates are added to a {@link WriteBatch} with a single
+ * JNI call by {@link WriteBatch#append(WriteBatchRecordWriter)}.
+ * <p>
+ * The column families are identified by their ID, see
+ * {@link ColumnFamilyHandle#getID()}, with 0 for the default column family.
+ * <p>
+ * An update which does not fit the remaining space of the buffer is not
+ * written, and the caller is expected to append the written records to the
+ * batch and retry. Each record needs up to 16 bytes on top of its keys and
+ * value.
+ * <p>
+ * A WriteBatchRecordWriter is not thread-safe.
+ */
+public class WriteBatchRecordWriter {
+  // Record tags of the native WriteBatch format, see ValueType in db/dbformat.h
+  private static final byte TYPE_DELETION = 0x0;
+  private static final byte TYPE_VALUE = 0x1;
+  private static final byte TYPE_MERGE = 0x2;
+  private static final byte TYPE_COLUMN_FAMILY_DELETION = 0x4;
+  private static final byte TYPE_COLUMN_FAMILY_VALUE = 0x5;
+  private static final byte TYPE_COLUMN_FAMILY_MERGE = 0x6;
+  private static final byte TYPE_SINGLE_DELETION = 0x7;
+  private static final byte TYPE_COLUMN_FAMILY_SINGLE_DELETION = 0x8;
+  private static final byte TYPE_COLUMN_FAMILY_RANGE_DELETION = 0xE;
+  private static final byte TYPE_RANGE_DELETION = 0xF;
+
+  private static final int MAX_VARINT32_LENGTH = 5;
+  private static final int MAX_RECORD_OVERHEAD = 1 + 3 * MAX_VARINT32_LENGTH;
+
+  private final ByteBuffer buffer;
+  private int count;
+
+  /**
+   * Constructs a WriteBatchRecordWriter with a new direct buffer.
+   *
+   * @param capacity the capacity of the buffer in bytes.
+   */
+  public WriteBatchRecordWriter(final int capacity) {
+    this(ByteBuffer.allocateDirect(capacity));
+  }
+
+  /**
+   * Constructs a WriteBatchRecordWriter writing into the given direct buffer,
+   * from its beginning.
+   *
+   * @param buffer the direct buffer to write the records to.
+   */
+  public WriteBatchRecordWriter(final ByteBuffer buffer) {
+    if (!buffer.isDirect()) {
+      throw new IllegalArgumentException("The buffer must be a direct buffer");
+    }
+    this.buffer = buffer;
+    clear();
+  }
+
+  /**
+   * Writes a Put record.
+   *
+   * @param columnFamilyId the ID of the column family.
+   * @param key the key.
+   * @param value the value.
+   *
+   * @return false if the record does not fit, true otherwise.
+   */
+  public boolean put(final int columnFamilyId, final byte[] key, final byte[] value) {
+    return write(TYPE_VALUE, TYPE_COLUMN_FAMILY_VALUE, columnFamilyId, key, value);
+  }
+
+  /**
+   * Writes a Merge record.
+   *
+   * @param columnFamilyId the ID of the column family.
+   * @param key the key.
+   * @param value the merge operand.
+   *
+   * @return false if the record does not fit, true otherwise.
+   */
+  public boolean merge(final int columnFamilyId, final byte[] key, final byte[] value) {
+    return write(TYPE_MERGE, TYPE_COLUMN_FAMILY_MERGE, columnFamilyId, key, value);
+  }
+
+  /**
+   * Writes a Delete record.
+   *
+   * @param columnFamilyId the ID of the column family.
+   * @param key the key.
+   *
+   * @return false if the record does not fit, true otherwise.
+   */
+  public boolean delete(final int columnFamilyId, final byte[] key) {
+    return write(TYPE_DELETION, TYPE_COLUMN_FAMILY_DELETION, columnFamilyId, key, null);
+  }
+
+  /**
+   * Writes a SingleDelete record.
+   *
+   * @param columnFamilyId the ID of the column family.
+   * @param key the key.
+   *
+   * @return false if the record does not fit, true otherwise.
+   */
+  public boolean singleDelete(final int columnFamilyId, final byte[] key) {
+    return write(
+        TYPE_SINGLE_DELETION, TYPE_COLUMN_FAMILY_SINGLE_DELETION, columnFamilyId, key, null);
+  }
+
+  /**
+   * Writes a DeleteRange record.
+   *
+   * @param columnFamilyId the ID of the column family.
+   * @param beginKey the first key to delete, included.
+   * @param endKey the last key to delete, excluded.
+   *
+   * @return false if the record does not fit, true otherwise.
+   */
+  public boolean deleteRange(final int columnFamilyId, final byte[] beginKey, final byte[] endKey) {
+    return write(
+        TYPE_RANGE_DELETION, TYPE_COLUMN_FAMILY_RANGE_DELETION, columnFamilyId, beginKey, endKey);
+  }
+
+  /**
+   * Returns the number of written records.
+   *
+   * @return the number of records.
+   */
+  public int count() {
+    return count;
+  }
+
+  /**
+   * Returns the size of the written records.
+   *
+   * @return the size in bytes.
+   */
+  public int size() {
+    return buffer.position();
+  }
+
+  /**
+   * Discards the written records.
+   */
+  public void clear() {
+    buffer.clear();
+    count = 0;
+  }
+
+  ByteBuffer buffer() {
+    return buffer;
+  }
+
+  private boolean write(final byte defaultColumnFamilyTag, final byte columnFamilyTag,
+      final int columnFamilyId, final byte[] key, final byte[] value) {
+    final long maxSize =
+        MAX_RECORD_OVERHEAD + (long) key.length + (value == null ? 0 : value.length);
+    if (buffer.remaining() < maxSize) {
+      return false;
+    }
+    if (columnFamilyId == 0) {
+      buffer.put(defaultColumnFamilyTag);
+    } else {
+      buffer.put(columnFamilyTag);
+      putVarint32(columnFamilyId);
+    }
+    putVarint32(key.length);
+    buffer.put(key);
+    if (value != null) {
+      putVarint32(value.length);
+      buffer.put(value);
+    }
+    count++;
+    return true;
+  }
+
+  private void putVarint32(final int value) {
+    int v = value;
+    while ((v & ~0x7F) != 0) {
+      buffer.put((byte) ((v & 0x7F) | 0x80));
+      v >>>= 7;
+    }
+    buffer.put((byte) v);
+  }
+}
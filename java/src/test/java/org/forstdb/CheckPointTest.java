@@ -57,6 +57,30 @@ public class CheckPointTest {
     }
   }
 
+  @Test
+  public void checkPointWithParallelCopies() throws RocksDBException {
+    try (final Options options = new Options().setCreateIfMissing(true)) {
+      try (final RocksDB db = RocksDB.open(options, dbFolder.getRoot().getAbsolutePath())) {
+        for (int i = 0; i < 10; i++) {
+          db.put(("key" + i).getBytes(), ("value" + i).getBytes());
+          try (final FlushOptions flushOptions = new FlushOptions()) {
+            db.flush(flushOptions);
+          }
+        }
+        try (final Checkpoint checkpoint = Checkpoint.create(db, 4)) {
+          checkpoint.createCheckpoint(checkpointFolder.getRoot().getAbsolutePath() + "/snapshot");
+        }
+      }
+
+      try (final RocksDB db =
+               RocksDB.open(options, checkpointFolder.getRoot().getAbsolutePath() + "/snapshot")) {
+        for (int i = 0; i < 10; i++) {
+          assertThat(new String(db.get(("key" + i).getBytes()))).isEqualTo("value" + i);
+        }
+      }
+    }
+  }
+
   @Test
   public void exportColumnFamily() throws RocksDBException {
     try (final Options options = new Options().setCreateIfMissing(true)) {
@@ -45,6 +45,7 @@ public class FlinkCompactionFilterTest {
   private static final Random rnd = new Random();
 
   private TestTimeProvider timeProvider;
+  private FlinkCompactionFilter.NativeTimeProvider nativeTimeProvider;
   private List<StateContext> stateContexts;
   private List<ColumnFamilyDescriptor> cfDescs;
   private List<ColumnFamilyHandle> cfHandles;
@@ -55,10 +56,13 @@ public class FlinkCompactionFilterTest {
   public void init() {
     timeProvider = new TestTimeProvider();
     timeProvider.time = rnd.nextLong();
+    nativeTimeProvider = new FlinkCompactionFilter.NativeTimeProvider(timeProvider.time);
     stateContexts =
         Arrays.asList(new StateContext(StateType.Value, timeProvider, TEST_TIMESTAMP_OFFSET),
             new FixedElementListStateContext(timeProvider),
-            new NonFixedElementListStateContext(timeProvider));
+            new NonFixedElementListStateContext(timeProvider),
+            new DirectBufferListStateContext(timeProvider),
+            new NativeTimeProviderStateContext(nativeTimeProvider));
     cfDescs = new ArrayList<>();
     cfHandles = new ArrayList<>();
     cfDescs.add(new ColumnFamilyDescriptor(RocksDB.DEFAULT_COLUMN_FAMILY));
@@ -73,6 +77,7 @@ public class FlinkCompactionFilterTest {
       stateContext.cfDesc.getOptions().close();
       stateContext.filterFactory.close();
     }
+    nativeTimeProvider.close();
   }
 
   @Test
@@ -97,6 +102,7 @@ public class FlinkCompactionFilterTest {
         }
 
         timeProvider.time += TTL + TTL / 2; // expire state
+        nativeTimeProvider.setCurrentTimestamp(timeProvider.time);
 
         for (StateContext stateContext : stateContexts) {
           stateContext.checkUnexpired(rocksDb);
@@ -112,6 +118,40 @@ public class FlinkCompactionFilterTest {
     }
   }
 
+  @Test
+  public void testDeleteExpiredFiles() throws RocksDBException {
+    final StateContext stateContext =
+        new StateContext(StateType.Value, timeProvider, TEST_TIMESTAMP_OFFSET);
+    stateContext.filterFactory.addTtlTablePropertiesCollector(stateContext.cfDesc.getOptions());
+    cfDescs = Arrays.asList(
+        new ColumnFamilyDescriptor(RocksDB.DEFAULT_COLUMN_FAMILY), stateContext.getCfDesc());
+    try (DBOptions options = createDbOptions();
+         RocksDB rocksDb = RocksDB.open(
+             options, dbFolder.getRoot().getAbsolutePath(), cfDescs, cfHandles)) {
+      try {
+        stateContext.columnFamilyHandle = cfHandles.get(1);
+        stateContext.updateValueWithTimestamp(rocksDb);
+        // moves the file out of level 0
+        rocksDb.compactRange(stateContext.columnFamilyHandle);
+        assertThat(FlinkCompactionFilter.deleteExpiredFiles(
+                       rocksDb, stateContext.columnFamilyHandle, TTL, timeProvider.time))
+            .isEqualTo(0);
+        stateContext.checkUnexpired(rocksDb);
+
+        assertThat(FlinkCompactionFilter.deleteExpiredFiles(rocksDb,
+                       stateContext.columnFamilyHandle, TTL, timeProvider.time + TTL + TTL / 2))
+            .isEqualTo(1);
+        stateContext.checkExpired(rocksDb);
+      } finally {
+        for (ColumnFamilyHandle cfHandle : cfHandles) {
+          cfHandle.close();
+        }
+        stateContext.cfDesc.getOptions().close();
+        stateContext.filterFactory.close();
+      }
+    }
+  }
+
   private static DBOptions createDbOptions() {
     return new DBOptions().setCreateIfMissing(true).setCreateMissingColumnFamilies(true);
   }
@@ -341,6 +381,59 @@ public class FlinkCompactionFilterTest {
     }
   }
 
+  private static class DirectBufferListStateContext extends FixedElementListStateContext {
+    private static FlinkCompactionFilter.ListElementFilterFactory ELEM_FILTER_FACTORY =
+        new ListElementFilterFactory();
+
+    private DirectBufferListStateContext(TimeProvider timeProvider) {
+      super(timeProvider);
+    }
+
+    @Override
+    FlinkCompactionFilter.Config createConfig(StateType type, int timestampOffset) {
+      return FlinkCompactionFilter.Config.createForList(
+          TTL, QUERY_TIME_AFTER_NUM_ENTRIES, ELEM_FILTER_FACTORY);
+    }
+
+    private static class ListElementFilterFactory
+        implements FlinkCompactionFilter.ListElementFilterFactory {
+      @Override
+      public FlinkCompactionFilter.ListElementFilter createListElementFilter() {
+        return new FlinkCompactionFilter.ListElementFilter() {
+          @Override
+          public int nextUnexpiredOffset(byte[] list, long ttl, long currentTimestamp) {
+            throw new UnsupportedOperationException("The list is read from the direct buffer");
+          }
+
+          @Override
+          public int nextUnexpiredOffset(
+              ByteBuffer list, int length, long ttl, long currentTimestamp) {
+            assertThat(list.isDirect()).isTrue();
+            int currentOffset = 0;
+            while (currentOffset < length) {
+              long timestamp = list.getLong(currentOffset);
+              if (timestamp + ttl > currentTimestamp) {
+                break;
+              }
+              int elemLen = list.getInt(currentOffset + 8);
+              currentOffset += 13 + elemLen;
+            }
+            return currentOffset;
+          }
+        };
+      }
+    }
+  }
+
+  private static class NativeTimeProviderStateContext extends StateContext {
+    private NativeTimeProviderStateContext(
+        FlinkCompactionFilter.NativeTimeProvider nativeTimeProvider) {
+      super(StateType.Value, nativeTimeProvider, TEST_TIMESTAMP_OFFSET);
+      // The filters are created without calling back into Java
+      assertThat(filterFactory.isNative()).isTrue();
+    }
+  }
+
   private static byte[] getASCII(String str) {
     return str.getBytes(StandardCharsets.US_ASCII);
   }
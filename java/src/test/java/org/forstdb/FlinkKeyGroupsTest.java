@@ -0,0 +1,88 @@
+// Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+package org.forstdb;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+import static org.assertj.core.api.Assertions.assertThat;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import org.junit.ClassRule;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class FlinkKeyGroupsTest {
+  @ClassRule
+  public static final RocksNativeLibraryResource ROCKS_NATIVE_LIBRARY_RESOURCE =
+      new RocksNativeLibraryResource();
+
+  @Rule public TemporaryFolder dbFolder = new TemporaryFolder();
+
+  private static final int NUM_KEY_GROUPS = 8;
+
+  private static byte[] stateKey(final int keyGroup, final int k) {
+    final byte[] key = ("key" + k).getBytes(UTF_8);
+    final byte[] result = new byte[key.length + 1];
+    result[0] = (byte) keyGroup;
+    System.arraycopy(key, 0, result, 1, key.length);
+    return result;
+  }
+
+  @Test
+  public void keyGroupPrefixBytes() {
+    assertThat(FlinkKeyGroups.keyGroupPrefixBytes(128)).isEqualTo(1);
+    assertThat(FlinkKeyGroups.keyGroupPrefixBytes(129)).isEqualTo(2);
+  }
+
+  @Test
+  public void deleteAndClipKeyGroupRange() throws RocksDBException {
+    final int prefixBytes = FlinkKeyGroups.keyGroupPrefixBytes(NUM_KEY_GROUPS);
+    final List<ColumnFamilyHandle> cfHandles = new ArrayList<>();
+    try (final FlinkKeyGroupSstPartitionerFactory partitionerFactory =
+             new FlinkKeyGroupSstPartitionerFactory(prefixBytes);
+         final ColumnFamilyOptions cfOptions =
+             new ColumnFamilyOptions().setSstPartitionerFactory(partitionerFactory);
+         final DBOptions options =
+             new DBOptions().setCreateIfMissing(true).setCreateMissingColumnFamilies(true)) {
+      FlinkKeyGroups.addKeyGroupTablePropertiesCollector(cfOptions, prefixBytes);
+      final List<ColumnFamilyDescriptor> cfDescs =
+          Arrays.asList(new ColumnFamilyDescriptor(RocksDB.DEFAULT_COLUMN_FAMILY),
+              new ColumnFamilyDescriptor("state".getBytes(UTF_8), cfOptions));
+      try (final RocksDB db =
+               RocksDB.open(options, dbFolder.getRoot().getAbsolutePath(), cfDescs, cfHandles)) {
+        try {
+          final ColumnFamilyHandle cf = cfHandles.get(1);
+          for (int keyGroup = 0; keyGroup < NUM_KEY_GROUPS; keyGroup++) {
+            for (int k = 0; k < 10; k++) {
+              db.put(cf, stateKey(keyGroup, k), "v".getBytes(UTF_8));
+            }
+          }
+          db.compactRange(cf);
+          assertThat(db.getLiveFilesMetaData().size()).isEqualTo(NUM_KEY_GROUPS);
+
+          // Whole files are dropped
+          FlinkKeyGroups.deleteKeyGroupRange(db, cf, 2, 3, prefixBytes);
+          assertThat(db.getLiveFilesMetaData().size()).isEqualTo(NUM_KEY_GROUPS - 2);
+          assertThat(db.get(cf, stateKey(2, 0))).isNull();
+          assertThat(db.get(cf, stateKey(3, 9))).isNull();
+          assertThat(db.get(cf, stateKey(4, 0))).isNotNull();
+
+          FlinkKeyGroups.clipKeyGroupRange(db, cf, 4, 5, prefixBytes);
+          assertThat(db.getLiveFilesMetaData().size()).isEqualTo(2);
+          assertThat(db.get(cf, stateKey(1, 0))).isNull();
+          assertThat(db.get(cf, stateKey(5, 9))).isNotNull();
+          assertThat(db.get(cf, stateKey(6, 0))).isNull();
+        } finally {
+          for (final ColumnFamilyHandle cfHandle : cfHandles) {
+            cfHandle.close();
+          }
+        }
+      }
+    }
+  }
+}
@@ -95,4 +95,36 @@ public class ImportColumnFamilyTest {
       }
     }
   }
+
+  @Test
+  public void importMultiColumnFamilyWithClip() throws RocksDBException {
+    try (final Options options = new Options().setCreateIfMissing(true)) {
+      try (final RocksDB db1 = RocksDB.open(options, dbFolder.getRoot().getAbsolutePath() + "db1");
+           final RocksDB db2 =
+               RocksDB.open(options, dbFolder.getRoot().getAbsolutePath() + "db2");) {
+        db1.put("key".getBytes(), "value".getBytes());
+        db1.put("key1".getBytes(), "value1".getBytes());
+        db2.put("key2".getBytes(), "value2".getBytes());
+        db2.put("key3".getBytes(), "value3".getBytes());
+        try (final Checkpoint checkpoint1 = Checkpoint.create(db1);
+             final Checkpoint checkpoint2 = Checkpoint.create(db2);
+             final ImportColumnFamilyOptions importColumnFamilyOptions =
+                 new ImportColumnFamilyOptions()) {
+          List<ExportImportFilesMetaData> importMetaDatas = new ArrayList<>();
+          importMetaDatas.add(checkpoint1.exportColumnFamily(db1.getDefaultColumnFamily(),
+              checkpointFolder.getRoot().getAbsolutePath() + "/default_cf_metadata1"));
+          importMetaDatas.add(checkpoint2.exportColumnFamily(db2.getDefaultColumnFamily(),
+              checkpointFolder.getRoot().getAbsolutePath() + "/default_cf_metadata2"));
+
+          final ColumnFamilyHandle importCfHandle = db1.createColumnFamilyWithImport(
+              new ColumnFamilyDescriptor("new_cf".getBytes()), importColumnFamilyOptions,
+              importMetaDatas, "key1".getBytes(), "key3".getBytes());
+          assertThat(db1.get(importCfHandle, "key".getBytes())).isNull();
+          assertThat(db1.get(importCfHandle, "key1".getBytes())).isEqualTo("value1".getBytes());
+          assertThat(db1.get(importCfHandle, "key2".getBytes())).isEqualTo("value2".getBytes());
+          assertThat(db1.get(importCfHandle, "key3".getBytes())).isNull();
+        }
+      }
+    }
+  }
 }
@@ -105,4 +105,12 @@ public class MemTableTest {
       options.setMemTableConfig(vectorMemTableConfig);
     }
   }
+
+  @Test
+  public void bTreeMemTable() throws RocksDBException {
+    try (final Options options = new Options()) {
+      options.setMemTableConfig(new BTreeMemTableConfig());
+      assertThat(options.memTableFactoryName()).isEqualTo("BTreeRepFactory");
+    }
+  }
 }
@@ -182,6 +182,38 @@ public class MergeTest {
     }
   }
 
+  @Test
+  public void listAppendOperatorMergeOperands() throws RocksDBException {
+    try (final ListAppendOperator listAppendOperator = new ListAppendOperator();
+         final Options opt =
+             new Options().setCreateIfMissing(true).setMergeOperator(listAppendOperator);
+         final RocksDB db = RocksDB.open(opt, dbFolder.getRoot().getAbsolutePath());
+         final ReadOptions readOptions = new ReadOptions()) {
+      db.put("key".getBytes(), "aa".getBytes());
+      db.merge("key".getBytes(), "bb".getBytes());
+      db.merge("key".getBytes(), "cc".getBytes());
+      assertThat(new String(db.get("key".getBytes()))).isEqualTo("aa,bb,cc");
+
+      final ByteBuffer operands = ByteBuffer.allocateDirect(64);
+      assertThat(db.getMergeOperands(readOptions, db.getDefaultColumnFamily(),
+                     "key".getBytes(), operands, 10))
+          .isEqualTo(3);
+      operands.flip();
+      for (final String expected : Arrays.asList("aa", "bb", "cc")) {
+        final byte[] operand = new byte[operands.getInt()];
+        operands.get(operand);
+        assertThat(new String(operand)).isEqualTo(expected);
+      }
+      assertThat(operands.hasRemaining()).isFalse();
+
+      operands.clear();
+      assertThat(db.getMergeOperands(readOptions, db.getDefaultColumnFamily(),
+                     "missing".getBytes(), operands, 10))
+          .isEqualTo(RocksDB.NOT_FOUND);
+      assertThat(operands.position()).isEqualTo(0);
+    }
+  }
+
   @Test
   public void uint64AddOperatorOption()
       throws InterruptedException, RocksDBException {
@@ -527,4 +527,55 @@ public class MultiGetTest {
       }
     }
   }
+
+  @Test
+  public void putNThenMultiGetIntoBuffer() throws RocksDBException {
+    try (final Options opt = new Options().setCreateIfMissing(true);
+         final RocksDB db = RocksDB.open(opt, dbFolder.getRoot().getAbsolutePath());
+         final ReadOptions readOptions = new ReadOptions()) {
+      db.put("key1".getBytes(), "value1ForKey1".getBytes());
+      db.put("key3".getBytes(), "value3ForKey3".getBytes());
+      db.put("key4".getBytes(), "v4".getBytes());
+
+      final ByteBuffer keys = ByteBuffer.allocateDirect(16);
+      keys.put("key1key2key3key4".getBytes());
+      final int[] keyOffsets = new int[] {0, 4, 8, 12, 16};
+      final int[] valueLengths = new int[4];
+      final byte[] statusCodes = new byte[4];
+
+      // The value of key3 does not fit
+      final ByteBuffer values = ByteBuffer.allocateDirect(20);
+      assertThat(db.multiGetIntoBuffer(
+                     readOptions, null, keys, keyOffsets, values, valueLengths, statusCodes))
+          .isEqualTo(2);
+      assertThat(statusCodes)
+          .containsExactly(Status.Code.Ok.getValue(), Status.Code.NotFound.getValue(),
+              Status.Code.Incomplete.getValue(), Status.Code.Incomplete.getValue());
+      assertThat(valueLengths).containsExactly(13, 0, 13, 2);
+      assertThat(values.position()).isEqualTo(13);
+      values.flip();
+      assertThat(TestUtil.bufferBytes(values)).isEqualTo("value1ForKey1".getBytes());
+
+      // Resume from key3 with a drained buffer
+      values.clear();
+      final int[] remainingKeyOffsets = new int[] {8, 12, 16};
+      assertThat(db.multiGetIntoBuffer(readOptions, db.getDefaultColumnFamily(), keys,
+                     remainingKeyOffsets, values, valueLengths, statusCodes))
+          .isEqualTo(2);
+      assertThat(statusCodes[0]).isEqualTo(Status.Code.Ok.getValue());
+      assertThat(statusCodes[1]).isEqualTo(Status.Code.Ok.getValue());
+      values.flip();
+      assertThat(TestUtil.bufferBytes(values)).isEqualTo("value3ForKey3v4".getBytes());
+    }
+  }
+
+  @Test(expected = IllegalArgumentException.class)
+  public void multiGetIntoBufferIndirect() throws RocksDBException {
+    try (final Options opt = new Options().setCreateIfMissing(true);
+         final RocksDB db = RocksDB.open(opt, dbFolder.getRoot().getAbsolutePath());
+         final ReadOptions readOptions = new ReadOptions()) {
+      db.multiGetIntoBuffer(readOptions, null, ByteBuffer.allocate(4), new int[] {0, 4},
+          ByteBuffer.allocateDirect(4), new int[1], new byte[1]);
+    }
+  }
 }
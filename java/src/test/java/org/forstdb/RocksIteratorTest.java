@@ -45,6 +45,86 @@ public class RocksIteratorTest {
     validateByteBufferResult(iterator.value(byteBuffer), byteBuffer, value);
   }
 
+  private void validateBatchEntry(final ByteBuffer batch, final String key, final String value) {
+    final byte[] keyBytes = new byte[batch.getInt()];
+    batch.get(keyBytes);
+    assertThat(keyBytes).isEqualTo(key.getBytes(StandardCharsets.UTF_8));
+    final byte[] valueBytes = new byte[batch.getInt()];
+    batch.get(valueBytes);
+    assertThat(valueBytes).isEqualTo(value.getBytes(StandardCharsets.UTF_8));
+  }
+
+  @Test
+  public void rocksIteratorNextBatch() throws RocksDBException {
+    try (final Options options = new Options().setCreateIfMissing(true);
+         final RocksDB db = RocksDB.open(options, dbFolder.getRoot().getAbsolutePath())) {
+      db.put("a1".getBytes(), "value1".getBytes());
+      db.put("a2".getBytes(), "value2".getBytes());
+      db.put("a3".getBytes(), "value3".getBytes());
+      db.put("b1".getBytes(), "value4".getBytes());
+
+      try (final RocksIterator iterator = db.newIterator()) {
+        final ByteBuffer batch = ByteBuffer.allocateDirect(64);
+        iterator.seekToFirst();
+        assertThat(iterator.nextBatch(batch, 2, null)).isEqualTo(2);
+        assertThat(batch.position()).isEqualTo(32);
+        assertThat(iterator.key()).isEqualTo("a3".getBytes());
+        batch.flip();
+        validateBatchEntry(batch, "a1", "value1");
+        validateBatchEntry(batch, "a2", "value2");
+        assertThat(batch.hasRemaining()).isFalse();
+
+        // Stops at the first key without the prefix
+        batch.clear();
+        assertThat(iterator.nextBatch(batch, 10, "a".getBytes())).isEqualTo(1);
+        assertThat(iterator.key()).isEqualTo("b1".getBytes());
+
+        // The entry does not fit
+        batch.clear();
+        batch.limit(15);
+        assertThat(iterator.nextBatch(batch, 10, null)).isEqualTo(0);
+        assertThat(batch.position()).isEqualTo(0);
+        assertThat(iterator.isValid()).isTrue();
+
+        batch.clear();
+        assertThat(iterator.nextBatch(batch, 10, null)).isEqualTo(1);
+        assertThat(iterator.isValid()).isFalse();
+        batch.flip();
+        validateBatchEntry(batch, "b1", "value4");
+        assertThat(iterator.nextBatch(batch, 10, null)).isEqualTo(0);
+      }
+    }
+  }
+
+  @Test
+  public void rocksPrefixIterator() throws RocksDBException {
+    try (final Options options = new Options().setCreateIfMissing(true);
+         final RocksDB db = RocksDB.open(options, dbFolder.getRoot().getAbsolutePath());
+         final ReadOptions readOptions = new ReadOptions()) {
+      db.put("a1".getBytes(), "value1".getBytes());
+      db.put("b1".getBytes(), "value2".getBytes());
+      db.put("b2".getBytes(), "value3".getBytes());
+      db.put("c1".getBytes(), "value4".getBytes());
+
+      try (final RocksIterator iterator =
+               db.newPrefixIterator(db.getDefaultColumnFamily(), readOptions, "b".getBytes())) {
+        iterator.seekToFirst();
+        assertThat(iterator.isValid()).isTrue();
+        assertThat(iterator.key()).isEqualTo("b1".getBytes());
+        iterator.next();
+        assertThat(iterator.key()).isEqualTo("b2".getBytes());
+        iterator.next();
+        assertThat(iterator.isValid()).isFalse();
+
+        iterator.seekToLast();
+        assertThat(iterator.key()).isEqualTo("b2".getBytes());
+        iterator.seek("a".getBytes());
+        assertThat(iterator.key()).isEqualTo("b1".getBytes());
+        iterator.status();
+      }
+    }
+  }
+
   @Test
   public void rocksIteratorByteBuffers() throws RocksDBException {
     try (final Options options =
@@ -149,6 +149,58 @@ public class WriteBatchTest {
     }
   }
 
+  @Test
+  public void appendRecordWriter() throws RocksDBException {
+    final byte[] foo = "foo".getBytes(UTF_8);
+    final byte[] bar = "bar".getBytes(UTF_8);
+    final byte[] baz = "baz".getBytes(UTF_8);
+    final byte[] hoo = "hoo".getBytes(UTF_8);
+
+    try (final WriteBatch batch = new WriteBatch()) {
+      final WriteBatchRecordWriter writer = new WriteBatchRecordWriter(1024);
+      assertThat(writer.put(0, foo, bar)).isTrue();
+      assertThat(writer.merge(0, baz, hoo)).isTrue();
+      assertThat(writer.delete(0, bar)).isTrue();
+      assertThat(writer.singleDelete(0, foo)).isTrue();
+      assertThat(writer.deleteRange(0, baz, foo)).isTrue();
+      assertThat(writer.count()).isEqualTo(5);
+      batch.append(writer);
+      assertThat(writer.count()).isEqualTo(0);
+      assertThat(writer.size()).isEqualTo(0);
+      assertThat(batch.count()).isEqualTo(5);
+
+      try (final CapturingWriteBatchHandler handler = new CapturingWriteBatchHandler()) {
+        batch.iterate(handler);
+
+        assertThat(handler.getEvents().size()).isEqualTo(5);
+        assertThat(handler.getEvents().get(0)).isEqualTo(new Event(PUT, foo, bar));
+        assertThat(handler.getEvents().get(1)).isEqualTo(new Event(MERGE, baz, hoo));
+        assertThat(handler.getEvents().get(2)).isEqualTo(new Event(DELETE, bar, null));
+        assertThat(handler.getEvents().get(3)).isEqualTo(new Event(SINGLE_DELETE, foo, null));
+        assertThat(handler.getEvents().get(4)).isEqualTo(new Event(DELETE_RANGE, baz, foo));
+      }
+    }
+  }
+
+  @Test
+  public void appendRecordWriterFull() {
+    final WriteBatchRecordWriter writer = new WriteBatchRecordWriter(32);
+    assertThat(writer.put(0, new byte[8], new byte[8])).isTrue();
+    assertThat(writer.put(0, new byte[8], new byte[8])).isFalse();
+    assertThat(writer.count()).isEqualTo(1);
+    assertThat(writer.size()).isEqualTo(19);
+  }
+
+  @Test(expected = RocksDBException.class)
+  public void appendRecordsInvalid() throws RocksDBException {
+    try (final WriteBatch batch = new WriteBatch()) {
+      final ByteBuffer records = ByteBuffer.allocateDirect(16);
+      // Put of a key of 8 bytes, truncated
+      records.put((byte) 0x1).put((byte) 8).put((byte) 'k').flip();
+      batch.appendRecords(records, 1);
+    }
+  }
+
   @Test
   public void blobOperation()
       throws RocksDBException {
@@ -42,4 +42,12 @@ public class FlinkEnvTest {
       testSuite.runAllTestSuites();
     }
   }
+
+  @Test
+  public void runEnvFlinkBenchmarks() throws Exception {
+    String basePath = parentFolder.newFolder().toURI().toString();
+    try (EnvFlinkTestSuite testSuite = new EnvFlinkTestSuite(basePath)) {
+      testSuite.runBenchmarks(1000);
+    }
+  }
 }
\ No newline at end of file
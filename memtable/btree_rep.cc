@@ -0,0 +1,804 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// A B+-tree MemTableRep with optimistic lock coupling, see "The ART of
+// Practical Synchronization" by Leis et al.
+//
+// The nodes span kNodeSize bytes, aligned to cache lines. Next to the pointers
+// to the keys, they hold the heads of the keys: their first 8 bytes after the
+// prefix common to all the keys the node may hold, in big endian. The prefix
+// is the common prefix of the fence keys of the node, i.e. the separators of
+// the parent nodes around it, so most comparisons of short keys with long
+// common prefixes only read the heads. The heads are only used with the
+// bytewise comparator, whose internal keys are ordered by their heads when
+// these differ.
+//
+// The readers do not lock: they read the version of a node, read the node
+// and then validate that its version did not change, restarting from the
+// root otherwise. The writers lock the nodes they modify, setting the lowest
+// bit of their version, and increment the version when unlocking. The fields
+// are written with release and read with acquire semantics, so a reader which
+// sees a modification also sees the version locked by it.
+//
+// The full nodes are split on the way down the tree, so that the parent of a
+// node always has room for a new child. The keys are never removed, so the
+// nodes only grow, and are freed with the memtable.
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <thread>
+
+#include "db/memtable.h"
+#include "memory/arena.h"
+#include "port/port.h"
+#include "rocksdb/comparator.h"
+#include "rocksdb/memtablerep.h"
+#include "util/math.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace {
+
+class BTreeRep : public MemTableRep {
+ public:
+  BTreeRep(const KeyComparator& compare, Allocator* allocator);
+
+  KeyHandle Allocate(const size_t len, char** buf) override {
+    *buf = allocator_->Allocate(len);
+    return static_cast<KeyHandle>(*buf);
+  }
+
+  void Insert(KeyHandle handle) override {
+    bool inserted = InsertKey(handle);
+    assert(inserted);
+    (void)inserted;
+  }
+
+  bool InsertKey(KeyHandle handle) override;
+
+  bool InsertKeyWithHint(KeyHandle handle, void** /*hint*/) override {
+    return InsertKey(handle);
+  }
+
+  bool InsertKeyWithHintConcurrently(KeyHandle handle,
+                                     void** /*hint*/) override {
+    return InsertKey(handle);
+  }
+
+  void InsertConcurrently(KeyHandle handle) override { Insert(handle); }
+
+  bool InsertKeyConcurrently(KeyHandle handle) override {
+    return InsertKey(handle);
+  }
+
+  bool Contains(const char* key) const override;
+
+  void Get(const LookupKey& k, void* callback_args,
+           bool (*callback_func)(void* arg, const char* entry)) override;
+
+  // All the memory is allocated through the allocator.
+  size_t ApproximateMemoryUsage() override { return 0; }
+
+  MemTableRep::Iterator* GetIterator(Arena* arena = nullptr) override;
+
+ private:
+  static constexpr size_t kNodeSize = 512;
+  static constexpr int kLeafCapacity = 29;
+  static constexpr int kInnerCapacity = 19;
+
+  struct Node {
+    Node(bool _leaf, const char* _low, const char* _high)
+        : version(0),
+          count(0),
+          prefix_len(0),
+          leaf(_leaf),
+          low(_low),
+          high(_high) {}
+
+    // Locked if the lowest bit is set
+    std::atomic<uint64_t> version;
+    // The number of keys of a leaf, or of separators of an inner node
+    std::atomic<uint16_t> count;
+    std::atomic<uint16_t> prefix_len;
+    const bool leaf;
+    // The fence keys: the keys of the node are in [low, high), unbounded
+    // when nullptr. Only read by writers, with the node locked.
+    const char* const low;
+    const char* high;
+  };
+
+  struct LeafNode : public Node {
+    LeafNode(const char* _low, const char* _high)
+        : Node(true, _low, _high), next(nullptr) {}
+
+    std::atomic<LeafNode*> next;
+    std::atomic<uint64_t> heads[kLeafCapacity];
+    std::atomic<const char*> keys[kLeafCapacity];
+  };
+
+  // The child i holds the keys in [keys[i - 1], keys[i]).
+  struct InnerNode : public Node {
+    InnerNode(const char* _low, const char* _high)
+        : Node(false, _low, _high) {}
+
+    std::atomic<uint64_t> heads[kInnerCapacity];
+    std::atomic<const char*> keys[kInnerCapacity];
+    std::atomic<Node*> children[kInnerCapacity + 1];
+  };
+
+  static_assert(sizeof(LeafNode) <= kNodeSize, "LeafNode exceeds kNodeSize");
+  static_assert(sizeof(InnerNode) <= kNodeSize, "InnerNode exceeds kNodeSize");
+
+  // A position in a leaf, valid as long as the leaf has the same version.
+  // key is nullptr past the first or last key.
+  struct Cursor {
+    const LeafNode* leaf = nullptr;
+    uint64_t version = 0;
+    int index = 0;
+    const char* key = nullptr;
+  };
+
+  // How to choose the child of an inner node for a key.
+  enum class Route { kFirst, kLast, kLessOrEqual, kLess };
+
+  enum class InsertResult { kInserted, kDuplicate, kRestart };
+
+  class Iterator;
+
+  static bool ReadLock(const Node* node, uint64_t* version) {
+    *version = node->version.load(std::memory_order_acquire);
+    return (*version & 1) == 0;
+  }
+
+  static bool Validate(const Node* node, uint64_t version) {
+    return node->version.load(std::memory_order_acquire) == version;
+  }
+
+  static bool UpgradeToWriteLock(Node* node, uint64_t version) {
+    return node->version.compare_exchange_strong(version, version | 1,
+                                                 std::memory_order_acquire);
+  }
+
+  static void WriteUnlock(Node* node) {
+    node->version.fetch_add(1, std::memory_order_release);
+  }
+
+  // Unlocks a node which was not modified, without invalidating the readers
+  static void WriteUnlockUnchanged(Node* node, uint64_t version) {
+    node->version.store(version, std::memory_order_release);
+  }
+
+  static void Backoff(int attempt) {
+    port::AsmVolatilePause();
+    if (attempt > 100) {
+      std::this_thread::yield();
+    }
+  }
+
+  static Slice InternalKey(const char* key) {
+    return GetLengthPrefixedSlice(key);
+  }
+
+  static Slice UserKeyOf(const Slice& internal_key) {
+    assert(internal_key.size() >= 8);
+    return Slice(internal_key.data(), internal_key.size() - 8);
+  }
+
+  // Returns the 8 bytes of the user key after the prefix in big endian,
+  // padded with zeros.
+  static uint64_t Head(const Slice& user_key, size_t prefix_len) {
+    if (user_key.size() >= prefix_len + 8) {
+      uint64_t head;
+      memcpy(&head, user_key.data() + prefix_len, sizeof(head));
+      return port::kLittleEndian ? EndianSwapValue(head) : head;
+    }
+    uint64_t head = 0;
+    for (size_t i = prefix_len; i < user_key.size(); i++) {
+      head |= uint64_t{static_cast<unsigned char>(user_key[i])}
+              << (56 - 8 * (i - prefix_len));
+    }
+    return head;
+  }
+
+  uint64_t KeyHead(const char* key, size_t prefix_len) const {
+    return use_heads_ ? Head(UserKeyOf(InternalKey(key)), prefix_len) : 0;
+  }
+
+  // Returns the length of the common prefix of the user keys of the fence
+  // keys, 0 if a fence is unbounded.
+  uint16_t FencePrefixLength(const char* low, const char* high) const;
+
+  // Returns the index of the first of the n keys greater than or equal to
+  // the key, or greater than the key if upper.
+  int Search(const std::atomic<uint64_t>* heads,
+             const std::atomic<const char*>* keys, int n, size_t prefix_len,
+             const Slice& internal_key, bool upper, bool* found) const;
+
+  template <class N>
+  int Search(const N* node, int n, const Slice& internal_key, bool upper,
+             bool* found = nullptr) const {
+    return Search(node->heads, node->keys, n,
+                  node->prefix_len.load(std::memory_order_acquire),
+                  internal_key, upper, found);
+  }
+
+  // Recomputes the heads of the keys of the node after its prefix changed
+  template <class N>
+  void UpdateHeads(N* node, int n) const {
+    if (!use_heads_) {
+      return;
+    }
+    const size_t prefix_len = node->prefix_len.load(std::memory_order_acquire);
+    for (int i = 0; i < n; i++) {
+      node->heads[i].store(
+          KeyHead(node->keys[i].load(std::memory_order_acquire), prefix_len),
+          std::memory_order_release);
+    }
+  }
+
+  template <class N>
+  N* NewNode(const char* low, const char* high) {
+    char* mem = allocator_->AllocateAligned(kNodeSize + CACHE_LINE_SIZE - 1);
+    mem = reinterpret_cast<char*>(
+        (reinterpret_cast<uintptr_t>(mem) + CACHE_LINE_SIZE - 1) &
+        ~uintptr_t{CACHE_LINE_SIZE - 1});
+    N* node = new (mem) N(low, high);
+    node->prefix_len.store(FencePrefixLength(low, high),
+                           std::memory_order_release);
+    return node;
+  }
+
+  // Returns the leaf for the route, read locked with *version, or nullptr to
+  // restart.
+  const LeafNode* FindLeaf(const Slice& internal_key, Route route,
+                           uint64_t* version) const;
+
+  // Positions the cursor at the first key of the leaf or of the following
+  // ones. Returns false to restart.
+  static bool SeekToFirstFrom(const LeafNode* leaf, Cursor* cursor);
+
+  // Positions the cursor at the first key greater than or equal to the key,
+  // or greater than the key if after.
+  void Seek(const Slice& internal_key, bool after, Cursor* cursor) const;
+
+  // Positions the cursor at the last key less than or equal to the key, or
+  // less than the key if before.
+  void SeekForPrev(const Slice& internal_key, bool before,
+                   Cursor* cursor) const;
+
+  void SeekToFirst(Cursor* cursor) const;
+  void SeekToLast(Cursor* cursor) const;
+  void Next(Cursor* cursor) const;
+  void Prev(Cursor* cursor) const;
+
+  InsertResult TryInsert(const char* key, const Slice& internal_key);
+
+  // Splits the node, with the node and its parent, if any, write locked.
+  // The key to insert chooses the split point.
+  void SplitLocked(Node* node, InnerNode* parent, const Slice& internal_key);
+
+  // Inserts the separator and the right child of a split child
+  void InsertChild(InnerNode* parent, const char* separator, Node* child);
+
+  const KeyComparator& compare_;
+  // Whether the keys are compared by their heads
+  const bool use_heads_;
+  std::atomic<Node*> root_;
+};
+
+class BTreeRep::Iterator : public MemTableRep::Iterator {
+ public:
+  explicit Iterator(const BTreeRep* rep) : rep_(rep) {}
+
+  bool Valid() const override { return cursor_.key != nullptr; }
+
+  const char* key() const override {
+    assert(Valid());
+    return cursor_.key;
+  }
+
+  void Next() override {
+    assert(Valid());
+    rep_->Next(&cursor_);
+  }
+
+  void Prev() override {
+    assert(Valid());
+    rep_->Prev(&cursor_);
+  }
+
+  void Seek(const Slice& internal_key, const char* memtable_key) override {
+    rep_->Seek(memtable_key != nullptr ? InternalKey(memtable_key)
+                                       : internal_key,
+               /*after=*/false, &cursor_);
+  }
+
+  void SeekForPrev(const Slice& internal_key,
+                   const char* memtable_key) override {
+    rep_->SeekForPrev(memtable_key != nullptr ? InternalKey(memtable_key)
+                                              : internal_key,
+                      /*before=*/false, &cursor_);
+  }
+
+  void SeekToFirst() override { rep_->SeekToFirst(&cursor_); }
+
+  void SeekToLast() override { rep_->SeekToLast(&cursor_); }
+
+ private:
+  const BTreeRep* const rep_;
+  Cursor cursor_;
+};
+
+BTreeRep::BTreeRep(const KeyComparator& compare, Allocator* allocator)
+    : MemTableRep(allocator),
+      compare_(compare),
+      use_heads_(compare.user_comparator() == BytewiseComparator()) {
+  root_.store(NewNode<LeafNode>(nullptr, nullptr), std::memory_order_release);
+}
+
+uint16_t BTreeRep::FencePrefixLength(const char* low, const char* high) const {
+  if (!use_heads_ || low == nullptr || high == nullptr) {
+    return 0;
+  }
+  const Slice a = UserKeyOf(InternalKey(low));
+  const Slice b = UserKeyOf(InternalKey(high));
+  size_t len = std::min<size_t>({a.size(), b.size(), UINT16_MAX});
+  size_t i = 0;
+  while (i < len && a[i] == b[i]) {
+    i++;
+  }
+  return static_cast<uint16_t>(i);
+}
+
+int BTreeRep::Search(const std::atomic<uint64_t>* heads,
+                     const std::atomic<const char*>* keys, int n,
+                     size_t prefix_len, const Slice& internal_key, bool upper,
+                     bool* found) const {
+  const uint64_t head =
+      use_heads_ ? Head(UserKeyOf(internal_key), prefix_len) : 0;
+  int left = 0;
+  int right = n;
+  while (left < right) {
+    const int mid = left + (right - left) / 2;
+    int cmp;
+    const uint64_t mid_head = heads[mid].load(std::memory_order_acquire);
+    if (use_heads_ && mid_head != head) {
+      cmp = mid_head < head ? -1 : 1;
+    } else {
+      const char* mid_key = keys[mid].load(std::memory_order_acquire);
+      cmp = compare_(mid_key, internal_key);
+      if (cmp == 0 && found != nullptr) {
+        *found = true;
+      }
+    }
+    if (cmp < 0 || (upper && cmp == 0)) {
+      left = mid + 1;
+    } else {
+      right = mid;
+    }
+  }
+  return left;
+}
+
+const BTreeRep::LeafNode* BTreeRep::FindLeaf(const Slice& internal_key,
+                                             Route route,
+                                             uint64_t* version) const {
+  Node* node = root_.load(std::memory_order_acquire);
+  uint64_t node_version;
+  if (!ReadLock(node, &node_version) ||
+      node != root_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  while (!node->leaf) {
+    const InnerNode* inner = static_cast<const InnerNode*>(node);
+    const int n = inner->count.load(std::memory_order_acquire);
+    int i;
+    switch (route) {
+      case Route::kFirst:
+        i = 0;
+        break;
+      case Route::kLast:
+        i = n;
+        break;
+      default:
+        i = Search(inner, n, internal_key,
+                   /*upper=*/route == Route::kLessOrEqual);
+    }
+    Node* child = inner->children[i].load(std::memory_order_acquire);
+    if (!Validate(inner, node_version)) {
+      return nullptr;
+    }
+    uint64_t child_version;
+    // The parent is validated again, as the child may have been split before
+    // it was locked.
+    if (!ReadLock(child, &child_version) ||
+        !Validate(inner, node_version)) {
+      return nullptr;
+    }
+    node = child;
+    node_version = child_version;
+  }
+  *version = node_version;
+  return static_cast<const LeafNode*>(node);
+}
+
+bool BTreeRep::SeekToFirstFrom(const LeafNode* leaf, Cursor* cursor) {
+  // Only the leaf of an empty tree is empty
+  while (leaf != nullptr) {
+    uint64_t version;
+    if (!ReadLock(leaf, &version)) {
+      return false;
+    }
+    const int n = leaf->count.load(std::memory_order_acquire);
+    if (n > 0) {
+      const char* key = leaf->keys[0].load(std::memory_order_acquire);
+      if (!Validate(leaf, version)) {
+        return false;
+      }
+      *cursor = {leaf, version, 0, key};
+      return true;
+    }
+    const LeafNode* next = leaf->next.load(std::memory_order_acquire);
+    if (!Validate(leaf, version)) {
+      return false;
+    }
+    leaf = next;
+  }
+  *cursor = Cursor();
+  return true;
+}
+
+void BTreeRep::Seek(const Slice& internal_key, bool after,
+                    Cursor* cursor) const {
+  for (int attempt = 0;; attempt++) {
+    if (attempt > 0) {
+      Backoff(attempt);
+    }
+    uint64_t version;
+    const LeafNode* leaf =
+        FindLeaf(internal_key, Route::kLessOrEqual, &version);
+    if (leaf == nullptr) {
+      continue;
+    }
+    const int n = leaf->count.load(std::memory_order_acquire);
+    const int i = Search(leaf, n, internal_key, /*upper=*/after);
+    if (i < n) {
+      const char* key = leaf->keys[i].load(std::memory_order_acquire);
+      if (Validate(leaf, version)) {
+        *cursor = {leaf, version, i, key};
+        return;
+      }
+      continue;
+    }
+    const LeafNode* next = leaf->next.load(std::memory_order_acquire);
+    if (Validate(leaf, version) && SeekToFirstFrom(next, cursor)) {
+      return;
+    }
+  }
+}
+
+void BTreeRep::SeekForPrev(const Slice& internal_key, bool before,
+                           Cursor* cursor) const {
+  for (int attempt = 0;; attempt++) {
+    if (attempt > 0) {
+      Backoff(attempt);
+    }
+    uint64_t version;
+    // The lowest key of a leaf, if bounded, is its low fence, so the leaf
+    // holds the key before the route unless it is the first leaf.
+    const LeafNode* leaf = FindLeaf(
+        internal_key, before ? Route::kLess : Route::kLessOrEqual, &version);
+    if (leaf == nullptr) {
+      continue;
+    }
+    const int n = leaf->count.load(std::memory_order_acquire);
+    const int i = Search(leaf, n, internal_key, /*upper=*/!before);
+    const char* key =
+        i > 0 ? leaf->keys[i - 1].load(std::memory_order_acquire) : nullptr;
+    if (Validate(leaf, version)) {
+      *cursor = {leaf, version, i - 1, key};
+      return;
+    }
+  }
+}
+
+void BTreeRep::SeekToFirst(Cursor* cursor) const {
+  for (int attempt = 0;; attempt++) {
+    if (attempt > 0) {
+      Backoff(attempt);
+    }
+    uint64_t version;
+    const LeafNode* leaf = FindLeaf(Slice(), Route::kFirst, &version);
+    if (leaf != nullptr && SeekToFirstFrom(leaf, cursor)) {
+      return;
+    }
+  }
+}
+
+void BTreeRep::SeekToLast(Cursor* cursor) const {
+  for (int attempt = 0;; attempt++) {
+    if (attempt > 0) {
+      Backoff(attempt);
+    }
+    uint64_t version;
+    const LeafNode* leaf = FindLeaf(Slice(), Route::kLast, &version);
+    if (leaf == nullptr) {
+      continue;
+    }
+    // The last leaf is only empty in an empty tree
+    const int n = leaf->count.load(std::memory_order_acquire);
+    const char* key =
+        n > 0 ? leaf->keys[n - 1].load(std::memory_order_acquire) : nullptr;
+    if (Validate(leaf, version)) {
+      *cursor = {leaf, version, n - 1, key};
+      return;
+    }
+  }
+}
+
+void BTreeRep::Next(Cursor* cursor) const {
+  assert(cursor->key != nullptr);
+  const LeafNode* leaf = cursor->leaf;
+  // Moves within the leaf, or to the next one, if the leaf did not change
+  if (Validate(leaf, cursor->version)) {
+    const int n = leaf->count.load(std::memory_order_acquire);
+    const int i = cursor->index + 1;
+    if (i < n) {
+      const char* key = leaf->keys[i].load(std::memory_order_acquire);
+      if (Validate(leaf, cursor->version)) {
+        cursor->index = i;
+        cursor->key = key;
+        return;
+      }
+    } else {
+      const LeafNode* next = leaf->next.load(std::memory_order_acquire);
+      if (Validate(leaf, cursor->version) && SeekToFirstFrom(next, cursor)) {
+        return;
+      }
+    }
+  }
+  Seek(InternalKey(cursor->key), /*after=*/true, cursor);
+}
+
+void BTreeRep::Prev(Cursor* cursor) const {
+  assert(cursor->key != nullptr);
+  const LeafNode* leaf = cursor->leaf;
+  const int i = cursor->index - 1;
+  if (i >= 0 && Validate(leaf, cursor->version)) {
+    const char* key = leaf->keys[i].load(std::memory_order_acquire);
+    if (Validate(leaf, cursor->version)) {
+      cursor->index = i;
+      cursor->key = key;
+      return;
+    }
+  }
+  // The leaves are only linked forward, so the previous leaf is searched
+  SeekForPrev(InternalKey(cursor->key), /*before=*/true, cursor);
+}
+
+bool BTreeRep::Contains(const char* key) const {
+  const Slice internal_key = InternalKey(key);
+  Cursor cursor;
+  Seek(internal_key, /*after=*/false, &cursor);
+  return cursor.key != nullptr && compare_(cursor.key, internal_key) == 0;
+}
+
+void BTreeRep::Get(const LookupKey& k, void* callback_args,
+                   bool (*callback_func)(void* arg, const char* entry)) {
+  Cursor cursor;
+  for (Seek(k.internal_key(), /*after=*/false, &cursor);
+       cursor.key != nullptr && callback_func(callback_args, cursor.key);
+       Next(&cursor)) {
+  }
+}
+
+MemTableRep::Iterator* BTreeRep::GetIterator(Arena* arena) {
+  void* mem = arena ? arena->AllocateAligned(sizeof(BTreeRep::Iterator))
+                    : operator new(sizeof(BTreeRep::Iterator));
+  return new (mem) BTreeRep::Iterator(this);
+}
+
+bool BTreeRep::InsertKey(KeyHandle handle) {
+  const char* key = static_cast<char*>(handle);
+  const Slice internal_key = InternalKey(key);
+  for (int attempt = 0;; attempt++) {
+    if (attempt > 0) {
+      Backoff(attempt);
+    }
+    const InsertResult result = TryInsert(key, internal_key);
+    if (result != InsertResult::kRestart) {
+      return result == InsertResult::kInserted;
+    }
+  }
+}
+
+BTreeRep::InsertResult BTreeRep::TryInsert(const char* key,
+                                           const Slice& internal_key) {
+  Node* node = root_.load(std::memory_order_acquire);
+  uint64_t node_version;
+  if (!ReadLock(node, &node_version) ||
+      node != root_.load(std::memory_order_acquire)) {
+    return InsertResult::kRestart;
+  }
+  InnerNode* parent = nullptr;
+  uint64_t parent_version = 0;
+  for (;;) {
+    const int n = node->count.load(std::memory_order_acquire);
+    if (n == (node->leaf ? kLeafCapacity : kInnerCapacity)) {
+      if (parent != nullptr && !UpgradeToWriteLock(parent, parent_version)) {
+        return InsertResult::kRestart;
+      }
+      if (!UpgradeToWriteLock(node, node_version)) {
+        if (parent != nullptr) {
+          WriteUnlockUnchanged(parent, parent_version);
+        }
+        return InsertResult::kRestart;
+      }
+      if (parent == nullptr &&
+          node != root_.load(std::memory_order_acquire)) {
+        // The root was split concurrently
+        WriteUnlockUnchanged(node, node_version);
+        return InsertResult::kRestart;
+      }
+      SplitLocked(node, parent, internal_key);
+      WriteUnlock(node);
+      if (parent != nullptr) {
+        WriteUnlock(parent);
+      }
+      return InsertResult::kRestart;
+    }
+    if (node->leaf) {
+      break;
+    }
+    InnerNode* inner = static_cast<InnerNode*>(node);
+    const int i = Search(inner, n, internal_key, /*upper=*/true);
+    Node* child = inner->children[i].load(std::memory_order_acquire);
+    if (!Validate(inner, node_version)) {
+      return InsertResult::kRestart;
+    }
+    uint64_t child_version;
+    if (!ReadLock(child, &child_version) ||
+        !Validate(inner, node_version)) {
+      return InsertResult::kRestart;
+    }
+    parent = inner;
+    parent_version = node_version;
+    node = child;
+    node_version = child_version;
+  }
+
+  LeafNode* leaf = static_cast<LeafNode*>(node);
+  if (!UpgradeToWriteLock(leaf, node_version)) {
+    return InsertResult::kRestart;
+  }
+  const int n = leaf->count.load(std::memory_order_acquire);
+  bool found = false;
+  const int pos = Search(leaf, n, internal_key, /*upper=*/false, &found);
+  if (found) {
+    WriteUnlockUnchanged(leaf, node_version);
+    return InsertResult::kDuplicate;
+  }
+  for (int i = n; i > pos; i--) {
+    leaf->heads[i].store(leaf->heads[i - 1].load(std::memory_order_acquire),
+                         std::memory_order_release);
+    leaf->keys[i].store(leaf->keys[i - 1].load(std::memory_order_acquire),
+                        std::memory_order_release);
+  }
+  leaf->heads[pos].store(
+      KeyHead(key, leaf->prefix_len.load(std::memory_order_acquire)),
+      std::memory_order_release);
+  leaf->keys[pos].store(key, std::memory_order_release);
+  leaf->count.store(static_cast<uint16_t>(n + 1), std::memory_order_release);
+  WriteUnlock(leaf);
+  return InsertResult::kInserted;
+}
+
+void BTreeRep::SplitLocked(Node* node, InnerNode* parent,
+                           const Slice& internal_key) {
+  const int n = node->count.load(std::memory_order_acquire);
+  const char* separator;
+  Node* right;
+  if (node->leaf) {
+    LeafNode* leaf = static_cast<LeafNode*>(node);
+    // Keys inserted in order fill the leaves instead of leaving them half
+    // full.
+    const int pos = Search(leaf, n, internal_key, /*upper=*/false);
+    const int mid = pos == n ? n - 1 : n / 2;
+    separator = leaf->keys[mid].load(std::memory_order_acquire);
+    LeafNode* right_leaf = NewNode<LeafNode>(separator, leaf->high);
+    for (int i = mid; i < n; i++) {
+      right_leaf->keys[i - mid].store(
+          leaf->keys[i].load(std::memory_order_acquire),
+          std::memory_order_release);
+    }
+    right_leaf->count.store(static_cast<uint16_t>(n - mid),
+                            std::memory_order_release);
+    UpdateHeads(right_leaf, n - mid);
+    right_leaf->next.store(leaf->next.load(std::memory_order_acquire),
+                           std::memory_order_release);
+    // Publishes the right leaf to the iterators
+    leaf->next.store(right_leaf, std::memory_order_release);
+    leaf->count.store(static_cast<uint16_t>(mid), std::memory_order_release);
+    right = right_leaf;
+  } else {
+    InnerNode* inner = static_cast<InnerNode*>(node);
+    const int mid = n / 2;
+    separator = inner->keys[mid].load(std::memory_order_acquire);
+    InnerNode* right_inner = NewNode<InnerNode>(separator, inner->high);
+    for (int i = mid + 1; i < n; i++) {
+      right_inner->keys[i - mid - 1].store(
+          inner->keys[i].load(std::memory_order_acquire),
+          std::memory_order_release);
+    }
+    for (int i = mid + 1; i <= n; i++) {
+      right_inner->children[i - mid - 1].store(
+          inner->children[i].load(std::memory_order_acquire),
+          std::memory_order_release);
+    }
+    right_inner->count.store(static_cast<uint16_t>(n - mid - 1),
+                             std::memory_order_release);
+    UpdateHeads(right_inner, n - mid - 1);
+    inner->count.store(static_cast<uint16_t>(mid), std::memory_order_release);
+    right = right_inner;
+  }
+  // The left node keeps its low fence, and its prefix may grow
+  node->high = separator;
+  const uint16_t prefix_len = FencePrefixLength(node->low, separator);
+  if (prefix_len != node->prefix_len.load(std::memory_order_acquire)) {
+    node->prefix_len.store(prefix_len, std::memory_order_release);
+    const int left_count = node->count.load(std::memory_order_acquire);
+    if (node->leaf) {
+      UpdateHeads(static_cast<LeafNode*>(node), left_count);
+    } else {
+      UpdateHeads(static_cast<InnerNode*>(node), left_count);
+    }
+  }
+
+  if (parent != nullptr) {
+    InsertChild(parent, separator, right);
+  } else {
+    InnerNode* root = NewNode<InnerNode>(nullptr, nullptr);
+    root->keys[0].store(separator, std::memory_order_release);
+    root->heads[0].store(KeyHead(separator, 0), std::memory_order_release);
+    root->children[0].store(node, std::memory_order_release);
+    root->children[1].store(right, std::memory_order_release);
+    root->count.store(1, std::memory_order_release);
+    root_.store(root, std::memory_order_release);
+  }
+}
+
+void BTreeRep::InsertChild(InnerNode* parent, const char* separator,
+                           Node* child) {
+  const int n = parent->count.load(std::memory_order_acquire);
+  assert(n < kInnerCapacity);
+  const int pos =
+      Search(parent, n, InternalKey(separator), /*upper=*/true);
+  for (int i = n; i > pos; i--) {
+    parent->heads[i].store(parent->heads[i - 1].load(std::memory_order_acquire),
+                           std::memory_order_release);
+    parent->keys[i].store(parent->keys[i - 1].load(std::memory_order_acquire),
+                          std::memory_order_release);
+    parent->children[i + 1].store(
+        parent->children[i].load(std::memory_order_acquire),
+        std::memory_order_release);
+  }
+  parent->heads[pos].store(
+      KeyHead(separator, parent->prefix_len.load(std::memory_order_acquire)),
+      std::memory_order_release);
+  parent->keys[pos].store(separator, std::memory_order_release);
+  parent->children[pos + 1].store(child, std::memory_order_release);
+  parent->count.store(static_cast<uint16_t>(n + 1), std::memory_order_release);
+}
+
+}  // namespace
+
+MemTableRep* BTreeRepFactory::CreateMemTableRep(
+    const MemTableRep::KeyComparator& compare, Allocator* allocator,
+    const SliceTransform* /*transform*/, Logger* /*logger*/) {
+  return new BTreeRep(compare, allocator);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,348 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "db/dbformat.h"
+#include "db/memtable.h"
+#include "memory/concurrent_arena.h"
+#include "port/stack_trace.h"
+#include "rocksdb/convenience.h"
+#include "rocksdb/db.h"
+#include "rocksdb/memtablerep.h"
+#include "test_util/testharness.h"
+#include "util/coding.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class BTreeRepTest : public testing::Test {
+ public:
+  void Open(const Comparator* user_comparator) {
+    icmp_.reset(new InternalKeyComparator(user_comparator));
+    key_comp_.reset(new MemTable::KeyComparator(*icmp_));
+    rep_.reset(factory_.CreateMemTableRep(*key_comp_, &arena_, nullptr,
+                                          nullptr));
+  }
+
+  // Returns a memtable entry without value
+  const char* Encode(const std::string& user_key, SequenceNumber seq) {
+    const std::string internal_key =
+        InternalKey(user_key, seq, kTypeValue).Encode().ToString();
+    char* buf;
+    rep_->Allocate(VarintLength(internal_key.size()) + internal_key.size(),
+                   &buf);
+    char* p = EncodeVarint32(buf, static_cast<uint32_t>(internal_key.size()));
+    memcpy(p, internal_key.data(), internal_key.size());
+    return buf;
+  }
+
+  static Slice InternalKeyOf(const char* entry) {
+    return GetLengthPrefixedSlice(entry);
+  }
+
+  // Returns a Flink-like key: a key-group, a key and a namespace
+  static std::string StateKey(Random* rnd, int key_group) {
+    std::string key;
+    PutFixed16(&key, static_cast<uint16_t>(key_group));
+    key.append("state-key-");
+    key.append(std::to_string(rnd->Uniform(1000)));
+    if (rnd->OneIn(2)) {
+      key.push_back('\0');
+    }
+    key.append(rnd->Uniform(3), 'n');
+    return key;
+  }
+
+  void Verify(const std::vector<std::string>& expected) {
+    std::unique_ptr<MemTableRep::Iterator> iter(rep_->GetIterator());
+    iter->SeekToFirst();
+    for (const auto& key : expected) {
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(key, InternalKeyOf(iter->key()).ToString());
+      iter->Next();
+    }
+    ASSERT_FALSE(iter->Valid());
+
+    iter->SeekToLast();
+    for (auto it = expected.rbegin(); it != expected.rend(); ++it) {
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(*it, InternalKeyOf(iter->key()).ToString());
+      iter->Prev();
+    }
+    ASSERT_FALSE(iter->Valid());
+  }
+
+  BTreeRepFactory factory_;
+  ConcurrentArena arena_;
+  std::unique_ptr<InternalKeyComparator> icmp_;
+  std::unique_ptr<MemTable::KeyComparator> key_comp_;
+  std::unique_ptr<MemTableRep> rep_;
+};
+
+TEST_F(BTreeRepTest, Empty) {
+  Open(BytewiseComparator());
+  std::unique_ptr<MemTableRep::Iterator> iter(rep_->GetIterator());
+  iter->SeekToFirst();
+  ASSERT_FALSE(iter->Valid());
+  iter->SeekToLast();
+  ASSERT_FALSE(iter->Valid());
+  const std::string target =
+      InternalKey("a", 1, kTypeValue).Encode().ToString();
+  iter->Seek(target, nullptr);
+  ASSERT_FALSE(iter->Valid());
+  iter->SeekForPrev(target, nullptr);
+  ASSERT_FALSE(iter->Valid());
+  ASSERT_FALSE(rep_->Contains(Encode("a", 1)));
+}
+
+TEST_F(BTreeRepTest, InsertAndLookup) {
+  for (const Comparator* user_comparator :
+       {BytewiseComparator(), ReverseBytewiseComparator()}) {
+    Open(user_comparator);
+    Random rnd(301);
+    auto cmp = [this](const std::string& a, const std::string& b) {
+      return icmp_->Compare(a, b) < 0;
+    };
+    std::set<std::string, decltype(cmp)> keys(cmp);
+    for (int i = 0; i < 20000; i++) {
+      const std::string user_key = StateKey(&rnd, rnd.Uniform(4));
+      const SequenceNumber seq = rnd.Uniform(4);
+      const char* entry = Encode(user_key, seq);
+      const bool inserted = keys.insert(InternalKeyOf(entry).ToString()).second;
+      ASSERT_EQ(inserted, rep_->InsertKey(const_cast<char*>(entry)));
+      ASSERT_TRUE(rep_->Contains(entry));
+    }
+    // Keys inserted in order
+    for (int i = 0; i < 1000; i++) {
+      std::string user_key;
+      PutFixed16(&user_key, 4);
+      PutFixed32(&user_key, i);
+      const char* entry = Encode(user_key, 0);
+      keys.insert(InternalKeyOf(entry).ToString());
+      rep_->Insert(const_cast<char*>(entry));
+    }
+    Verify(std::vector<std::string>(keys.begin(), keys.end()));
+
+    std::unique_ptr<MemTableRep::Iterator> iter(rep_->GetIterator());
+    for (int i = 0; i < 2000; i++) {
+      const std::string target =
+          InternalKey(StateKey(&rnd, rnd.Uniform(5)), rnd.Uniform(5),
+                      kTypeValue)
+              .Encode()
+              .ToString();
+      auto it = keys.lower_bound(target);
+      iter->Seek(target, nullptr);
+      if (it == keys.end()) {
+        ASSERT_FALSE(iter->Valid());
+      } else {
+        ASSERT_TRUE(iter->Valid());
+        ASSERT_EQ(*it, InternalKeyOf(iter->key()).ToString());
+        iter->Prev();
+        if (it == keys.begin()) {
+          ASSERT_FALSE(iter->Valid());
+        } else {
+          ASSERT_TRUE(iter->Valid());
+          ASSERT_EQ(*std::prev(it), InternalKeyOf(iter->key()).ToString());
+        }
+      }
+
+      it = keys.upper_bound(target);
+      iter->SeekForPrev(target, nullptr);
+      if (it == keys.begin()) {
+        ASSERT_FALSE(iter->Valid());
+      } else {
+        ASSERT_TRUE(iter->Valid());
+        ASSERT_EQ(*std::prev(it), InternalKeyOf(iter->key()).ToString());
+        iter->Next();
+        if (it == keys.end()) {
+          ASSERT_FALSE(iter->Valid());
+        } else {
+          ASSERT_TRUE(iter->Valid());
+          ASSERT_EQ(*it, InternalKeyOf(iter->key()).ToString());
+        }
+      }
+    }
+  }
+}
+
+TEST_F(BTreeRepTest, ShortKeys) {
+  Open(BytewiseComparator());
+  // Keys which are prefixes of each other, and differ after 8 bytes
+  std::vector<std::string> user_keys = {"",
+                                        std::string(1, '\0'),
+                                        std::string(2, '\0'),
+                                        "a",
+                                        std::string("a\0", 2),
+                                        "a\x01",
+                                        "abcdefgh",
+                                        "abcdefgh\x01",
+                                        "abcdefghi",
+                                        "abcdefgi",
+                                        "\xff"};
+  std::vector<std::string> expected;
+  for (SequenceNumber seq = 0; seq < 40; seq++) {
+    for (const auto& user_key : user_keys) {
+      rep_->Insert(const_cast<char*>(Encode(user_key, seq)));
+    }
+  }
+  for (const auto& user_key : user_keys) {
+    for (SequenceNumber seq = 40; seq > 0; seq--) {
+      expected.push_back(
+          InternalKey(user_key, seq - 1, kTypeValue).Encode().ToString());
+    }
+  }
+  Verify(expected);
+}
+
+TEST_F(BTreeRepTest, ConcurrentInsert) {
+  Open(BytewiseComparator());
+  const int kThreads = 4;
+  const int kKeysPerThread = 20000;
+  std::atomic<int> duplicates{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t]() {
+      Random rnd(t);
+      for (int i = 0; i < kKeysPerThread; i++) {
+        // The threads insert the same keys in different orders
+        std::string user_key;
+        PutFixed16(&user_key, static_cast<uint16_t>(rnd.Uniform(8)));
+        PutFixed32(&user_key, i % 2 == 0 ? i : rnd.Uniform(kKeysPerThread));
+        if (!rep_->InsertKeyConcurrently(
+                const_cast<char*>(Encode(user_key, 0)))) {
+          duplicates.fetch_add(1);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::unique_ptr<MemTableRep::Iterator> iter(rep_->GetIterator());
+  std::string prev;
+  int count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    const std::string key = InternalKeyOf(iter->key()).ToString();
+    if (count > 0) {
+      ASSERT_LT(icmp_->Compare(prev, key), 0);
+    }
+    ASSERT_TRUE(rep_->Contains(iter->key()));
+    prev = key;
+    count++;
+  }
+  ASSERT_EQ(kThreads * kKeysPerThread, count + duplicates.load());
+}
+
+TEST_F(BTreeRepTest, ConcurrentRead) {
+  Open(BytewiseComparator());
+  const int kKeys = 50000;
+  std::atomic<int> inserted{0};
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; t++) {
+    readers.emplace_back([&, t]() {
+      Random rnd(t);
+      std::unique_ptr<MemTableRep::Iterator> iter(rep_->GetIterator());
+      while (!done.load()) {
+        // Every key inserted before the scan is found by it, in order
+        const int min_count = inserted.load();
+        int count = 0;
+        std::string prev;
+        if (rnd.OneIn(2)) {
+          for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+            const std::string key = InternalKeyOf(iter->key()).ToString();
+            ASSERT_TRUE(count == 0 || icmp_->Compare(prev, key) < 0);
+            prev = key;
+            count++;
+          }
+        } else {
+          for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+            const std::string key = InternalKeyOf(iter->key()).ToString();
+            ASSERT_TRUE(count == 0 || icmp_->Compare(prev, key) > 0);
+            prev = key;
+            count++;
+          }
+        }
+        ASSERT_GE(count, min_count);
+      }
+    });
+  }
+  Random rnd(301);
+  for (int i = 0; i < kKeys; i++) {
+    std::string user_key;
+    PutFixed16(&user_key, static_cast<uint16_t>(rnd.Uniform(4)));
+    PutFixed32(&user_key, i);
+    rep_->Insert(const_cast<char*>(Encode(user_key, 0)));
+    inserted.store(i + 1);
+  }
+  done.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
+TEST_F(BTreeRepTest, DB) {
+  std::unique_ptr<MemTableRepFactory> factory;
+  ConfigOptions config_options;
+  ASSERT_OK(
+      MemTableRepFactory::CreateFromString(config_options, "btree", &factory));
+  ASSERT_STREQ(BTreeRepFactory::kClassName(), factory->Name());
+
+  const std::string dbname = test::PerThreadDBPath("btree_rep_test");
+  Options options;
+  options.create_if_missing = true;
+  options.memtable_factory.reset(factory.release());
+  options.allow_concurrent_memtable_write = true;
+  ASSERT_OK(DestroyDB(dbname, options));
+  DB* db = nullptr;
+  ASSERT_OK(DB::Open(options, dbname, &db));
+
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_OK(db->Put(WriteOptions(), "key" + std::to_string(i), "v1"));
+  }
+  const Snapshot* snapshot = db->GetSnapshot();
+  ASSERT_OK(db->Put(WriteOptions(), "key1", "v2"));
+  ASSERT_OK(db->Delete(WriteOptions(), "key2"));
+  std::string value;
+  ASSERT_OK(db->Get(ReadOptions(), "key1", &value));
+  ASSERT_EQ("v2", value);
+  ASSERT_TRUE(db->Get(ReadOptions(), "key2", &value).IsNotFound());
+  ReadOptions read_options;
+  read_options.snapshot = snapshot;
+  ASSERT_OK(db->Get(read_options, "key1", &value));
+  ASSERT_EQ("v1", value);
+
+  std::unique_ptr<Iterator> iter(db->NewIterator(ReadOptions()));
+  int count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    count++;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(999, count);
+  iter.reset();
+  db->ReleaseSnapshot(snapshot);
+
+  ASSERT_OK(db->Flush(FlushOptions()));
+  ASSERT_OK(db->Get(ReadOptions(), "key1", &value));
+  ASSERT_EQ("v2", value);
+  delete db;
+  ASSERT_OK(DestroyDB(dbname, options));
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -63,6 +63,7 @@ DEFINE_string(memtablerep, "skiplist",
               "\tvector              -- backed by an std::vector\n"
               "\thashskiplist        -- backed by a hash skip list\n"
               "\thashlinklist        -- backed by a hash linked list\n"
+              "\tbtree               -- backed by a B+-tree\n"
               "\tcuckoo              -- backed by a cuckoo hash table");
 
 DEFINE_int64(bucket_count, 1000000,
@@ -114,6 +115,10 @@ DEFINE_int32(item_size, 100, "Number of bytes each item should be");
 DEFINE_int32(prefix_length, 8,
              "Prefix length to pass into NewFixedPrefixTransform");
 
+DEFINE_int32(key_prefix_size, 0,
+             "Number of bytes of a prefix common to all the keys, e.g. the "
+             "serialized key-group and state of Flink keys");
+
 /* VectorRep settings */
 DEFINE_int64(vectorrep_count, 0,
              "Number of entries to reserve on VectorRep initialization");
@@ -236,12 +241,14 @@ class FillBenchmarkThread : public BenchmarkThread {
 
   void FillOne() {
     char* buf = nullptr;
-    auto internal_key_size = 16;
+    auto internal_key_size = FLAGS_key_prefix_size + 16;
     auto encoded_len =
         FLAGS_item_size + VarintLength(internal_key_size) + internal_key_size;
     KeyHandle handle = table_->Allocate(encoded_len, &buf);
     assert(buf != nullptr);
     char* p = EncodeVarint32(buf, internal_key_size);
+    memset(p, 'k', FLAGS_key_prefix_size);
+    p += FLAGS_key_prefix_size;
     auto key = key_gen_->Next();
     EncodeFixed64(p, key);
     p += 8;
@@ -309,7 +316,7 @@ class ReadBenchmarkThread : public BenchmarkThread {
   }
 
   void ReadOne() {
-    std::string user_key;
+    std::string user_key(FLAGS_key_prefix_size, 'k');
     auto key = key_gen_->Next();
     PutFixed64(&user_key, key);
     LookupKey lookup_key(user_key, *sequence_);
@@ -321,7 +328,8 @@ class ReadBenchmarkThread : public BenchmarkThread {
     verify_args.comparator = &internal_key_comp;
     table_->Get(lookup_key, &verify_args, callback);
     if (verify_args.found) {
-      *bytes_read_ += VarintLength(16) + 16 + FLAGS_item_size;
+      *bytes_read_ += VarintLength(FLAGS_key_prefix_size + 16) +
+                      FLAGS_key_prefix_size + 16 + FLAGS_item_size;
       ++*read_hits_;
     }
   }
@@ -345,7 +353,8 @@ class SeqReadBenchmarkThread : public BenchmarkThread {
     std::unique_ptr<MemTableRep::Iterator> iter(table_->GetIterator());
     for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
       // pretend to read the value
-      *bytes_read_ += VarintLength(16) + 16 + FLAGS_item_size;
+      *bytes_read_ += VarintLength(FLAGS_key_prefix_size + 16) +
+                      FLAGS_key_prefix_size + 16 + FLAGS_item_size;
     }
     ++*read_hits_;
   }
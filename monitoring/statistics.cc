@@ -272,6 +272,8 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
      "rocksdb.compressed.secondary.cache.promotions"},
     {COMPRESSED_SECONDARY_CACHE_PROMOTION_SKIPS,
      "rocksdb.compressed.secondary.cache.promotion.skips"},
+    {FLINK_FS_BYTES_READ, "rocksdb.flink.fs.bytes.read"},
+    {FLINK_FS_BYTES_WRITTEN, "rocksdb.flink.fs.bytes.written"},
 };
 
 const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
@@ -340,6 +342,20 @@ const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
     {ASYNC_PREFETCH_ABORT_MICROS, "rocksdb.async.prefetch.abort.micros"},
     {TABLE_OPEN_PREFETCH_TAIL_READ_BYTES,
      "rocksdb.table.open.prefetch.tail.read.bytes"},
+    {FLINK_FS_OPEN_MICROS, "rocksdb.flink.fs.open.micros"},
+    {FLINK_FS_READ_MICROS, "rocksdb.flink.fs.read.micros"},
+    {FLINK_FS_READ_BYTES, "rocksdb.flink.fs.read.bytes"},
+    {FLINK_FS_WRITE_MICROS, "rocksdb.flink.fs.write.micros"},
+    {FLINK_FS_SYNC_MICROS, "rocksdb.flink.fs.sync.micros"},
+    {FLINK_FS_CLOSE_MICROS, "rocksdb.flink.fs.close.micros"},
+    {FLINK_FS_LIST_MICROS, "rocksdb.flink.fs.list.micros"},
+    {FLINK_FS_EXISTS_MICROS, "rocksdb.flink.fs.exists.micros"},
+    {FLINK_FS_RENAME_MICROS, "rocksdb.flink.fs.rename.micros"},
+    {FLINK_FS_DELETE_MICROS, "rocksdb.flink.fs.delete.micros"},
+    {FLINK_FS_LINK_MICROS, "rocksdb.flink.fs.link.micros"},
+    {FLINK_FS_GET_FILE_STATUS_MICROS,
+     "rocksdb.flink.fs.get.file.status.micros"},
+    {FLINK_FS_MKDIRS_MICROS, "rocksdb.flink.fs.mkdirs.micros"},
 };
 
 std::shared_ptr<Statistics> CreateDBStatistics() {
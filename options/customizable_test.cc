@@ -46,6 +46,7 @@
 #include "utilities/memory_allocators.h"
 #include "utilities/merge_operators/bytesxor.h"
 #include "utilities/merge_operators/sortlist.h"
+#include "utilities/merge_operators/string_append/listappend.h"
 #include "utilities/merge_operators/string_append/stringappend.h"
 #include "utilities/merge_operators/string_append/stringappend2.h"
 
@@ -1894,6 +1895,8 @@ TEST_F(LoadCustomizableTest, LoadMergeOperatorTest) {
       StringAppendOperator::kNickName(),
       StringAppendTESTOperator::kClassName(),
       StringAppendTESTOperator::kNickName(),
+      ListAppendOperator::kClassName(),
+      ListAppendOperator::kNickName(),
       SortList::kClassName(),
       SortList::kNickName(),
       BytesXOROperator::kClassName(),
@@ -117,6 +117,10 @@ LIB_SOURCES =                                                   \
   env/flink/jvm_util.cc											\
   env/flink/jni_helper.cc										\
   env/flink/env_flink_test_suite.cc 							\
+  env/flink/flink_file_cache.cc									\
+  env/flink/flink_file_uploader.cc								\
+  env/flink/flink_file_status_cache.cc							\
+  env/flink/flink_readahead_policy.cc							\
   file/delete_scheduler.cc                                      \
   file/file_prefetch_buffer.cc                                  \
   file/file_util.cc                                             \
@@ -137,6 +141,7 @@ LIB_SOURCES =                                                   \
   memory/memkind_kmem_allocator.cc                              \
   memory/memory_allocator.cc                                    \
   memtable/alloc_tracker.cc                                     \
+  memtable/btree_rep.cc                                         \
   memtable/hash_linklist_rep.cc                                 \
   memtable/hash_skiplist_rep.cc                                 \
   memtable/skiplistrep.cc                                       \
@@ -285,12 +290,14 @@ LIB_SOURCES =                                                   \
   utilities/fault_injection_fs.cc                               \
   utilities/fault_injection_secondary_cache.cc                  \
   utilities/flink/flink_compaction_filter.cc                    \
+  utilities/flink/flink_key_groups.cc                           \
   utilities/leveldb_options/leveldb_options.cc                  \
   utilities/memory/memory_util.cc                               \
   utilities/merge_operators.cc                                  \
   utilities/merge_operators/max.cc                              \
   utilities/merge_operators/put.cc                              \
   utilities/merge_operators/sortlist.cc                         \
+  utilities/merge_operators/string_append/listappend.cc         \
   utilities/merge_operators/string_append/stringappend.cc       \
   utilities/merge_operators/string_append/stringappend2.cc      \
   utilities/merge_operators/uint64add.cc                        \
@@ -435,6 +442,7 @@ BENCH_MAIN_SOURCES =                                                    \
   table/table_reader_bench.cc                                           \
   tools/db_bench.cc                                                     \
   util/filter_bench.cc                                                  \
+  utilities/flink/flink_compaction_filter_bench.cc                      \
   utilities/persistent_cache/persistent_cache_bench.cc                  \
   #util/log_write_bench.cc                                               \
 
@@ -547,6 +555,10 @@ TEST_MAIN_SOURCES =                                                     \
   env/env_test.cc                                                       \
   env/io_posix_test.cc                                                  \
   env/mock_env_test.cc                                                  \
+  env/flink/flink_file_cache_test.cc                                    \
+  env/flink/flink_file_uploader_test.cc                                 \
+  env/flink/flink_file_status_cache_test.cc                             \
+  env/flink/flink_readahead_policy_test.cc                              \
   file/delete_scheduler_test.cc                                         \
   file/prefetch_test.cc                                                 \
   file/random_access_file_reader_test.cc                                \
@@ -555,6 +567,7 @@ TEST_MAIN_SOURCES =                                                     \
   logging/event_logger_test.cc                                          \
   memory/arena_test.cc                                                  \
   memory/memory_allocator_test.cc                                       \
+  memtable/btree_rep_test.cc                                            \
   memtable/inlineskiplist_test.cc                                       \
   memtable/skiplist_test.cc                                             \
   memtable/write_buffer_manager_test.cc                                 \
@@ -619,6 +632,7 @@ TEST_MAIN_SOURCES =                                                     \
   utilities/checkpoint/checkpoint_test.cc                               \
   utilities/env_timed_test.cc                                           \
   utilities/flink/flink_compaction_filter_test.cc                       \
+  utilities/flink/flink_key_groups_test.cc                              \
   utilities/memory/memory_test.cc                                       \
   utilities/merge_operators/string_append/stringappend_test.cc          \
   utilities/object_registry_test.cc                                     \
@@ -678,6 +692,7 @@ JNI_NATIVE_SOURCES =                                          \
   java/forstjni/event_listener_jnicallback.cc                 \
   java/forstjni/import_column_family_options.cc               \
   java/forstjni/flink_compactionfilterjni.cc                  \
+  java/forstjni/flink_key_groupsjni.cc                        \
   java/forstjni/ingest_external_file_options.cc               \
   java/forstjni/filter.cc                                     \
   java/forstjni/hyper_clock_cache.cc                          \
@@ -11,7 +11,9 @@
 #include "utilities/checkpoint/checkpoint_impl.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cinttypes>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <unordered_set>
@@ -40,12 +42,27 @@ Status Checkpoint::Create(DB* db, Checkpoint** checkpoint_ptr) {
   return Status::OK();
 }
 
+Status Checkpoint::Create(DB* db, Checkpoint** checkpoint_ptr,
+                          int max_background_operations) {
+  *checkpoint_ptr = new CheckpointImpl(db, max_background_operations);
+  return Status::OK();
+}
+
 Status Checkpoint::CreateCheckpoint(const std::string& /*checkpoint_dir*/,
                                     uint64_t /*log_size_for_flush*/,
                                     uint64_t* /*sequence_number_ptr*/) {
   return Status::NotSupported("");
 }
 
+Status Checkpoint::CreateIncrementalCheckpoint(
+    const std::string& /*checkpoint_dir*/,
+    const std::unordered_set<std::string>& /*previous_files*/,
+    std::vector<std::string>* /*new_files*/,
+    std::vector<std::string>* /*reused_files*/,
+    uint64_t /*log_size_for_flush*/, uint64_t* /*sequence_number_ptr*/) {
+  return Status::NotSupported("");
+}
+
 void CheckpointImpl::CleanStagingDirectory(const std::string& full_private_path,
                                            Logger* info_log) {
   std::vector<std::string> subchildren;
@@ -80,6 +97,32 @@ Status Checkpoint::ExportColumnFamily(
 Status CheckpointImpl::CreateCheckpoint(const std::string& checkpoint_dir,
                                         uint64_t log_size_for_flush,
                                         uint64_t* sequence_number_ptr) {
+  return CreateCheckpointInternal(checkpoint_dir, log_size_for_flush,
+                                  sequence_number_ptr, nullptr, nullptr,
+                                  nullptr);
+}
+
+// Builds a snapshot of RocksDB without the files of a previous one
+Status CheckpointImpl::CreateIncrementalCheckpoint(
+    const std::string& checkpoint_dir,
+    const std::unordered_set<std::string>& previous_files,
+    std::vector<std::string>* new_files, std::vector<std::string>* reused_files,
+    uint64_t log_size_for_flush, uint64_t* sequence_number_ptr) {
+  assert(new_files != nullptr);
+  assert(reused_files != nullptr);
+  new_files->clear();
+  reused_files->clear();
+  return CreateCheckpointInternal(checkpoint_dir, log_size_for_flush,
+                                  sequence_number_ptr, &previous_files,
+                                  new_files, reused_files);
+}
+
+Status CheckpointImpl::CreateCheckpointInternal(
+    const std::string& checkpoint_dir, uint64_t log_size_for_flush,
+    uint64_t* sequence_number_ptr,
+    const std::unordered_set<std::string>* previous_files,
+    std::vector<std::string>* new_files,
+    std::vector<std::string>* reused_files) {
   DBOptions db_options = db_->GetDBOptions();
 
   Status s = db_->GetEnv()->FileExists(checkpoint_dir);
@@ -113,6 +156,27 @@ Status CheckpointImpl::CreateCheckpoint(const std::string& checkpoint_dir,
   // create snapshot directory
   s = db_->GetEnv()->CreateDir(full_private_path);
   uint64_t sequence_number = 0;
+  // The callbacks may run in parallel
+  std::mutex files_mutex;
+  auto add_file = [&](std::vector<std::string>* files,
+                      const std::string& fname) {
+    if (files != nullptr) {
+      std::lock_guard<std::mutex> lock(files_mutex);
+      files->push_back(fname);
+    }
+  };
+  // Table and blob files of the previous checkpoint are neither linked nor
+  // copied again
+  auto reuse_file = [&](const std::string& fname, FileType type) {
+    if (previous_files == nullptr ||
+        (type != kTableFile && type != kBlobFile) ||
+        previous_files->find(fname) == previous_files->end()) {
+      return false;
+    }
+    ROCKS_LOG_INFO(db_options.info_log, "Reusing %s", fname.c_str());
+    add_file(reused_files, fname);
+    return true;
+  };
   if (s.ok()) {
     // enable file deletions
     s = db_->DisableFileDeletions();
@@ -121,28 +185,47 @@ Status CheckpointImpl::CreateCheckpoint(const std::string& checkpoint_dir,
     if (s.ok() || s.IsNotSupported()) {
       s = CreateCustomCheckpoint(
           [&](const std::string& src_dirname, const std::string& fname,
-              FileType) {
+              FileType type) {
+            if (reuse_file(fname, type)) {
+              return Status::OK();
+            }
             ROCKS_LOG_INFO(db_options.info_log, "Hard Linking %s",
                            fname.c_str());
-            return db_->GetFileSystem()->LinkFile(
+            Status link_s = db_->GetFileSystem()->LinkFile(
                 src_dirname + "/" + fname, full_private_path + "/" + fname,
                 IOOptions(), nullptr);
+            if (link_s.ok()) {
+              add_file(new_files, fname);
+            }
+            return link_s;
           } /* link_file_cb */,
           [&](const std::string& src_dirname, const std::string& fname,
-              uint64_t size_limit_bytes, FileType,
+              uint64_t size_limit_bytes, FileType type,
               const std::string& /* checksum_func_name */,
               const std::string& /* checksum_val */,
               const Temperature temperature) {
+            if (reuse_file(fname, type)) {
+              return Status::OK();
+            }
             ROCKS_LOG_INFO(db_options.info_log, "Copying %s", fname.c_str());
-            return CopyFile(db_->GetFileSystem(), src_dirname + "/" + fname,
-                            full_private_path + "/" + fname, size_limit_bytes,
-                            db_options.use_fsync, nullptr, temperature);
+            Status copy_s = CopyFile(
+                db_->GetFileSystem(), src_dirname + "/" + fname,
+                full_private_path + "/" + fname, size_limit_bytes,
+                db_options.use_fsync, nullptr, temperature);
+            if (copy_s.ok()) {
+              add_file(new_files, fname);
+            }
+            return copy_s;
           } /* copy_file_cb */,
           [&](const std::string& fname, const std::string& contents, FileType) {
             ROCKS_LOG_INFO(db_options.info_log, "Creating %s", fname.c_str());
-            return CreateFile(db_->GetFileSystem(),
-                              full_private_path + "/" + fname, contents,
-                              db_options.use_fsync);
+            Status create_s = CreateFile(db_->GetFileSystem(),
+                                         full_private_path + "/" + fname,
+                                         contents, db_options.use_fsync);
+            if (create_s.ok()) {
+              add_file(new_files, fname);
+            }
+            return create_s;
           } /* create_file_cb */,
           &sequence_number, log_size_for_flush);
 
@@ -229,9 +312,10 @@ Status CheckpointImpl::CreateCustomCheckpoint(
         "db_paths / cf_paths not supported for Checkpoint nor BackupEngine");
   }
 
-  bool same_fs = true;
+  // Once linking is not supported, the remaining files are copied
+  std::atomic<bool> same_fs{true};
 
-  for (auto& info : infos) {
+  auto checkpoint_file = [&](const LiveFileStorageInfo& info) {
     Status s;
     if (!info.replacement_contents.empty()) {
       // Currently should only be used for CURRENT file.
@@ -245,16 +329,19 @@ Status CheckpointImpl::CreateCustomCheckpoint(
                            info.file_type);
       }
     } else {
-      if (same_fs && !info.trim_to_size) {
+      bool link = same_fs.load(std::memory_order_relaxed) &&
+                  !info.trim_to_size;
+      if (link) {
         s = link_file_cb(info.directory, info.relative_filename,
                          info.file_type);
         if (s.IsNotSupported()) {
-          same_fs = false;
+          same_fs.store(false, std::memory_order_relaxed);
+          link = false;
           s = Status::OK();
         }
         s.MustCheck();
       }
-      if (!same_fs || info.trim_to_size) {
+      if (!link) {
         assert(info.file_checksum_func_name.empty() ==
                !opts.include_checksum_info);
         // no assertion on file_checksum because empty is used for both "not
@@ -270,12 +357,52 @@ Status CheckpointImpl::CreateCustomCheckpoint(
         }
       }
     }
-    if (!s.ok()) {
-      return s;
+    return s;
+  };
+
+  if (max_background_operations_ <= 1 || infos.size() <= 1) {
+    for (auto& info : infos) {
+      Status s = checkpoint_file(info);
+      if (!s.ok()) {
+        return s;
+      }
     }
+    return Status::OK();
   }
 
-  return Status::OK();
+  // Files are taken by the threads one by one, so that large files do not
+  // hold up the others. The first error stops taking more files.
+  std::atomic<size_t> next_file{0};
+  std::atomic<bool> failed{false};
+  std::mutex error_mutex;
+  Status error;
+  auto process_files = [&]() {
+    size_t i;
+    while (!failed.load(std::memory_order_relaxed) &&
+           (i = next_file.fetch_add(1, std::memory_order_relaxed)) <
+               infos.size()) {
+      Status s = checkpoint_file(infos[i]);
+      if (!s.ok()) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (error.ok()) {
+          error = s;
+        }
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  };
+  size_t num_threads = std::min(
+      infos.size(), static_cast<size_t>(max_background_operations_));
+  std::vector<port::Thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; i++) {
+    threads.emplace_back(process_files);
+  }
+  process_files();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return error;
 }
 
 // Exports all live SST files of a specified Column Family onto export_dir,
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 #include "file/filename.h"
 #include "rocksdb/db.h"
@@ -15,18 +17,27 @@ namespace ROCKSDB_NAMESPACE {
 
 class CheckpointImpl : public Checkpoint {
  public:
-  explicit CheckpointImpl(DB* db) : db_(db) {}
+  explicit CheckpointImpl(DB* db, int max_background_operations = 1)
+      : db_(db), max_background_operations_(max_background_operations) {}
 
   Status CreateCheckpoint(const std::string& checkpoint_dir,
                           uint64_t log_size_for_flush,
                           uint64_t* sequence_number_ptr) override;
 
+  Status CreateIncrementalCheckpoint(
+      const std::string& checkpoint_dir,
+      const std::unordered_set<std::string>& previous_files,
+      std::vector<std::string>* new_files,
+      std::vector<std::string>* reused_files, uint64_t log_size_for_flush,
+      uint64_t* sequence_number_ptr) override;
+
   Status ExportColumnFamily(ColumnFamilyHandle* handle,
                             const std::string& export_dir,
                             ExportImportFilesMetaData** metadata) override;
 
   // Checkpoint logic can be customized by providing callbacks for link, copy,
-  // or create.
+  // or create. The callbacks must be thread-safe if max_background_operations
+  // is greater than 1.
   Status CreateCustomCheckpoint(
       std::function<Status(const std::string& src_dirname,
                            const std::string& fname, FileType type)>
@@ -46,6 +57,16 @@ class CheckpointImpl : public Checkpoint {
  private:
   void CleanStagingDirectory(const std::string& path, Logger* info_log);
 
+  // Builds a checkpoint, skipping the table and blob files in previous_files
+  // if not nullptr. The names of the created and skipped files are added to
+  // new_files and reused_files if not nullptr.
+  Status CreateCheckpointInternal(
+      const std::string& checkpoint_dir, uint64_t log_size_for_flush,
+      uint64_t* sequence_number_ptr,
+      const std::unordered_set<std::string>* previous_files,
+      std::vector<std::string>* new_files,
+      std::vector<std::string>* reused_files);
+
   // Export logic customization by providing callbacks for link or copy.
   Status ExportFilesInMetaData(
       const DBOptions& db_options, const ColumnFamilyMetaData& metadata,
@@ -58,6 +79,7 @@ class CheckpointImpl : public Checkpoint {
 
  private:
   DB* db_;
+  const int max_background_operations_;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
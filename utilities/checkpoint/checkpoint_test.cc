@@ -15,10 +15,12 @@
 #endif
 #include <iostream>
 #include <thread>
+#include <unordered_set>
 #include <utility>
 
 #include "db/db_impl/db_impl.h"
 #include "file/file_util.h"
+#include "file/filename.h"
 #include "port/port.h"
 #include "port/stack_trace.h"
 #include "rocksdb/db.h"
@@ -763,6 +765,125 @@ TEST_F(CheckpointTest, CheckpointWithParallelWrites) {
   thread.join();
 }
 
+TEST_F(CheckpointTest, CheckpointWithParallelCopies) {
+  // Links are not supported, so the files are copied
+  class NoLinkFileSystem : public FileSystemWrapper {
+   public:
+    explicit NoLinkFileSystem(const std::shared_ptr<FileSystem>& base)
+        : FileSystemWrapper(base) {}
+    const char* Name() const override { return "NoLinkFileSystem"; }
+    IOStatus LinkFile(const std::string& /*src*/,
+                      const std::string& /*target*/,
+                      const IOOptions& /*options*/,
+                      IODebugContext* /*dbg*/) override {
+      num_links_.fetch_add(1);
+      return IOStatus::NotSupported();
+    }
+    std::atomic<int> num_links_{0};
+  };
+  auto no_link_fs = std::make_shared<NoLinkFileSystem>(env_->GetFileSystem());
+  std::unique_ptr<Env> no_link_env(NewCompositeEnv(no_link_fs));
+
+  for (Env* env : {env_, no_link_env.get()}) {
+    Options options = CurrentOptions();
+    options.env = env;
+    options.disable_auto_compactions = true;
+    DestroyAndReopen(options);
+    for (int i = 0; i < 10; i++) {
+      ASSERT_OK(Put("key" + std::to_string(i), "val" + std::to_string(i)));
+      ASSERT_OK(Flush());
+    }
+    Checkpoint* checkpoint;
+    ASSERT_OK(Checkpoint::Create(db_, &checkpoint, 4));
+    ASSERT_OK(checkpoint->CreateCheckpoint(snapshot_name_));
+    delete checkpoint;
+    Close();
+
+    DB* snapshot_db;
+    ASSERT_OK(DB::Open(options, snapshot_name_, &snapshot_db));
+    for (int i = 0; i < 10; i++) {
+      std::string result;
+      ASSERT_OK(snapshot_db->Get(ReadOptions(), "key" + std::to_string(i),
+                                 &result));
+      ASSERT_EQ("val" + std::to_string(i), result);
+    }
+    delete snapshot_db;
+    ASSERT_OK(DestroyDB(snapshot_name_, options));
+  }
+  // Linking is not retried once it is not supported, but other threads may
+  // have tried it meanwhile
+  ASSERT_GE(no_link_fs->num_links_.load(), 1);
+  ASSERT_LE(no_link_fs->num_links_.load(), 4);
+}
+
+TEST_F(CheckpointTest, IncrementalCheckpoint) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+  ASSERT_OK(Put("key1", "val1"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Put("key2", "val2"));
+  ASSERT_OK(Flush());
+
+  Checkpoint* checkpoint;
+  ASSERT_OK(Checkpoint::Create(db_, &checkpoint));
+  const std::string previous_name = snapshot_name_ + "_previous";
+  std::vector<std::string> new_files;
+  std::vector<std::string> reused_files;
+  ASSERT_OK(checkpoint->CreateIncrementalCheckpoint(
+      previous_name, {}, &new_files, &reused_files));
+  ASSERT_TRUE(reused_files.empty());
+  std::unordered_set<std::string> previous_files;
+  uint64_t number;
+  FileType type;
+  for (const auto& fname : new_files) {
+    ASSERT_OK(env_->FileExists(previous_name + "/" + fname));
+    if (ParseFileName(fname, &number, &type) && type == kTableFile) {
+      previous_files.insert(fname);
+    }
+  }
+  ASSERT_EQ(2U, previous_files.size());
+
+  ASSERT_OK(Put("key3", "val3"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(Delete("key1"));
+  ASSERT_OK(checkpoint->CreateIncrementalCheckpoint(
+      snapshot_name_, previous_files, &new_files, &reused_files));
+  delete checkpoint;
+  // Only the new table files, including the one flushed by the checkpoint,
+  // are put into it
+  ASSERT_EQ(previous_files.size(), reused_files.size());
+  int num_table_files = 0;
+  for (const auto& fname : new_files) {
+    ASSERT_EQ(0U, previous_files.count(fname));
+    ASSERT_OK(env_->FileExists(snapshot_name_ + "/" + fname));
+    if (ParseFileName(fname, &number, &type) && type == kTableFile) {
+      num_table_files++;
+    }
+  }
+  ASSERT_EQ(2, num_table_files);
+  for (const auto& fname : reused_files) {
+    ASSERT_EQ(1U, previous_files.count(fname));
+    ASSERT_TRUE(env_->FileExists(snapshot_name_ + "/" + fname).IsNotFound());
+    ASSERT_OK(CopyFile(env_->GetFileSystem(), previous_name + "/" + fname,
+                       snapshot_name_ + "/" + fname, 0, false, nullptr,
+                       Temperature::kUnknown));
+  }
+  Close();
+
+  DB* snapshot_db;
+  ASSERT_OK(DB::Open(options, snapshot_name_, &snapshot_db));
+  std::string result;
+  ASSERT_TRUE(snapshot_db->Get(ReadOptions(), "key1", &result).IsNotFound());
+  ASSERT_OK(snapshot_db->Get(ReadOptions(), "key2", &result));
+  ASSERT_EQ("val2", result);
+  ASSERT_OK(snapshot_db->Get(ReadOptions(), "key3", &result));
+  ASSERT_EQ("val3", result);
+  delete snapshot_db;
+  ASSERT_OK(DestroyDB(snapshot_name_, options));
+  ASSERT_OK(DestroyDB(previous_name, options));
+}
+
 TEST_F(CheckpointTest, CheckpointWithUnsyncedDataDropped) {
   Options options = CurrentOptions();
   std::unique_ptr<FaultInjectionTestEnv> env(new FaultInjectionTestEnv(env_));
@@ -5,19 +5,27 @@
 
 #include "utilities/flink/flink_compaction_filter.h"
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 #include <algorithm>
 #include <cinttypes>
 
+#include "rocksdb/convenience.h"
+#include "util/coding.h"
+#include "util/math.h"
+
 namespace ROCKSDB_NAMESPACE {
 namespace flink {
 
 int64_t DeserializeTimestamp(const char* src, std::size_t offset) {
-  uint64_t result = 0;
-  for (unsigned long i = 0; i < sizeof(uint64_t); i++) {
-    result |= static_cast<uint64_t>(static_cast<unsigned char>(src[offset + i]))
-              << ((sizeof(int64_t) - 1 - i) * BITS_PER_BYTE);
-  }
-  return static_cast<int64_t>(result);
+  // Java serializes the timestamp in big endian
+  return static_cast<int64_t>(EndianSwapValue(DecodeFixed64(src + offset)));
+}
+
+int64_t TtlWithoutOverflow(const int64_t timestamp, const int64_t ttl) {
+  return timestamp > 0 ? std::min(JAVA_MAX_LONG - timestamp, ttl) : ttl;
 }
 
 CompactionFilter::Decision Decide(const char* ts_bytes, const int64_t ttl,
@@ -25,8 +33,7 @@ CompactionFilter::Decision Decide(const char* ts_bytes, const int64_t ttl,
                                   const int64_t current_timestamp,
                                   const std::shared_ptr<Logger>& logger) {
   int64_t timestamp = DeserializeTimestamp(ts_bytes, timestamp_offset);
-  const int64_t ttlWithoutOverflow =
-      timestamp > 0 ? std::min(JAVA_MAX_LONG - timestamp, ttl) : ttl;
+  const int64_t ttlWithoutOverflow = TtlWithoutOverflow(timestamp, ttl);
   Debug(logger.get(),
         "Last access timestamp: %" PRId64 " ms, ttlWithoutOverflow: %" PRId64
         " ms, Current timestamp: %" PRId64 " ms",
@@ -64,8 +71,67 @@ FlinkCompactionFilter::ConfigHolder::GetConfig() {
   return config_.load();
 }
 
+namespace {
+// Returns the index of the first of num_elements elements, whose timestamps
+// are fixed_size apart starting from timestamps, with a timestamp greater
+// than max_expired_timestamp, or num_elements if all of them are expired.
+std::size_t FindFirstUnexpired(const char* timestamps, std::size_t fixed_size,
+                               std::size_t num_elements,
+                               int64_t max_expired_timestamp) {
+  std::size_t i = 0;
+#ifdef __AVX2__
+  // Gathers the timestamps of 4 elements at once and reverses the bytes of
+  // each of them to compare them as native integers.
+  const __m256i byte_swap = _mm256_setr_epi8(
+      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2,
+      1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  const __m256i max_expired = _mm256_set1_epi64x(max_expired_timestamp);
+  const long long stride = static_cast<long long>(fixed_size);
+  const __m256i strides =
+      _mm256_setr_epi64x(0, stride, 2 * stride, 3 * stride);
+  for (; i + 4 <= num_elements; i += 4) {
+    __m256i ts = _mm256_i64gather_epi64(
+        reinterpret_cast<const long long*>(timestamps + i * fixed_size),
+        strides, 1);
+    ts = _mm256_shuffle_epi8(ts, byte_swap);
+    int unexpired = _mm256_movemask_pd(
+        _mm256_castsi256_pd(_mm256_cmpgt_epi64(ts, max_expired)));
+    if (unexpired != 0) {
+      return i + CountTrailingZeroBits(static_cast<uint32_t>(unexpired));
+    }
+  }
+#endif
+  for (; i < num_elements; i++) {
+    if (DeserializeTimestamp(timestamps, i * fixed_size) >
+        max_expired_timestamp) {
+      return i;
+    }
+  }
+  return num_elements;
+}
+}  // namespace
+
 std::size_t FlinkCompactionFilter::FixedListElementFilter::NextUnexpiredOffset(
     const Slice& list, int64_t ttl, int64_t current_timestamp) const {
+  // An element is expired iff its timestamp is at most current_timestamp - ttl
+  // unless it overflows, then the elements are decided one by one.
+  if (fixed_size_ > 0 && ttl >= 0 && current_timestamp < JAVA_MAX_LONG &&
+      current_timestamp >= JAVA_MIN_LONG + ttl) {
+    if (list.size() < timestamp_offset_ + TIMESTAMP_BYTE_SIZE) {
+      return 0;
+    }
+    // Elements with the whole timestamp in the list. A truncated element
+    // after them is kept as its timestamp can't be read.
+    std::size_t num_elements =
+        (list.size() - timestamp_offset_ - TIMESTAMP_BYTE_SIZE) / fixed_size_ +
+        1;
+    std::size_t index =
+        FindFirstUnexpired(list.data() + timestamp_offset_, fixed_size_,
+                           num_elements, current_timestamp - ttl);
+    std::size_t offset = index * fixed_size_;
+    return offset >= JAVA_MAX_SIZE ? JAVA_MAX_SIZE : offset;
+  }
+
   std::size_t offset = 0;
   while (offset < list.size()) {
     Decision decision = Decide(list.data(), ttl, offset + timestamp_offset_,
@@ -83,6 +149,26 @@ std::size_t FlinkCompactionFilter::FixedListElementFilter::NextUnexpiredOffset(
   return offset;
 }
 
+bool FlinkCompactionFilter::FixedListElementFilter::GetTimestampRange(
+    const Slice& list, int64_t* min_timestamp, int64_t* max_timestamp) const {
+  // A truncated element is never removed by the filter
+  if (fixed_size_ < timestamp_offset_ + TIMESTAMP_BYTE_SIZE || list.empty() ||
+      list.size() % fixed_size_ != 0) {
+    return false;
+  }
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  for (std::size_t offset = timestamp_offset_; offset < list.size();
+       offset += fixed_size_) {
+    int64_t timestamp = DeserializeTimestamp(list.data(), offset);
+    min = std::min(min, timestamp);
+    max = std::max(max, timestamp);
+  }
+  *min_timestamp = min;
+  *max_timestamp = max;
+  return true;
+}
+
 const char* FlinkCompactionFilter::Name() const {
   return "FlinkCompactionFilter";
 }
@@ -205,5 +291,145 @@ void FlinkCompactionFilter::SetUnexpiredListValue(
     Debug(logger, "New list value: %s", new_value_slice.ToString(true).c_str());
   }
 }
+
+FlinkTtlTablePropertiesCollector::FlinkTtlTablePropertiesCollector(
+    std::shared_ptr<FlinkCompactionFilter::ConfigHolder> config_holder)
+    : config_holder_(std::move(config_holder)),
+      config_(config_holder_->GetConfig()) {
+  if (config_->list_element_filter_factory_) {
+    list_element_filter_.reset(
+        config_->list_element_filter_factory_->CreateListElementFilter(
+            nullptr));
+  }
+}
+
+bool FlinkTtlTablePropertiesCollector::GetTimestampRange(
+    const Slice& value, EntryType type, int64_t* min_timestamp,
+    int64_t* max_timestamp) const {
+  // Mirrors the entries removed by FlinkCompactionFilter::FilterV2
+  if (value.size() < config_->timestamp_offset_ + TIMESTAMP_BYTE_SIZE) {
+    return false;
+  }
+  switch (config_->state_type_) {
+    case FlinkCompactionFilter::StateType::Value:
+      if (type != kEntryPut) {
+        return false;
+      }
+      break;
+    case FlinkCompactionFilter::StateType::List:
+      if (type != kEntryPut && type != kEntryMerge) {
+        return false;
+      }
+      if (list_element_filter_) {
+        return list_element_filter_->GetTimestampRange(value, min_timestamp,
+                                                       max_timestamp);
+      }
+      // Without a list element filter, the whole list is removed once its
+      // first element expires.
+      break;
+    default:
+      return false;
+  }
+  *min_timestamp = *max_timestamp =
+      DeserializeTimestamp(value.data(), config_->timestamp_offset_);
+  return true;
+}
+
+Status FlinkTtlTablePropertiesCollector::AddUserKey(
+    const Slice& /*key*/, const Slice& value, EntryType type,
+    SequenceNumber /*seq*/, uint64_t /*file_size*/) {
+  if (!expirable_) {
+    return Status::OK();
+  }
+  int64_t min_timestamp;
+  int64_t max_timestamp;
+  if (GetTimestampRange(value, type, &min_timestamp, &max_timestamp)) {
+    min_timestamp_ = std::min(min_timestamp_, min_timestamp);
+    max_timestamp_ = std::max(max_timestamp_, max_timestamp);
+    num_entries_++;
+  } else {
+    expirable_ = false;
+  }
+  return Status::OK();
+}
+
+Status FlinkTtlTablePropertiesCollector::Finish(
+    UserCollectedProperties* properties) {
+  if (expirable_ && num_entries_ > 0) {
+    std::string min_timestamp;
+    std::string max_timestamp;
+    PutFixed64(&min_timestamp, static_cast<uint64_t>(min_timestamp_));
+    PutFixed64(&max_timestamp, static_cast<uint64_t>(max_timestamp_));
+    properties->emplace(TTL_MIN_TIMESTAMP_PROPERTY, min_timestamp);
+    properties->emplace(TTL_MAX_TIMESTAMP_PROPERTY, max_timestamp);
+  }
+  return Status::OK();
+}
+
+UserCollectedProperties
+FlinkTtlTablePropertiesCollector::GetReadableProperties() const {
+  UserCollectedProperties properties;
+  if (expirable_ && num_entries_ > 0) {
+    properties.emplace(TTL_MIN_TIMESTAMP_PROPERTY,
+                       std::to_string(min_timestamp_));
+    properties.emplace(TTL_MAX_TIMESTAMP_PROPERTY,
+                       std::to_string(max_timestamp_));
+  }
+  return properties;
+}
+
+const char* FlinkTtlTablePropertiesCollector::Name() const {
+  return "FlinkTtlTablePropertiesCollector";
+}
+
+std::unique_ptr<CompactionFilter>
+FlinkCompactionFilterFactory::CreateCompactionFilter(
+    const CompactionFilter::Context& /*context*/) {
+  return std::unique_ptr<CompactionFilter>(new FlinkCompactionFilter(
+      config_holder_,
+      std::unique_ptr<FlinkCompactionFilter::TimeProvider>(
+          new FlinkCompactionFilter::SharedTimeProvider(current_timestamp_)),
+      logger_));
+}
+
+const char* FlinkCompactionFilterFactory::Name() const {
+  return "FlinkCompactionFilterFactory";
+}
+
+TablePropertiesCollector*
+FlinkTtlTablePropertiesCollectorFactory::CreateTablePropertiesCollector(
+    TablePropertiesCollectorFactory::Context /*context*/) {
+  if (config_holder_->GetConfig()->state_type_ ==
+      FlinkCompactionFilter::StateType::Disabled) {
+    return nullptr;
+  }
+  return new FlinkTtlTablePropertiesCollector(config_holder_);
+}
+
+const char* FlinkTtlTablePropertiesCollectorFactory::Name() const {
+  return "FlinkTtlTablePropertiesCollectorFactory";
+}
+
+Status DeleteExpiredFiles(DB* db, ColumnFamilyHandle* column_family,
+                          int64_t ttl, int64_t current_timestamp,
+                          uint64_t* num_deleted) {
+  auto expired = [ttl, current_timestamp](const TableProperties& props) {
+    // Tombstones may shadow older entries in other files
+    if (props.num_deletions > 0 || props.num_range_deletions > 0) {
+      return false;
+    }
+    auto it = props.user_collected_properties.find(TTL_MAX_TIMESTAMP_PROPERTY);
+    if (it == props.user_collected_properties.end() ||
+        it->second.size() != sizeof(uint64_t)) {
+      return false;
+    }
+    int64_t max_timestamp =
+        static_cast<int64_t>(DecodeFixed64(it->second.data()));
+    return max_timestamp + TtlWithoutOverflow(max_timestamp, ttl) <=
+           current_timestamp;
+  };
+  return DeleteFilesByTableProperties(db, column_family, expired, num_deleted);
+}
+
 }  // namespace flink
 }  // namespace ROCKSDB_NAMESPACE
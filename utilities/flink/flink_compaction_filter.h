@@ -9,11 +9,14 @@
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "rocksdb/compaction_filter.h"
+#include "rocksdb/db.h"
 #include "rocksdb/slice.h"
+#include "rocksdb/table_properties.h"
 
 namespace ROCKSDB_NAMESPACE {
 namespace flink {
@@ -47,6 +50,22 @@ class FlinkCompactionFilter : public CompactionFilter {
     virtual int64_t CurrentTimestamp() const = 0;
   };
 
+  // Provides the current timestamp which is set by the application, e.g.
+  // periodically, so that it is read without calling back into the
+  // application. The timestamp is shared by the providers of all the filters.
+  class SharedTimeProvider : public TimeProvider {
+   public:
+    explicit SharedTimeProvider(
+        std::shared_ptr<std::atomic<int64_t>> current_timestamp)
+        : current_timestamp_(std::move(current_timestamp)) {}
+    int64_t CurrentTimestamp() const override {
+      return current_timestamp_->load(std::memory_order_relaxed);
+    }
+
+   private:
+    std::shared_ptr<std::atomic<int64_t>> current_timestamp_;
+  };
+
   // accepts serialized list state and checks elements for expiration starting
   // from the head stops upon discovery of unexpired element and returns its
   // offset or returns offset greater or equal to list byte length.
@@ -55,6 +74,13 @@ class FlinkCompactionFilter : public CompactionFilter {
     virtual ~ListElementFilter() = default;
     virtual std::size_t NextUnexpiredOffset(
         const Slice& list, int64_t ttl, int64_t current_timestamp) const = 0;
+    // gets the min and max timestamps of the list elements, returns false if
+    // they are unknown or some element can never expire.
+    virtual bool GetTimestampRange(const Slice& /*list*/,
+                                   int64_t* /*min_timestamp*/,
+                                   int64_t* /*max_timestamp*/) const {
+      return false;
+    }
   };
 
   // this filter can operate directly on list state bytes
@@ -70,6 +96,8 @@ class FlinkCompactionFilter : public CompactionFilter {
           logger_(std::move(logger)) {}
     std::size_t NextUnexpiredOffset(const Slice& list, int64_t ttl,
                                     int64_t current_timestamp) const override;
+    bool GetTimestampRange(const Slice& list, int64_t* min_timestamp,
+                           int64_t* max_timestamp) const override;
 
    private:
     std::size_t fixed_size_;
@@ -187,5 +215,91 @@ static const FlinkCompactionFilter::Config DISABLED_CONFIG =
                                   std::numeric_limits<int64_t>::max(),
                                   std::numeric_limits<int64_t>::max(), nullptr};
 
+// Names of the user collected table properties with the min and max
+// timestamps of the state entries in the table, as fixed64.
+static const char* const TTL_MIN_TIMESTAMP_PROPERTY = "flink.ttl.min-timestamp";
+static const char* const TTL_MAX_TIMESTAMP_PROPERTY = "flink.ttl.max-timestamp";
+
+// Collects the min and max timestamps of the state entries, as seen by
+// FlinkCompactionFilter, of each table file. The properties are only written
+// if every entry of the table would be removed by the filter once the max
+// timestamp expires, i.e. there are no deletes and no entries without a
+// readable timestamp, so that the file can be dropped as a whole.
+class FlinkTtlTablePropertiesCollector : public TablePropertiesCollector {
+ public:
+  explicit FlinkTtlTablePropertiesCollector(
+      std::shared_ptr<FlinkCompactionFilter::ConfigHolder> config_holder);
+
+  Status AddUserKey(const Slice& key, const Slice& value, EntryType type,
+                    SequenceNumber seq, uint64_t file_size) override;
+  Status Finish(UserCollectedProperties* properties) override;
+  UserCollectedProperties GetReadableProperties() const override;
+  const char* Name() const override;
+
+ private:
+  bool GetTimestampRange(const Slice& value, EntryType type,
+                         int64_t* min_timestamp, int64_t* max_timestamp) const;
+
+  std::shared_ptr<FlinkCompactionFilter::ConfigHolder> config_holder_;
+  FlinkCompactionFilter::Config* config_;
+  std::unique_ptr<FlinkCompactionFilter::ListElementFilter>
+      list_element_filter_;
+  bool expirable_ = true;
+  uint64_t num_entries_ = 0;
+  int64_t min_timestamp_ = std::numeric_limits<int64_t>::max();
+  int64_t max_timestamp_ = std::numeric_limits<int64_t>::min();
+};
+
+// Creates FlinkCompactionFilters with the shared config and timestamp without
+// calling back into the application, so compaction threads are not attached
+// to the JVM.
+class FlinkCompactionFilterFactory : public CompactionFilterFactory {
+ public:
+  explicit FlinkCompactionFilterFactory(
+      std::shared_ptr<FlinkCompactionFilter::ConfigHolder> config_holder,
+      std::shared_ptr<std::atomic<int64_t>> current_timestamp,
+      std::shared_ptr<Logger> logger = nullptr)
+      : config_holder_(std::move(config_holder)),
+        current_timestamp_(std::move(current_timestamp)),
+        logger_(std::move(logger)) {}
+
+  std::unique_ptr<CompactionFilter> CreateCompactionFilter(
+      const CompactionFilter::Context& context) override;
+  const char* Name() const override;
+
+ private:
+  std::shared_ptr<FlinkCompactionFilter::ConfigHolder> config_holder_;
+  std::shared_ptr<std::atomic<int64_t>> current_timestamp_;
+  std::shared_ptr<Logger> logger_;
+};
+
+// Creates FlinkTtlTablePropertiesCollectors with the config of the
+// FlinkCompactionFilters of the same column family.
+class FlinkTtlTablePropertiesCollectorFactory
+    : public TablePropertiesCollectorFactory {
+ public:
+  explicit FlinkTtlTablePropertiesCollectorFactory(
+      std::shared_ptr<FlinkCompactionFilter::ConfigHolder> config_holder)
+      : config_holder_(std::move(config_holder)) {}
+
+  TablePropertiesCollector* CreateTablePropertiesCollector(
+      TablePropertiesCollectorFactory::Context context) override;
+  const char* Name() const override;
+
+ private:
+  std::shared_ptr<FlinkCompactionFilter::ConfigHolder> config_holder_;
+};
+
+// Drops the table files, except those in level 0, whose state entries are all
+// expired according to the properties of FlinkTtlTablePropertiesCollector,
+// instead of rewriting them in compactions. The files are deleted with
+// DeleteFilesByTableProperties(), see its caveats. Unlike the filter, it drops
+// the entries without tombstones, which is only safe as older versions of a
+// state entry, in older files, do not have later timestamps and so they are
+// expired too.
+Status DeleteExpiredFiles(DB* db, ColumnFamilyHandle* column_family,
+                          int64_t ttl, int64_t current_timestamp,
+                          uint64_t* num_deleted = nullptr);
+
 }  // namespace flink
 }  // namespace ROCKSDB_NAMESPACE
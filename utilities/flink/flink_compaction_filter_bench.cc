@@ -0,0 +1,141 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#ifndef GFLAGS
+#include <cstdio>
+int main() {
+  fprintf(stderr, "Please install gflags to run rocksdb tools\n");
+  return 1;
+}
+#else
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "rocksdb/system_clock.h"
+#include "util/gflags_compat.h"
+#include "util/stop_watch.h"
+#include "utilities/flink/flink_compaction_filter.h"
+
+using GFLAGS_NAMESPACE::ParseCommandLineFlags;
+
+DEFINE_uint64(num_elements, 1000000, "number of elements in the list state");
+
+DEFINE_uint64(element_size, 16, "byte size of each list element");
+
+DEFINE_uint64(timestamp_offset, 0,
+              "offset of the timestamp in each list element");
+
+DEFINE_double(expired_ratio, 1.0,
+              "ratio of the list elements which are expired, from the head");
+
+DEFINE_int64(ttl, 1000, "ttl of the list elements in ms");
+
+DEFINE_int32(num_runs, 100, "number of scans of the list state");
+
+namespace ROCKSDB_NAMESPACE {
+namespace flink {
+namespace {
+
+void SetTimestamp(int64_t timestamp, char* dst) {
+  for (std::size_t i = 0; i < TIMESTAMP_BYTE_SIZE; i++) {
+    dst[i] = static_cast<char>(static_cast<uint64_t>(timestamp) >>
+                               ((TIMESTAMP_BYTE_SIZE - 1 - i) * BITS_PER_BYTE));
+  }
+}
+
+class FixedTimeProvider : public FlinkCompactionFilter::TimeProvider {
+ public:
+  explicit FixedTimeProvider(int64_t timestamp) : timestamp_(timestamp) {}
+  int64_t CurrentTimestamp() const override { return timestamp_; }
+
+ private:
+  const int64_t timestamp_;
+};
+
+void PrintResult(const char* name, uint64_t elements, uint64_t micros) {
+  fprintf(stdout, "%-22s: %10.3f micros/run, %12.0f elements/sec\n", name,
+          static_cast<double>(micros) / FLAGS_num_runs,
+          static_cast<double>(elements) * 1000000 /
+              static_cast<double>(micros > 0 ? micros : 1));
+}
+
+int Run() {
+  if (FLAGS_element_size < FLAGS_timestamp_offset + TIMESTAMP_BYTE_SIZE) {
+    fprintf(stderr, "element_size is too small for the timestamp\n");
+    return 1;
+  }
+  const int64_t current_timestamp = int64_t{1} << 40;
+  const uint64_t num_expired =
+      static_cast<uint64_t>(FLAGS_num_elements * FLAGS_expired_ratio);
+  std::string list(FLAGS_num_elements * FLAGS_element_size, 'v');
+  for (uint64_t i = 0; i < FLAGS_num_elements; i++) {
+    int64_t timestamp = i < num_expired
+                            ? current_timestamp - FLAGS_ttl
+                            : current_timestamp;
+    SetTimestamp(timestamp,
+                 &list[i * FLAGS_element_size + FLAGS_timestamp_offset]);
+  }
+  // Elements scanned by each run, including the first unexpired one
+  const uint64_t scanned =
+      std::min(num_expired + 1, static_cast<uint64_t>(FLAGS_num_elements));
+  SystemClock* clock = SystemClock::Default().get();
+
+  FlinkCompactionFilter::FixedListElementFilter list_filter(
+      FLAGS_element_size, FLAGS_timestamp_offset, nullptr);
+  uint64_t micros = 0;
+  std::size_t offset = 0;
+  {
+    StopWatch sw(clock, nullptr, Histograms::HISTOGRAM_ENUM_MAX,
+                 Histograms::HISTOGRAM_ENUM_MAX, &micros);
+    for (int run = 0; run < FLAGS_num_runs; run++) {
+      offset += list_filter.NextUnexpiredOffset(list, FLAGS_ttl,
+                                                current_timestamp);
+    }
+  }
+  if (offset != num_expired * FLAGS_element_size * FLAGS_num_runs) {
+    fprintf(stderr, "Unexpected offset of the first unexpired element\n");
+    return 1;
+  }
+  PrintResult("NextUnexpiredOffset", scanned * FLAGS_num_runs, micros);
+
+  // Also includes copying the unexpired elements
+  auto config_holder = std::make_shared<FlinkCompactionFilter::ConfigHolder>();
+  config_holder->Configure(new FlinkCompactionFilter::Config{
+      FlinkCompactionFilter::StateType::List, FLAGS_timestamp_offset,
+      FLAGS_ttl, std::numeric_limits<int64_t>::max(),
+      std::unique_ptr<FlinkCompactionFilter::ListElementFilterFactory>(
+          new FlinkCompactionFilter::FixedListElementFilterFactory(
+              FLAGS_element_size, FLAGS_timestamp_offset))});
+  FlinkCompactionFilter filter(
+      config_holder, std::unique_ptr<FlinkCompactionFilter::TimeProvider>(
+                         new FixedTimeProvider(current_timestamp)));
+  std::string new_value;
+  std::string skip_until;
+  {
+    StopWatch sw(clock, nullptr, Histograms::HISTOGRAM_ENUM_MAX,
+                 Histograms::HISTOGRAM_ENUM_MAX, &micros);
+    for (int run = 0; run < FLAGS_num_runs; run++) {
+      filter.FilterV2(0, "key", CompactionFilter::ValueType::kValue, list,
+                      &new_value, &skip_until);
+    }
+  }
+  PrintResult("FilterV2", scanned * FLAGS_num_runs, micros);
+  return 0;
+}
+
+}  // namespace
+}  // namespace flink
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ParseCommandLineFlags(&argc, &argv, true);
+  return ROCKSDB_NAMESPACE::flink::Run();
+}
+
+#endif  // GFLAGS
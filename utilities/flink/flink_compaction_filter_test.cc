@@ -7,7 +7,9 @@
 
 #include <random>
 
+#include "rocksdb/db.h"
 #include "test_util/testharness.h"
+#include "util/coding.h"
 
 namespace ROCKSDB_NAMESPACE {
 namespace flink {
@@ -171,6 +173,44 @@ TEST(FlinkValueStateTtlTest, CachedTimeUpdate) {  // NOLINT
   Deinit();
 }
 
+TEST(FlinkValueStateTtlTest, SharedTimeProvider) {  // NOLINT
+  auto current_timestamp = std::make_shared<std::atomic<int64_t>>(0);
+  auto config_holder = std::make_shared<FlinkCompactionFilter::ConfigHolder>();
+  EXPECT_TRUE(config_holder->Configure(new FlinkCompactionFilter::Config{
+      VALUE, TEST_TIMESTAMP_OFFSET, ttl, 1, nullptr}));
+  FlinkCompactionFilter shared_time_filter(
+      config_holder,
+      std::unique_ptr<FlinkCompactionFilter::TimeProvider>(
+          new FlinkCompactionFilter::SharedTimeProvider(current_timestamp)));
+  SetTimestamp(10, TEST_TIMESTAMP_OFFSET);
+  Slice value(data, sizeof(data));
+  EXPECT_EQ(
+      shared_time_filter.FilterV2(0, key, KVALUE, value, &new_list, &stub),
+      KKEEP);
+  // The filter reads the timestamp set later
+  current_timestamp->store(10 + ttl);
+  EXPECT_EQ(
+      shared_time_filter.FilterV2(0, key, KVALUE, value, &new_list, &stub),
+      KREMOVE);
+}
+
+TEST(FlinkValueStateTtlTest, NativeFactory) {  // NOLINT
+  auto current_timestamp = std::make_shared<std::atomic<int64_t>>(0);
+  auto config_holder = std::make_shared<FlinkCompactionFilter::ConfigHolder>();
+  EXPECT_TRUE(config_holder->Configure(new FlinkCompactionFilter::Config{
+      VALUE, TEST_TIMESTAMP_OFFSET, ttl, 1, nullptr}));
+  FlinkCompactionFilterFactory factory(config_holder, current_timestamp);
+  std::unique_ptr<CompactionFilter> filter =
+      factory.CreateCompactionFilter(CompactionFilter::Context());
+  ASSERT_NE(filter, nullptr);
+  SetTimestamp(10, TEST_TIMESTAMP_OFFSET);
+  Slice value(data, sizeof(data));
+  EXPECT_EQ(filter->FilterV2(0, key, KVALUE, value, &new_list, &stub), KKEEP);
+  current_timestamp->store(10 + ttl);
+  EXPECT_EQ(filter->FilterV2(0, key, KVALUE, value, &new_list, &stub),
+            KREMOVE);
+}
+
 TEST(FlinkValueStateTtlTest, WrongFilterValueType) {  // NOLINT
   InitValue(VALUE, KMERGE, true);
   EXPECT_EQ(decide(), KKEEP);
@@ -211,12 +251,205 @@ TEST(FlinkListStateTtlTest, HalfExpired) {  // NOLINT
   Deinit();
 }
 
+TEST(FlinkListStateTtlTest, FixedListElementFilterScan) {  // NOLINT
+  const std::size_t elem_len = 16;
+  const std::size_t ts_offset = 4;
+  const std::size_t num_elems = 37;
+  const int64_t now = 1000000;
+  FlinkCompactionFilter::FixedListElementFilter list_filter(elem_len, ts_offset,
+                                                            nullptr);
+  std::string list(num_elems * elem_len, 'x');
+  for (std::size_t unexpired = 0; unexpired <= num_elems; unexpired++) {
+    for (std::size_t i = 0; i < num_elems; i++) {
+      int64_t ts = i < unexpired   ? now - ttl - static_cast<int64_t>(i)
+                   : i == unexpired ? now - ttl + 1
+                                    : rnd(mt);
+      SetTimestamp(ts, i * elem_len + ts_offset, &list[0]);
+    }
+    EXPECT_EQ(list_filter.NextUnexpiredOffset(list, ttl, now),
+              unexpired * elem_len);
+  }
+
+  // No overflow of large timestamps
+  for (std::size_t i = 0; i < num_elems; i++) {
+    SetTimestamp(i == 0 ? now - ttl : JAVA_MAX_LONG - i,
+                 i * elem_len + ts_offset, &list[0]);
+  }
+  EXPECT_EQ(list_filter.NextUnexpiredOffset(list, ttl, now), elem_len);
+  // All expire at the max timestamp
+  EXPECT_EQ(list_filter.NextUnexpiredOffset(list, ttl, JAVA_MAX_LONG),
+            list.size());
+
+  // A truncated element is kept
+  for (std::size_t i = 0; i < num_elems; i++) {
+    SetTimestamp(now - ttl, i * elem_len + ts_offset, &list[0]);
+  }
+  list.append(ts_offset + TIMESTAMP_BYTE_SIZE - 1, 'x');
+  EXPECT_EQ(list_filter.NextUnexpiredOffset(list, ttl, now),
+            num_elems * elem_len);
+}
+
 TEST(FlinkListStateTtlTest, WrongFilterValueType) {  // NOLINT
   InitList(KBLOB, true);
   EXPECT_EQ(decide(), KKEEP);
   Deinit();
 }
 
+std::shared_ptr<FlinkCompactionFilter::ConfigHolder> ConfigureTtl(
+    FlinkCompactionFilter::StateType stype,
+    FlinkCompactionFilter::ListElementFilterFactory* list_filter_factory) {
+  auto config_holder = std::make_shared<FlinkCompactionFilter::ConfigHolder>();
+  EXPECT_TRUE(config_holder->Configure(new FlinkCompactionFilter::Config{
+      stype, TEST_TIMESTAMP_OFFSET, ttl, QUERY_TIME_AFTER_NUM_ENTRIES,
+      std::unique_ptr<FlinkCompactionFilter::ListElementFilterFactory>(
+          list_filter_factory)}));
+  return config_holder;
+}
+
+std::string StateEntry(int64_t timestamp) {
+  std::string entry(TEST_TIMESTAMP_OFFSET + TIMESTAMP_BYTE_SIZE, 'v');
+  SetTimestamp(timestamp, TEST_TIMESTAMP_OFFSET, &entry[0]);
+  return entry;
+}
+
+void ExpectTimestampRange(TablePropertiesCollector* collector,
+                          int64_t min_timestamp, int64_t max_timestamp) {
+  UserCollectedProperties properties;
+  ASSERT_OK(collector->Finish(&properties));
+  ASSERT_EQ(2U, properties.size());
+  EXPECT_EQ(min_timestamp, static_cast<int64_t>(DecodeFixed64(
+                               properties[TTL_MIN_TIMESTAMP_PROPERTY].data())));
+  EXPECT_EQ(max_timestamp, static_cast<int64_t>(DecodeFixed64(
+                               properties[TTL_MAX_TIMESTAMP_PROPERTY].data())));
+  EXPECT_EQ(std::to_string(max_timestamp),
+            collector->GetReadableProperties()[TTL_MAX_TIMESTAMP_PROPERTY]);
+}
+
+void ExpectNoTimestampRange(TablePropertiesCollector* collector) {
+  UserCollectedProperties properties;
+  ASSERT_OK(collector->Finish(&properties));
+  EXPECT_TRUE(properties.empty());
+  EXPECT_TRUE(collector->GetReadableProperties().empty());
+}
+
+TEST(FlinkTtlTablePropertiesTest, ValueState) {  // NOLINT
+  FlinkTtlTablePropertiesCollectorFactory factory(
+      ConfigureTtl(VALUE, nullptr));
+  TablePropertiesCollectorFactory::Context context;
+  std::unique_ptr<TablePropertiesCollector> collector(
+      factory.CreateTablePropertiesCollector(context));
+  ASSERT_OK(collector->AddUserKey(key, StateEntry(-5), kEntryPut, 0, 0));
+  ASSERT_OK(collector->AddUserKey(key, StateEntry(7), kEntryPut, 0, 0));
+  ASSERT_OK(collector->AddUserKey(key, StateEntry(3), kEntryPut, 0, 0));
+  ExpectTimestampRange(collector.get(), -5, 7);
+
+  // Entries which are never removed by the filter
+  collector.reset(factory.CreateTablePropertiesCollector(context));
+  ASSERT_OK(collector->AddUserKey(key, StateEntry(3), kEntryPut, 0, 0));
+  ASSERT_OK(collector->AddUserKey(key, "", kEntryDelete, 0, 0));
+  ExpectNoTimestampRange(collector.get());
+
+  collector.reset(factory.CreateTablePropertiesCollector(context));
+  ASSERT_OK(collector->AddUserKey(key, StateEntry(3), kEntryMerge, 0, 0));
+  ExpectNoTimestampRange(collector.get());
+
+  collector.reset(factory.CreateTablePropertiesCollector(context));
+  ASSERT_OK(collector->AddUserKey(key, "short", kEntryPut, 0, 0));
+  ExpectNoTimestampRange(collector.get());
+
+  // Not configured yet
+  FlinkTtlTablePropertiesCollectorFactory disabled(
+      std::make_shared<FlinkCompactionFilter::ConfigHolder>());
+  EXPECT_EQ(nullptr, disabled.CreateTablePropertiesCollector(context));
+}
+
+TEST(FlinkTtlTablePropertiesTest, ListState) {  // NOLINT
+  FlinkTtlTablePropertiesCollectorFactory factory(ConfigureTtl(
+      LIST, new FlinkCompactionFilter::FixedListElementFilterFactory(
+                LIST_ELEM_FIXED_LEN, TEST_TIMESTAMP_OFFSET)));
+  TablePropertiesCollectorFactory::Context context;
+  std::unique_ptr<TablePropertiesCollector> collector(
+      factory.CreateTablePropertiesCollector(context));
+  std::string list(3 * LIST_ELEM_FIXED_LEN, 'v');
+  SetTimestamp(10, TEST_TIMESTAMP_OFFSET, &list[0]);
+  SetTimestamp(30, LIST_ELEM_FIXED_LEN + TEST_TIMESTAMP_OFFSET, &list[0]);
+  SetTimestamp(20, 2 * LIST_ELEM_FIXED_LEN + TEST_TIMESTAMP_OFFSET, &list[0]);
+  ASSERT_OK(collector->AddUserKey(key, list, kEntryPut, 0, 0));
+  ASSERT_OK(collector->AddUserKey(key, list.substr(0, LIST_ELEM_FIXED_LEN),
+                                  kEntryMerge, 0, 0));
+  ExpectTimestampRange(collector.get(), 10, 30);
+
+  // A truncated element is never removed
+  collector.reset(factory.CreateTablePropertiesCollector(context));
+  ASSERT_OK(collector->AddUserKey(key, list.substr(0, list.size() - 1),
+                                  kEntryMerge, 0, 0));
+  ExpectNoTimestampRange(collector.get());
+}
+
+TEST(FlinkTtlTablePropertiesTest, DeleteExpiredFiles) {  // NOLINT
+  std::string dbname = test::PerThreadDBPath("flink_ttl_delete_expired_files");
+  Options options;
+  options.create_if_missing = true;
+  options.disable_auto_compactions = true;
+  options.table_properties_collector_factories.emplace_back(
+      new FlinkTtlTablePropertiesCollectorFactory(
+          ConfigureTtl(VALUE, nullptr)));
+  ASSERT_OK(DestroyDB(dbname, options));
+  DB* db = nullptr;
+  ASSERT_OK(DB::Open(options, dbname, &db));
+
+  auto state_key = [](int k) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "key%04d", k);
+    return std::string(buf);
+  };
+  // file i has keys [i * 100, i * 100 + 10) with timestamps i * 1000 + j
+  const int num_files = 4;
+  for (int i = 0; i < num_files; i++) {
+    for (int j = 0; j < 10; j++) {
+      ASSERT_OK(db->Put(WriteOptions(), state_key(i * 100 + j),
+                        StateEntry(i * 1000 + j)));
+    }
+    ASSERT_OK(db->Flush(FlushOptions()));
+  }
+  // An expired file with a tombstone is kept
+  ASSERT_OK(db->Put(WriteOptions(), state_key(500), StateEntry(0)));
+  ASSERT_OK(db->Delete(WriteOptions(), state_key(501)));
+  ASSERT_OK(db->Flush(FlushOptions()));
+  // Files in level 0 are kept, so move them down
+  CompactRangeOptions compact_options;
+  compact_options.change_level = true;
+  compact_options.target_level = 1;
+  ASSERT_OK(db->CompactRange(compact_options, nullptr, nullptr));
+
+  std::vector<LiveFileMetaData> files;
+  db->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(num_files + 1, static_cast<int>(files.size()));
+
+  // The first two files are expired
+  uint64_t num_deleted = 0;
+  ASSERT_OK(DeleteExpiredFiles(db, db->DefaultColumnFamily(), ttl,
+                               1009 + ttl, &num_deleted));
+  EXPECT_EQ(2U, num_deleted);
+  files.clear();
+  db->GetLiveFilesMetaData(&files);
+  EXPECT_EQ(num_files - 1, static_cast<int>(files.size()));
+  std::string value;
+  EXPECT_TRUE(db->Get(ReadOptions(), state_key(109), &value).IsNotFound());
+  EXPECT_OK(db->Get(ReadOptions(), state_key(200), &value));
+  EXPECT_EQ(StateEntry(2000), value);
+  EXPECT_OK(db->Get(ReadOptions(), state_key(500), &value));
+
+  // A file is kept until its latest entry expires
+  ASSERT_OK(DeleteExpiredFiles(db, db->DefaultColumnFamily(), ttl,
+                               3008 + ttl, &num_deleted));
+  EXPECT_EQ(1U, num_deleted);
+  EXPECT_OK(db->Get(ReadOptions(), state_key(309), &value));
+
+  delete db;
+  ASSERT_OK(DestroyDB(dbname, options));
+}
+
 }  // namespace flink
 }  // namespace ROCKSDB_NAMESPACE
 
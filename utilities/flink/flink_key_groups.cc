@@ -0,0 +1,249 @@
+// Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "utilities/flink/flink_key_groups.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "rocksdb/convenience.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace flink {
+
+std::size_t KeyGroupPrefixBytes(int max_parallelism) {
+  return max_parallelism > 128 ? 2 : 1;
+}
+
+bool GetKeyGroup(const Slice& key, std::size_t prefix_bytes, int* key_group) {
+  assert(prefix_bytes == 1 || prefix_bytes == 2);
+  if (key.size() < prefix_bytes) {
+    return false;
+  }
+  int result = 0;
+  for (std::size_t i = 0; i < prefix_bytes; i++) {
+    result = (result << 8) | static_cast<unsigned char>(key[i]);
+  }
+  *key_group = result;
+  return true;
+}
+
+void PutKeyGroupPrefix(std::string* dst, int key_group,
+                       std::size_t prefix_bytes) {
+  assert(prefix_bytes == 1 || prefix_bytes == 2);
+  assert(key_group >= 0 && key_group < (1 << (8 * prefix_bytes)));
+  for (std::size_t i = prefix_bytes; i > 0; i--) {
+    dst->push_back(static_cast<char>((key_group >> (8 * (i - 1))) & 0xff));
+  }
+}
+
+void KeyGroupRangeToKeys(int first_key_group, int last_key_group,
+                         std::size_t prefix_bytes, std::string* begin,
+                         std::string* end) {
+  assert(first_key_group <= last_key_group);
+  begin->clear();
+  end->clear();
+  PutKeyGroupPrefix(begin, first_key_group, prefix_bytes);
+  PutKeyGroupPrefix(end, last_key_group + 1, prefix_bytes);
+}
+
+PartitionerResult FlinkKeyGroupSstPartitioner::ShouldPartition(
+    const PartitionerRequest& request) {
+  if (request.current_output_file_size < min_file_size_) {
+    return kNotRequired;
+  }
+  int prev_key_group;
+  int current_key_group;
+  if (!GetKeyGroup(*request.prev_user_key, prefix_bytes_, &prev_key_group) ||
+      !GetKeyGroup(*request.current_user_key, prefix_bytes_,
+                   &current_key_group)) {
+    return kNotRequired;
+  }
+  return prev_key_group != current_key_group ? kRequired : kNotRequired;
+}
+
+bool FlinkKeyGroupSstPartitioner::CanDoTrivialMove(
+    const Slice& smallest_user_key, const Slice& largest_user_key) {
+  int smallest_key_group;
+  int largest_key_group;
+  return GetKeyGroup(smallest_user_key, prefix_bytes_, &smallest_key_group) &&
+         GetKeyGroup(largest_user_key, prefix_bytes_, &largest_key_group) &&
+         smallest_key_group == largest_key_group;
+}
+
+FlinkKeyGroupSstPartitionerFactory::FlinkKeyGroupSstPartitionerFactory(
+    std::size_t prefix_bytes, uint64_t min_file_size)
+    : prefix_bytes_(prefix_bytes), min_file_size_(min_file_size) {}
+
+std::unique_ptr<SstPartitioner>
+FlinkKeyGroupSstPartitionerFactory::CreatePartitioner(
+    const SstPartitioner::Context& /* context */) const {
+  return std::unique_ptr<SstPartitioner>(
+      new FlinkKeyGroupSstPartitioner(prefix_bytes_, min_file_size_));
+}
+
+Status FlinkKeyGroupTablePropertiesCollector::AddUserKey(
+    const Slice& key, const Slice& value, EntryType type,
+    SequenceNumber /*seq*/, uint64_t /*file_size*/) {
+  if (!valid_) {
+    return Status::OK();
+  }
+  int first_key_group;
+  int last_key_group;
+  if (!GetKeyGroup(key, prefix_bytes_, &first_key_group)) {
+    valid_ = false;
+    return Status::OK();
+  }
+  last_key_group = first_key_group;
+  if (type == kEntryRangeDeletion) {
+    // The value is the exclusive end key of the range tombstone, which ends
+    // before the key-group of a bare prefix.
+    if (!GetKeyGroup(value, prefix_bytes_, &last_key_group)) {
+      valid_ = false;
+      return Status::OK();
+    }
+    if (value.size() == prefix_bytes_) {
+      last_key_group--;
+    }
+    last_key_group = std::max(last_key_group, first_key_group);
+  }
+  if (first_key_group_ < 0 || first_key_group < first_key_group_) {
+    first_key_group_ = first_key_group;
+  }
+  last_key_group_ = std::max(last_key_group_, last_key_group);
+  return Status::OK();
+}
+
+bool FlinkKeyGroupTablePropertiesCollector::HasKeyGroupRange() const {
+  return valid_ && first_key_group_ >= 0;
+}
+
+Status FlinkKeyGroupTablePropertiesCollector::Finish(
+    UserCollectedProperties* properties) {
+  if (HasKeyGroupRange()) {
+    std::string first_key_group;
+    std::string last_key_group;
+    PutFixed32(&first_key_group, static_cast<uint32_t>(first_key_group_));
+    PutFixed32(&last_key_group, static_cast<uint32_t>(last_key_group_));
+    properties->emplace(FIRST_KEY_GROUP_PROPERTY, first_key_group);
+    properties->emplace(LAST_KEY_GROUP_PROPERTY, last_key_group);
+  }
+  return Status::OK();
+}
+
+UserCollectedProperties
+FlinkKeyGroupTablePropertiesCollector::GetReadableProperties() const {
+  UserCollectedProperties properties;
+  if (HasKeyGroupRange()) {
+    properties.emplace(FIRST_KEY_GROUP_PROPERTY,
+                       std::to_string(first_key_group_));
+    properties.emplace(LAST_KEY_GROUP_PROPERTY,
+                       std::to_string(last_key_group_));
+  }
+  return properties;
+}
+
+const char* FlinkKeyGroupTablePropertiesCollector::Name() const {
+  return "FlinkKeyGroupTablePropertiesCollector";
+}
+
+TablePropertiesCollector*
+FlinkKeyGroupTablePropertiesCollectorFactory::CreateTablePropertiesCollector(
+    TablePropertiesCollectorFactory::Context /*context*/) {
+  return new FlinkKeyGroupTablePropertiesCollector(prefix_bytes_);
+}
+
+const char* FlinkKeyGroupTablePropertiesCollectorFactory::Name() const {
+  return "FlinkKeyGroupTablePropertiesCollectorFactory";
+}
+
+bool GetKeyGroupRange(const TableProperties& props, int* first_key_group,
+                      int* last_key_group) {
+  const auto& user_props = props.user_collected_properties;
+  auto first = user_props.find(FIRST_KEY_GROUP_PROPERTY);
+  auto last = user_props.find(LAST_KEY_GROUP_PROPERTY);
+  if (first == user_props.end() || last == user_props.end() ||
+      first->second.size() != sizeof(uint32_t) ||
+      last->second.size() != sizeof(uint32_t)) {
+    return false;
+  }
+  *first_key_group = static_cast<int>(DecodeFixed32(first->second.data()));
+  *last_key_group = static_cast<int>(DecodeFixed32(last->second.data()));
+  return true;
+}
+
+namespace {
+
+// Drops the files of level 1 and below whose key-groups, according to the
+// properties of FlinkKeyGroupTablePropertiesCollector, are all in, or all out
+// of, [first_key_group, last_key_group]. Unlike the file boundaries, they do
+// not count the key-group ending a range tombstone, e.g. of a previous
+// DeleteKeyGroupRange(), so such files can be dropped as well.
+Status DeleteFilesByKeyGroups(DB* db, ColumnFamilyHandle* column_family,
+                              int first_key_group, int last_key_group,
+                              bool in_range) {
+  auto should_delete = [first_key_group, last_key_group,
+                        in_range](const TableProperties& props) {
+    int file_first_key_group;
+    int file_last_key_group;
+    if (!GetKeyGroupRange(props, &file_first_key_group,
+                          &file_last_key_group)) {
+      return false;
+    }
+    if (in_range) {
+      return file_first_key_group >= first_key_group &&
+             file_last_key_group <= last_key_group;
+    }
+    return file_last_key_group < first_key_group ||
+           file_first_key_group > last_key_group;
+  };
+  return DeleteFilesByTableProperties(db, column_family, should_delete);
+}
+
+}  // anonymous namespace
+
+Status DeleteKeyGroupRange(DB* db, ColumnFamilyHandle* column_family,
+                           int first_key_group, int last_key_group,
+                           std::size_t prefix_bytes) {
+  std::string begin;
+  std::string end;
+  KeyGroupRangeToKeys(first_key_group, last_key_group, prefix_bytes, &begin,
+                      &end);
+  Slice begin_slice(begin);
+  Slice end_slice(end);
+  // The DeleteRange goes first, so that the keys stay deleted if the files
+  // are only partially dropped, and the files no longer hide any older
+  // versions of the keys they'd expose when dropped.
+  Status s =
+      db->DeleteRange(WriteOptions(), column_family, begin_slice, end_slice);
+  if (s.ok()) {
+    s = DeleteFilesInRange(db, column_family, &begin_slice, &end_slice,
+                           /*include_end=*/false);
+  }
+  if (s.ok()) {
+    s = DeleteFilesByKeyGroups(db, column_family, first_key_group,
+                               last_key_group, /*in_range=*/true);
+  }
+  return s;
+}
+
+Status ClipKeyGroupRange(DB* db, ColumnFamilyHandle* column_family,
+                         int first_key_group, int last_key_group,
+                         std::size_t prefix_bytes) {
+  std::string begin;
+  std::string end;
+  KeyGroupRangeToKeys(first_key_group, last_key_group, prefix_bytes, &begin,
+                      &end);
+  Status s = DeleteFilesByKeyGroups(db, column_family, first_key_group,
+                                    last_key_group, /*in_range=*/false);
+  if (s.ok()) {
+    s = db->ClipColumnFamily(column_family, begin, end);
+  }
+  return s;
+}
+
+}  // namespace flink
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,161 @@
+// Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rocksdb/db.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/sst_partitioner.h"
+#include "rocksdb/table_properties.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace flink {
+
+// Flink prefixes the keys of the keyed state with their key-group, in big
+// endian, in 1 byte if the max parallelism is at most 128 and 2 bytes
+// otherwise. The key-groups are in [0, max parallelism), so the key-group
+// after the last one still fits the prefix.
+
+// Returns the number of bytes of the key-group prefix for the max parallelism,
+// like Flink's CompositeKeySerializationUtils.
+std::size_t KeyGroupPrefixBytes(int max_parallelism);
+
+// Reads the key-group of the key into key_group. Returns false if the key is
+// shorter than the key-group prefix.
+bool GetKeyGroup(const Slice& key, std::size_t prefix_bytes, int* key_group);
+
+// Appends the key-group prefix of the key-group to dst.
+void PutKeyGroupPrefix(std::string* dst, int key_group,
+                       std::size_t prefix_bytes);
+
+// Sets begin and end to the user key range [begin, end) of the key-groups in
+// [first_key_group, last_key_group], e.g. for ClipColumnFamily() or
+// CreateColumnFamilyWithImport(). end is the prefix of the key-group after
+// last_key_group.
+void KeyGroupRangeToKeys(int first_key_group, int last_key_group,
+                         std::size_t prefix_bytes, std::string* begin,
+                         std::string* end);
+
+/*
+ * Partitioner splitting the output SST files of compactions between Flink
+ * key-groups, so that a file holds the keys of a single key-group unless it is
+ * still smaller than min_file_size. Files of whole key-groups let the
+ * operations on key-group ranges, e.g. rescaling, drop, clip or import files
+ * instead of keys.
+ */
+class FlinkKeyGroupSstPartitioner : public SstPartitioner {
+ public:
+  FlinkKeyGroupSstPartitioner(std::size_t prefix_bytes, uint64_t min_file_size)
+      : prefix_bytes_(prefix_bytes), min_file_size_(min_file_size) {}
+
+  const char* Name() const override { return "FlinkKeyGroupSstPartitioner"; }
+
+  PartitionerResult ShouldPartition(const PartitionerRequest& request) override;
+
+  // Only files of a single key-group are moved as they are.
+  bool CanDoTrivialMove(const Slice& smallest_user_key,
+                        const Slice& largest_user_key) override;
+
+ private:
+  const std::size_t prefix_bytes_;
+  const uint64_t min_file_size_;
+};
+
+/*
+ * Factory for FlinkKeyGroupSstPartitioner.
+ */
+class FlinkKeyGroupSstPartitionerFactory : public SstPartitionerFactory {
+ public:
+  explicit FlinkKeyGroupSstPartitionerFactory(std::size_t prefix_bytes,
+                                              uint64_t min_file_size = 0);
+
+  static const char* kClassName() {
+    return "FlinkKeyGroupSstPartitionerFactory";
+  }
+  const char* Name() const override { return kClassName(); }
+
+  std::unique_ptr<SstPartitioner> CreatePartitioner(
+      const SstPartitioner::Context& /* context */) const override;
+
+ private:
+  std::size_t prefix_bytes_;
+  uint64_t min_file_size_;
+};
+
+// Names of the user collected table properties with the first and last
+// key-groups of the keys in the table, as fixed32.
+static const char* const FIRST_KEY_GROUP_PROPERTY = "flink.key-groups.first";
+static const char* const LAST_KEY_GROUP_PROPERTY = "flink.key-groups.last";
+
+// Collects the key-group range of each table file. The properties are only
+// written if all the keys of the table, including the boundaries of its range
+// tombstones, have a key-group prefix.
+class FlinkKeyGroupTablePropertiesCollector : public TablePropertiesCollector {
+ public:
+  explicit FlinkKeyGroupTablePropertiesCollector(std::size_t prefix_bytes)
+      : prefix_bytes_(prefix_bytes) {}
+
+  Status AddUserKey(const Slice& key, const Slice& value, EntryType type,
+                    SequenceNumber seq, uint64_t file_size) override;
+  Status Finish(UserCollectedProperties* properties) override;
+  UserCollectedProperties GetReadableProperties() const override;
+  const char* Name() const override;
+
+ private:
+  bool HasKeyGroupRange() const;
+
+  const std::size_t prefix_bytes_;
+  bool valid_ = true;
+  int first_key_group_ = -1;
+  int last_key_group_ = -1;
+};
+
+// Creates FlinkKeyGroupTablePropertiesCollectors.
+class FlinkKeyGroupTablePropertiesCollectorFactory
+    : public TablePropertiesCollectorFactory {
+ public:
+  explicit FlinkKeyGroupTablePropertiesCollectorFactory(
+      std::size_t prefix_bytes)
+      : prefix_bytes_(prefix_bytes) {}
+
+  TablePropertiesCollector* CreateTablePropertiesCollector(
+      TablePropertiesCollectorFactory::Context context) override;
+  const char* Name() const override;
+
+ private:
+  const std::size_t prefix_bytes_;
+};
+
+// Reads the key-group range of a table file from the properties of
+// FlinkKeyGroupTablePropertiesCollector. Returns false if the table has none.
+bool GetKeyGroupRange(const TableProperties& props, int* first_key_group,
+                      int* last_key_group);
+
+// Deletes the keys of the key-groups in [first_key_group, last_key_group],
+// e.g. the key-groups moved to another subtask after rescaling. The files of
+// level 1 and below entirely in the key-groups, i.e. those of whole key-groups
+// with FlinkKeyGroupSstPartitioner, are dropped as with DeleteFilesInRanges(),
+// see its caveats. The keys are deleted with a DeleteRange before, so the
+// remaining ones and those exposed by dropping the files stay deleted.
+// The files are picked by their boundaries and, with
+// FlinkKeyGroupTablePropertiesCollector, by their key-group range.
+Status DeleteKeyGroupRange(DB* db, ColumnFamilyHandle* column_family,
+                           int first_key_group, int last_key_group,
+                           std::size_t prefix_bytes);
+
+// Keeps only the keys of the key-groups in [first_key_group, last_key_group]
+// with ClipColumnFamily(), see its caveats. With
+// FlinkKeyGroupTablePropertiesCollector, the files of level 1 and below
+// entirely out of the key-groups are dropped first by their key-group range.
+Status ClipKeyGroupRange(DB* db, ColumnFamilyHandle* column_family,
+                         int first_key_group, int last_key_group,
+                         std::size_t prefix_bytes);
+
+}  // namespace flink
+}  // namespace ROCKSDB_NAMESPACE
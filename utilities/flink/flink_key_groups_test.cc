@@ -0,0 +1,246 @@
+// Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "utilities/flink/flink_key_groups.h"
+
+#include "rocksdb/db.h"
+#include "test_util/testharness.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace flink {
+
+static std::string StateKey(int key_group, int k, std::size_t prefix_bytes) {
+  std::string key;
+  PutKeyGroupPrefix(&key, key_group, prefix_bytes);
+  char buf[16];
+  snprintf(buf, sizeof(buf), "key%04d", k);
+  key.append(buf);
+  return key;
+}
+
+TEST(FlinkKeyGroupsTest, KeyGroupPrefix) {  // NOLINT
+  EXPECT_EQ(1U, KeyGroupPrefixBytes(128));
+  EXPECT_EQ(2U, KeyGroupPrefixBytes(129));
+
+  int key_group = -1;
+  EXPECT_TRUE(GetKeyGroup(StateKey(127, 0, 1), 1, &key_group));
+  EXPECT_EQ(127, key_group);
+  EXPECT_TRUE(GetKeyGroup(StateKey(300, 0, 2), 2, &key_group));
+  EXPECT_EQ(300, key_group);
+  EXPECT_FALSE(GetKeyGroup(Slice("a"), 2, &key_group));
+
+  std::string begin;
+  std::string end;
+  KeyGroupRangeToKeys(1, 2, 2, &begin, &end);
+  EXPECT_EQ(std::string("\x00\x01", 2), begin);
+  EXPECT_EQ(std::string("\x00\x03", 2), end);
+  EXPECT_LT(begin, StateKey(1, 0, 2));
+  EXPECT_LT(StateKey(2, 9999, 2), end);
+  KeyGroupRangeToKeys(127, 127, 1, &begin, &end);
+  EXPECT_EQ("\x7f", begin);
+  EXPECT_EQ("\x80", end);
+}
+
+TEST(FlinkKeyGroupsTest, Partitioner) {  // NOLINT
+  FlinkKeyGroupSstPartitionerFactory factory(2);
+  auto partitioner = factory.CreatePartitioner(SstPartitioner::Context());
+  std::string key1 = StateKey(1, 5, 2);
+  std::string key2 = StateKey(1, 7, 2);
+  std::string key3 = StateKey(2, 0, 2);
+  Slice s1(key1), s2(key2), s3(key3);
+  EXPECT_EQ(kNotRequired,
+            partitioner->ShouldPartition(PartitionerRequest(s1, s2, 0)));
+  EXPECT_EQ(kRequired,
+            partitioner->ShouldPartition(PartitionerRequest(s2, s3, 0)));
+  EXPECT_TRUE(partitioner->CanDoTrivialMove(s1, s2));
+  EXPECT_FALSE(partitioner->CanDoTrivialMove(s1, s3));
+
+  // Small files span key-groups
+  FlinkKeyGroupSstPartitionerFactory min_size_factory(2, 1000);
+  partitioner = min_size_factory.CreatePartitioner(SstPartitioner::Context());
+  EXPECT_EQ(kNotRequired,
+            partitioner->ShouldPartition(PartitionerRequest(s2, s3, 999)));
+  EXPECT_EQ(kRequired,
+            partitioner->ShouldPartition(PartitionerRequest(s2, s3, 1000)));
+}
+
+TEST(FlinkKeyGroupsTest, TablePropertiesCollector) {  // NOLINT
+  FlinkKeyGroupTablePropertiesCollectorFactory factory(2);
+  TablePropertiesCollectorFactory::Context context;
+  std::unique_ptr<TablePropertiesCollector> collector(
+      factory.CreateTablePropertiesCollector(context));
+  ASSERT_OK(collector->AddUserKey(StateKey(3, 0, 2), "v", kEntryPut, 0, 0));
+  ASSERT_OK(collector->AddUserKey(StateKey(5, 0, 2), "v", kEntryPut, 0, 0));
+  // Range tombstone ending at the prefix of key-group 9
+  std::string end;
+  PutKeyGroupPrefix(&end, 9, 2);
+  ASSERT_OK(
+      collector->AddUserKey(StateKey(6, 0, 2), end, kEntryRangeDeletion, 0, 0));
+  TableProperties props;
+  ASSERT_OK(collector->Finish(&props.user_collected_properties));
+  int first = -1;
+  int last = -1;
+  ASSERT_TRUE(GetKeyGroupRange(props, &first, &last));
+  EXPECT_EQ(3, first);
+  EXPECT_EQ(8, last);
+  UserCollectedProperties readable = collector->GetReadableProperties();
+  EXPECT_EQ("3", readable[FIRST_KEY_GROUP_PROPERTY]);
+  EXPECT_EQ("8", readable[LAST_KEY_GROUP_PROPERTY]);
+
+  // A key without prefix
+  collector.reset(factory.CreateTablePropertiesCollector(context));
+  ASSERT_OK(collector->AddUserKey(StateKey(3, 0, 2), "v", kEntryPut, 0, 0));
+  ASSERT_OK(collector->AddUserKey("a", "v", kEntryPut, 0, 0));
+  props.user_collected_properties.clear();
+  ASSERT_OK(collector->Finish(&props.user_collected_properties));
+  EXPECT_FALSE(GetKeyGroupRange(props, &first, &last));
+}
+
+TEST(FlinkKeyGroupsTest, DeleteAndClipKeyGroupRange) {  // NOLINT
+  std::string dbname = test::PerThreadDBPath("flink_key_groups_delete");
+  const std::size_t prefix_bytes = 2;
+  Options options;
+  options.create_if_missing = true;
+  options.disable_auto_compactions = true;
+  options.sst_partitioner_factory =
+      std::make_shared<FlinkKeyGroupSstPartitionerFactory>(prefix_bytes);
+  options.table_properties_collector_factories.emplace_back(
+      new FlinkKeyGroupTablePropertiesCollectorFactory(prefix_bytes));
+  ASSERT_OK(DestroyDB(dbname, options));
+  DB* db = nullptr;
+  ASSERT_OK(DB::Open(options, dbname, &db));
+
+  // A single flushed file spanning key-groups [0, 8)
+  const int num_key_groups = 8;
+  for (int kg = 0; kg < num_key_groups; kg++) {
+    for (int k = 0; k < 10; k++) {
+      ASSERT_OK(db->Put(WriteOptions(), StateKey(kg, k, prefix_bytes), "v"));
+    }
+  }
+  ASSERT_OK(db->Flush(FlushOptions()));
+  std::vector<LiveFileMetaData> files;
+  db->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(1U, files.size());
+
+  // Compactions split the file by key-group
+  CompactRangeOptions compact_options;
+  compact_options.bottommost_level_compaction =
+      BottommostLevelCompaction::kForce;
+  ASSERT_OK(db->CompactRange(compact_options, nullptr, nullptr));
+  files.clear();
+  db->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(static_cast<std::size_t>(num_key_groups), files.size());
+  TablePropertiesCollection props;
+  ASSERT_OK(db->GetPropertiesOfAllTables(&props));
+  ASSERT_EQ(static_cast<std::size_t>(num_key_groups), props.size());
+  for (const auto& file_props : props) {
+    int first = -1;
+    int last = -1;
+    ASSERT_TRUE(GetKeyGroupRange(*file_props.second, &first, &last));
+    EXPECT_EQ(first, last);
+  }
+
+  // Whole files are dropped
+  ASSERT_OK(DeleteKeyGroupRange(db, db->DefaultColumnFamily(), 2, 3,
+                                prefix_bytes));
+  files.clear();
+  db->GetLiveFilesMetaData(&files);
+  EXPECT_EQ(static_cast<std::size_t>(num_key_groups - 2), files.size());
+  std::string value;
+  EXPECT_TRUE(db->Get(ReadOptions(), StateKey(2, 0, prefix_bytes), &value)
+                  .IsNotFound());
+  EXPECT_TRUE(db->Get(ReadOptions(), StateKey(3, 9, prefix_bytes), &value)
+                  .IsNotFound());
+  EXPECT_OK(db->Get(ReadOptions(), StateKey(4, 0, prefix_bytes), &value));
+
+  ASSERT_OK(
+      ClipKeyGroupRange(db, db->DefaultColumnFamily(), 4, 5, prefix_bytes));
+  files.clear();
+  db->GetLiveFilesMetaData(&files);
+  EXPECT_EQ(2U, files.size());
+  EXPECT_TRUE(db->Get(ReadOptions(), StateKey(1, 0, prefix_bytes), &value)
+                  .IsNotFound());
+  EXPECT_OK(db->Get(ReadOptions(), StateKey(5, 9, prefix_bytes), &value));
+  EXPECT_TRUE(db->Get(ReadOptions(), StateKey(6, 0, prefix_bytes), &value)
+                  .IsNotFound());
+
+  delete db;
+  ASSERT_OK(DestroyDB(dbname, options));
+}
+
+TEST(FlinkKeyGroupsTest, DropFilesByKeyGroupRange) {  // NOLINT
+  std::string dbname = test::PerThreadDBPath("flink_key_groups_drop");
+  const std::size_t prefix_bytes = 1;
+  Options options;
+  options.create_if_missing = true;
+  options.disable_auto_compactions = true;
+  options.sst_partitioner_factory =
+      std::make_shared<FlinkKeyGroupSstPartitionerFactory>(prefix_bytes);
+  options.table_properties_collector_factories.emplace_back(
+      new FlinkKeyGroupTablePropertiesCollectorFactory(prefix_bytes));
+  ASSERT_OK(DestroyDB(dbname, options));
+  DB* db = nullptr;
+  ASSERT_OK(DB::Open(options, dbname, &db));
+
+  // Files of level 1 and below whose largest key is the end of a range
+  // tombstone, i.e. the prefix of the next key-group
+  std::vector<const Snapshot*> snapshots;
+  for (int kg : {1, 3}) {
+    for (int k = 0; k < 10; k++) {
+      ASSERT_OK(db->Put(WriteOptions(), StateKey(kg, k, prefix_bytes), "v"));
+    }
+    // Keeps the range tombstone in the compaction
+    snapshots.push_back(db->GetSnapshot());
+    std::string end;
+    PutKeyGroupPrefix(&end, kg + 1, prefix_bytes);
+    ASSERT_OK(db->DeleteRange(WriteOptions(), db->DefaultColumnFamily(),
+                              StateKey(kg, 5, prefix_bytes), end));
+  }
+  ASSERT_OK(db->Flush(FlushOptions()));
+  CompactRangeOptions compact_options;
+  compact_options.bottommost_level_compaction =
+      BottommostLevelCompaction::kForce;
+  ASSERT_OK(db->CompactRange(compact_options, nullptr, nullptr));
+  for (const Snapshot* snapshot : snapshots) {
+    db->ReleaseSnapshot(snapshot);
+  }
+  std::vector<LiveFileMetaData> files;
+  db->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(2U, files.size());
+  for (const auto& file : files) {
+    ASSERT_GE(file.level, 1);
+  }
+
+  // Unlike the file boundaries, the key-group range of the files does not
+  // count the key-group ending the range tombstones
+  ASSERT_OK(DeleteKeyGroupRange(db, db->DefaultColumnFamily(), 1, 1,
+                                prefix_bytes));
+  files.clear();
+  db->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(1U, files.size());
+  std::string value;
+  EXPECT_TRUE(db->Get(ReadOptions(), StateKey(1, 0, prefix_bytes), &value)
+                  .IsNotFound());
+  EXPECT_OK(db->Get(ReadOptions(), StateKey(3, 0, prefix_bytes), &value));
+
+  ASSERT_OK(
+      ClipKeyGroupRange(db, db->DefaultColumnFamily(), 4, 5, prefix_bytes));
+  files.clear();
+  db->GetLiveFilesMetaData(&files);
+  EXPECT_EQ(0U, files.size());
+  EXPECT_TRUE(db->Get(ReadOptions(), StateKey(3, 0, prefix_bytes), &value)
+                  .IsNotFound());
+
+  delete db;
+  ASSERT_OK(DestroyDB(dbname, options));
+}
+
+}  // namespace flink
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,6 +15,7 @@
 #include "utilities/merge_operators/max_operator.h"
 #include "utilities/merge_operators/put_operator.h"
 #include "utilities/merge_operators/sortlist.h"
+#include "utilities/merge_operators/string_append/listappend.h"
 #include "utilities/merge_operators/string_append/stringappend.h"
 #include "utilities/merge_operators/string_append/stringappend2.h"
 #include "utilities/merge_operators/uint64add.h"
@@ -39,6 +40,14 @@ static int RegisterBuiltinMergeOperators(ObjectLibrary& library,
         guard->reset(new StringAppendTESTOperator(","));
         return guard->get();
       });
+  library.AddFactory<MergeOperator>(
+      ObjectLibrary::PatternEntry(ListAppendOperator::kClassName())
+          .AnotherName(ListAppendOperator::kNickName()),
+      [](const std::string& /*uri*/, std::unique_ptr<MergeOperator>* guard,
+         std::string* /*errmsg*/) {
+        guard->reset(new ListAppendOperator(","));
+        return guard->get();
+      });
   library.AddFactory<MergeOperator>(
       ObjectLibrary::PatternEntry(SortList::kClassName())
           .AnotherName(SortList::kNickName()),
@@ -24,6 +24,11 @@ class MergeOperators {
   static std::shared_ptr<MergeOperator> CreateStringAppendOperator(
       const std::string& delim);
   static std::shared_ptr<MergeOperator> CreateStringAppendTESTOperator();
+  static std::shared_ptr<MergeOperator> CreateListAppendOperator();
+  static std::shared_ptr<MergeOperator> CreateListAppendOperator(
+      char delim_char);
+  static std::shared_ptr<MergeOperator> CreateListAppendOperator(
+      const std::string& delim);
   static std::shared_ptr<MergeOperator> CreateMaxOperator();
   static std::shared_ptr<MergeOperator> CreateBytesXOROperator();
   static std::shared_ptr<MergeOperator> CreateSortOperator();
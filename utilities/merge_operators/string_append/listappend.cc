@@ -0,0 +1,100 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "utilities/merge_operators/string_append/listappend.h"
+
+#include <assert.h>
+
+#include <memory>
+#include <string>
+
+#include "rocksdb/merge_operator.h"
+#include "rocksdb/slice.h"
+#include "rocksdb/utilities/options_type.h"
+#include "utilities/merge_operators.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace {
+static std::unordered_map<std::string, OptionTypeInfo>
+    listappend_merge_type_info = {
+        {"delimiter",
+         {0, OptionType::kString, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+};
+
+// Appends the segments to dst, joined by delim, with a single allocation.
+template <typename It>
+void AppendSegments(const Slice* first, It begin, It end,
+                    const std::string& delim, std::string* dst) {
+  size_t num_segments = first == nullptr ? 0 : 1;
+  size_t size = first == nullptr ? 0 : first->size();
+  for (It it = begin; it != end; ++it) {
+    num_segments++;
+    size += it->size();
+  }
+  dst->clear();
+  if (num_segments > 0) {
+    dst->reserve(size + (num_segments - 1) * delim.size());
+  }
+  if (first != nullptr) {
+    dst->assign(first->data(), first->size());
+  }
+  for (It it = begin; it != end; ++it) {
+    if (it != begin || first != nullptr) {
+      dst->append(delim);
+    }
+    dst->append(it->data(), it->size());
+  }
+}
+}  // namespace
+
+ListAppendOperator::ListAppendOperator(char delim_char)
+    : delim_(1, delim_char) {
+  RegisterOptions("Delimiter", &delim_, &listappend_merge_type_info);
+}
+
+ListAppendOperator::ListAppendOperator(const std::string& delim)
+    : delim_(delim) {
+  RegisterOptions("Delimiter", &delim_, &listappend_merge_type_info);
+}
+
+bool ListAppendOperator::FullMergeV2(const MergeOperationInput& merge_in,
+                                     MergeOperationOutput* merge_out) const {
+  if (merge_in.existing_value == nullptr && merge_in.operand_list.size() == 1) {
+    // A single segment, e.g. a list collapsed by a compaction
+    merge_out->new_value.clear();
+    merge_out->existing_operand = merge_in.operand_list.back();
+    return true;
+  }
+  AppendSegments(merge_in.existing_value, merge_in.operand_list.begin(),
+                 merge_in.operand_list.end(), delim_, &merge_out->new_value);
+  return true;
+}
+
+bool ListAppendOperator::PartialMergeMulti(
+    const Slice& /*key*/, const std::deque<Slice>& operand_list,
+    std::string* new_value, Logger* /*logger*/) const {
+  assert(new_value);
+  assert(operand_list.size() >= 2);
+  AppendSegments(nullptr, operand_list.begin(), operand_list.end(), delim_,
+                 new_value);
+  return true;
+}
+
+std::shared_ptr<MergeOperator> MergeOperators::CreateListAppendOperator() {
+  return std::make_shared<ListAppendOperator>(',');
+}
+
+std::shared_ptr<MergeOperator> MergeOperators::CreateListAppendOperator(
+    char delim_char) {
+  return std::make_shared<ListAppendOperator>(delim_char);
+}
+
+std::shared_ptr<MergeOperator> MergeOperators::CreateListAppendOperator(
+    const std::string& delim) {
+  return std::make_shared<ListAppendOperator>(delim);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,49 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// A MergeOperator for lists of elements joined by a delimiter, e.g. the list
+// state of Flink, where each operand appends one or more elements.
+//
+// Unlike StringAppendTESTOperator, the operands are also partially merged, so
+// flushes and compactions collapse runs of operands into a single segment of
+// the list and bound the number of operands left for reads. A Get of a single
+// operand returns it without copy. Readers which split the list anyway can
+// skip the concatenation with DB::GetMergeOperands(), which returns the
+// segments of the list as pinned slices; max_successive_merges bounds the
+// operands accumulated in the memtable.
+
+#pragma once
+#include <deque>
+#include <string>
+
+#include "rocksdb/merge_operator.h"
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class ListAppendOperator : public MergeOperator {
+ public:
+  // Constructor with delimiter
+  explicit ListAppendOperator(char delim_char);
+  explicit ListAppendOperator(const std::string& delim);
+
+  bool FullMergeV2(const MergeOperationInput& merge_in,
+                   MergeOperationOutput* merge_out) const override;
+
+  bool PartialMergeMulti(const Slice& key,
+                         const std::deque<Slice>& operand_list,
+                         std::string* new_value,
+                         Logger* logger) const override;
+
+  static const char* kClassName() { return "ListAppendOperator"; }
+  static const char* kNickName() { return "listappend"; }
+  const char* Name() const override { return kClassName(); }
+  const char* NickName() const override { return kNickName(); }
+
+ private:
+  std::string delim_;  // The delimiter is inserted between elements
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -19,12 +19,14 @@
 #include <tuple>
 
 #include "port/stack_trace.h"
+#include "rocksdb/convenience.h"
 #include "rocksdb/db.h"
 #include "rocksdb/merge_operator.h"
 #include "rocksdb/utilities/db_ttl.h"
 #include "test_util/testharness.h"
 #include "util/random.h"
 #include "utilities/merge_operators.h"
+#include "utilities/merge_operators/string_append/listappend.h"
 #include "utilities/merge_operators/string_append/stringappend2.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -64,8 +66,24 @@ std::shared_ptr<DB> OpenTtlDb(const std::string& delim) {
   EXPECT_OK(DBWithTTL::Open(options, kDbName, &db, 123456));
   return std::shared_ptr<DB>(db);
 }
+
+// Open a DB with a ListAppendOperator
+std::shared_ptr<DB> OpenListAppendDb(const std::string& delim) {
+  DB* db;
+  Options options;
+  options.create_if_missing = true;
+  options.merge_operator.reset(new ListAppendOperator(delim));
+  EXPECT_OK(DB::Open(options, kDbName, &db));
+  return std::shared_ptr<DB>(db);
+}
 }  // namespace
 
+enum class OperatorKind {
+  kStringAppend,
+  kStringAppendTESTWithTtl,
+  kListAppend,
+};
+
 /// StringLists represents a set of string-lists, each with a key-index.
 /// Supports Append(list, string) and Get(list)
 class StringLists {
@@ -119,8 +137,9 @@ class StringLists {
 };
 
 // The class for unit-testing
-class StringAppendOperatorTest : public testing::Test,
-                                 public ::testing::WithParamInterface<bool> {
+class StringAppendOperatorTest
+    : public testing::Test,
+      public ::testing::WithParamInterface<OperatorKind> {
  public:
   StringAppendOperatorTest() {
     EXPECT_OK(
@@ -128,11 +147,17 @@ class StringAppendOperatorTest : public testing::Test,
   }
 
   void SetUp() override {
-    bool if_use_ttl = GetParam();
-    if (if_use_ttl) {
-      fprintf(stderr, "Running tests with ttl db and generic operator.\n");
-      StringAppendOperatorTest::SetOpenDbFunction(&OpenTtlDb);
-      return;
+    switch (GetParam()) {
+      case OperatorKind::kStringAppendTESTWithTtl:
+        fprintf(stderr, "Running tests with ttl db and generic operator.\n");
+        StringAppendOperatorTest::SetOpenDbFunction(&OpenTtlDb);
+        return;
+      case OperatorKind::kListAppend:
+        fprintf(stderr, "Running tests with regular db and list operator.\n");
+        StringAppendOperatorTest::SetOpenDbFunction(&OpenListAppendDb);
+        return;
+      case OperatorKind::kStringAppend:
+        break;
     }
     fprintf(stderr, "Running tests with regular db and operator.\n");
     StringAppendOperatorTest::SetOpenDbFunction(&OpenNormalDb);
@@ -627,8 +652,53 @@ TEST_P(StringAppendOperatorTest, SimpleTestNullDelimiter) {
   ASSERT_EQ(res, checker);
 }
 
-INSTANTIATE_TEST_CASE_P(StringAppendOperatorTest, StringAppendOperatorTest,
-                        testing::Bool());
+INSTANTIATE_TEST_CASE_P(
+    StringAppendOperatorTest, StringAppendOperatorTest,
+    testing::Values(OperatorKind::kStringAppend,
+                    OperatorKind::kStringAppendTESTWithTtl,
+                    OperatorKind::kListAppend));
+
+TEST(ListAppendOperatorTest, CollapsesOperands) {
+  ASSERT_OK(DestroyDB(kDbName, Options()));
+  auto db = OpenListAppendDb(",");
+  for (int i = 0; i < 4; i++) {
+    ASSERT_OK(db->Merge(WriteOptions(), "k", "v" + std::to_string(i)));
+  }
+  ASSERT_OK(db->Merge(WriteOptions(), "single", "v"));
+  ASSERT_OK(db->Flush(FlushOptions()));
+
+  // The flush merges the operands into one segment
+  GetMergeOperandsOptions merge_operands_options;
+  merge_operands_options.expected_max_number_of_operands = 4;
+  std::vector<PinnableSlice> operands(4);
+  int num_operands = 0;
+  ASSERT_OK(db->GetMergeOperands(ReadOptions(), db->DefaultColumnFamily(), "k",
+                                 operands.data(), &merge_operands_options,
+                                 &num_operands));
+  ASSERT_EQ(1, num_operands);
+  ASSERT_EQ("v0,v1,v2,v3", operands[0]);
+
+  ASSERT_OK(db->Merge(WriteOptions(), "k", "v4"));
+  ASSERT_OK(db->GetMergeOperands(ReadOptions(), db->DefaultColumnFamily(), "k",
+                                 operands.data(), &merge_operands_options,
+                                 &num_operands));
+  ASSERT_EQ(2, num_operands);
+  ASSERT_EQ("v0,v1,v2,v3", operands[0]);
+  ASSERT_EQ("v4", operands[1]);
+
+  std::string value;
+  ASSERT_OK(db->Get(ReadOptions(), "k", &value));
+  ASSERT_EQ("v0,v1,v2,v3,v4", value);
+  PinnableSlice pinned;
+  ASSERT_OK(db->Get(ReadOptions(), db->DefaultColumnFamily(), "single",
+                    &pinned));
+  ASSERT_EQ("v", pinned);
+
+  std::shared_ptr<MergeOperator> merge_operator;
+  ASSERT_OK(MergeOperator::CreateFromString(
+      ConfigOptions(), ListAppendOperator::kNickName(), &merge_operator));
+  ASSERT_STREQ(ListAppendOperator::kClassName(), merge_operator->Name());
+}
 
 }  // namespace ROCKSDB_NAMESPACE
 